@@ -0,0 +1,222 @@
+// auth_checkpoint.c
+// Challenge-prefix checkpoint cache (bounded LRU)
+
+#include "auth_checkpoint.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// KEYS
+// ============================================================================
+// Secrets are compared exactly. The prefix is bucketed by a 64-bit FNV-1a
+// hash of its float bit patterns, and an entry keeps a copy of it, so a
+// hash match is confirmed byte for byte before a checkpoint is reused.
+
+typedef struct {
+    uint32_t k_bits;
+    uint32_t gamma_bits;
+    uint32_t seed;
+    int revision;
+    int steps_per_challenge;
+    int schedule_length;        // non-uniform schedules depend on the full length
+    int prefix_length;
+    uint64_t prefix_hash;
+} CheckpointKey;
+
+#define FNV_OFFSET 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+
+static uint64_t fnv1a(uint64_t h, const void* data, size_t n) {
+    const unsigned char* p = data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static CheckpointKey make_key(const float* challenge, int prefix_length, int length,
+                              const AuthSecret* secret, int revision) {
+    CheckpointKey key;
+    memcpy(&key.k_bits, &secret->k, sizeof(uint32_t));
+    memcpy(&key.gamma_bits, &secret->gamma, sizeof(uint32_t));
+    key.seed = secret->seed;
+    key.revision = revision;
+    key.steps_per_challenge = auth_schedule_uniform_steps(revision, length);
+    key.schedule_length = key.steps_per_challenge > 0 ? 0 : length;
+    key.prefix_length = prefix_length;
+    key.prefix_hash = fnv1a(FNV_OFFSET, challenge, sizeof(float) * (size_t)prefix_length);
+    return key;
+}
+
+static uint64_t key_hash(const CheckpointKey* key) {
+    uint64_t h = fnv1a(FNV_OFFSET, &key->k_bits, sizeof(uint32_t) * 3);
+    h ^= key->prefix_hash + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h ^ (uint64_t)(key->prefix_length * 31 + key->steps_per_challenge * 7 + key->revision +
+                         (uint64_t)key->schedule_length * 131);
+}
+
+static int key_equal(const CheckpointKey* a, const CheckpointKey* b) {
+    return a->k_bits == b->k_bits && a->gamma_bits == b->gamma_bits && a->seed == b->seed &&
+           a->revision == b->revision && a->steps_per_challenge == b->steps_per_challenge &&
+           a->schedule_length == b->schedule_length &&
+           a->prefix_length == b->prefix_length && a->prefix_hash == b->prefix_hash;
+}
+
+// ============================================================================
+// CACHE
+// ============================================================================
+// Fixed entry array; hash buckets chain by index, and an intrusive doubly
+// linked list orders entries from most (head) to least (tail) recently used.
+
+#define NIL -1
+
+typedef struct {
+    CheckpointKey key;
+    AuthCheckpoint checkpoint;
+    float* prefix;              // key.prefix_length entries
+    int prefix_capacity;
+    int bucket_next;
+    int lru_prev;
+    int lru_next;
+} CacheEntry;
+
+struct AuthCheckpointCache {
+    CacheEntry* entries;
+    int* buckets;
+    int capacity;
+    int bucket_mask;
+    int used;
+    int lru_head;
+    int lru_tail;
+    AuthCheckpointStats stats;
+};
+
+AuthCheckpointCache* auth_checkpoint_cache_create(int capacity) {
+    if (capacity < 1) return NULL;
+    int n_buckets = 1;
+    while (n_buckets < capacity * 2) n_buckets <<= 1;
+
+    AuthCheckpointCache* cache = calloc(1, sizeof(AuthCheckpointCache));
+    if (!cache) return NULL;
+    cache->entries = calloc((size_t)capacity, sizeof(CacheEntry));
+    cache->buckets = malloc(sizeof(int) * (size_t)n_buckets);
+    if (!cache->entries || !cache->buckets) {
+        auth_checkpoint_cache_destroy(cache);
+        return NULL;
+    }
+    for (int b = 0; b < n_buckets; b++) cache->buckets[b] = NIL;
+    cache->capacity = capacity;
+    cache->bucket_mask = n_buckets - 1;
+    cache->lru_head = NIL;
+    cache->lru_tail = NIL;
+    return cache;
+}
+
+void auth_checkpoint_cache_destroy(AuthCheckpointCache* cache) {
+    if (!cache) return;
+    for (int i = 0; cache->entries && i < cache->used; i++) free(cache->entries[i].prefix);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
+AuthCheckpointStats auth_checkpoint_cache_stats(const AuthCheckpointCache* cache) {
+    return cache->stats;
+}
+
+static void lru_unlink(AuthCheckpointCache* cache, int i) {
+    CacheEntry* e = &cache->entries[i];
+    if (e->lru_prev != NIL) cache->entries[e->lru_prev].lru_next = e->lru_next;
+    else cache->lru_head = e->lru_next;
+    if (e->lru_next != NIL) cache->entries[e->lru_next].lru_prev = e->lru_prev;
+    else cache->lru_tail = e->lru_prev;
+}
+
+static void lru_push_front(AuthCheckpointCache* cache, int i) {
+    CacheEntry* e = &cache->entries[i];
+    e->lru_prev = NIL;
+    e->lru_next = cache->lru_head;
+    if (cache->lru_head != NIL) cache->entries[cache->lru_head].lru_prev = i;
+    cache->lru_head = i;
+    if (cache->lru_tail == NIL) cache->lru_tail = i;
+}
+
+static int find(const AuthCheckpointCache* cache, const CheckpointKey* key,
+                const float* prefix) {
+    int i = cache->buckets[key_hash(key) & (uint64_t)cache->bucket_mask];
+    while (i != NIL) {
+        const CacheEntry* e = &cache->entries[i];
+        if (key_equal(&e->key, key) &&
+            memcmp(e->prefix, prefix, sizeof(float) * (size_t)key->prefix_length) == 0) {
+            break;
+        }
+        i = e->bucket_next;
+    }
+    return i;
+}
+
+static void bucket_remove(AuthCheckpointCache* cache, int i) {
+    int* link = &cache->buckets[key_hash(&cache->entries[i].key) & (uint64_t)cache->bucket_mask];
+    while (*link != i) link = &cache->entries[*link].bucket_next;
+    *link = cache->entries[i].bucket_next;
+}
+
+// Out of memory for the prefix copy leaves the cache as it was
+static void insert(AuthCheckpointCache* cache, const CheckpointKey* key, const float* prefix,
+                   const AuthCheckpoint* checkpoint) {
+    int i = cache->used < cache->capacity ? cache->used : cache->lru_tail;
+    CacheEntry* e = &cache->entries[i];
+    if (e->prefix_capacity < key->prefix_length) {
+        float* grown = realloc(e->prefix, sizeof(float) * (size_t)key->prefix_length);
+        if (!grown) return;
+        e->prefix = grown;
+        e->prefix_capacity = key->prefix_length;
+    }
+    if (cache->used < cache->capacity) {
+        cache->used++;
+    } else {
+        // Reuse the least recently used entry
+        lru_unlink(cache, i);
+        bucket_remove(cache, i);
+        cache->stats.evictions++;
+    }
+    memcpy(e->prefix, prefix, sizeof(float) * (size_t)key->prefix_length);
+    e->key = *key;
+    e->checkpoint = *checkpoint;
+    int* bucket = &cache->buckets[key_hash(key) & (uint64_t)cache->bucket_mask];
+    e->bucket_next = *bucket;
+    *bucket = i;
+    lru_push_front(cache, i);
+}
+
+int auth_checkpoint_cache_compute(AuthCheckpointCache* cache, const float* challenge,
+                                  int length, int prefix_length, const AuthSecret* secret,
+                                  int revision, AuthResponse* out) {
+    AuthCheckpoint cp;
+    if (!auth_checkpoint_begin(&cp, secret, length, revision)) return 0;
+
+    if (prefix_length < 1 || prefix_length > length) {
+        // Nothing worth caching
+        auth_checkpoint_advance(&cp, secret, challenge, length);
+        *out = auth_checkpoint_response(&cp, secret);
+        return 1;
+    }
+
+    CheckpointKey key = make_key(challenge, prefix_length, length, secret, revision);
+    int i = find(cache, &key, challenge);
+    if (i != NIL) {
+        cache->stats.hits++;
+        cp = cache->entries[i].checkpoint;
+        lru_unlink(cache, i);
+        lru_push_front(cache, i);
+    } else {
+        cache->stats.misses++;
+        auth_checkpoint_advance(&cp, secret, challenge, prefix_length);
+        insert(cache, &key, challenge, &cp);
+    }
+
+    auth_checkpoint_advance(&cp, secret, challenge + prefix_length, length - prefix_length);
+    *out = auth_checkpoint_response(&cp, secret);
+    return 1;
+}
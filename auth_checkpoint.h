@@ -0,0 +1,39 @@
+// auth_checkpoint.h
+// Challenge-prefix checkpoint cache
+//
+// Devices that receive the same broadcast challenge, or challenges sharing
+// a long common prefix, replay the same early evolution. The cache keeps
+// the engine state after a prefix and resumes from it, so only the
+// remaining entries are evolved. Bounded, least-recently-used eviction.
+// Not thread-safe: use one cache per thread.
+
+#ifndef AUTH_CHECKPOINT_H
+#define AUTH_CHECKPOINT_H
+
+#include "physics_auth.h"
+
+typedef struct AuthCheckpointCache AuthCheckpointCache;
+
+typedef struct {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+} AuthCheckpointStats;
+
+AuthCheckpointCache* auth_checkpoint_cache_create(int capacity);
+void auth_checkpoint_cache_destroy(AuthCheckpointCache* cache);
+
+// Compute a response, checkpointing after the first prefix_length entries.
+// A later call with the same secret, revision, prefix and step schedule
+// (steps-per-challenge band, or the exact length when the schedule is not
+// uniform) resumes from the checkpoint. Passing
+// prefix_length = length caches the whole challenge, so a follow-up that
+// extends it only pays for the new entries. Bit-identical to
+// auth_compute_response_rev(); returns 0 if the revision is unsupported.
+int auth_checkpoint_cache_compute(AuthCheckpointCache* cache, const float* challenge,
+                                  int length, int prefix_length, const AuthSecret* secret,
+                                  int revision, AuthResponse* out);
+
+AuthCheckpointStats auth_checkpoint_cache_stats(const AuthCheckpointCache* cache);
+
+#endif // AUTH_CHECKPOINT_H
@@ -0,0 +1,91 @@
+// auth_conformance.c
+// Conformance corpus generator and checker (format in auth_corpus.h)
+//
+// Usage: auth_conformance gen <corpus> <count> [revision|fixed] [seed] [threads]
+//        auth_conformance check <corpus> [threads]
+// gen computes the golden vectors with the scalar Phi kernel. check
+// replays them along every path (scalar, batch, sliced) under every SIMD
+// backend this CPU supports and exits 1 on any mismatch, so a new build
+// target is qualified by checking a corpus made elsewhere.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "physics_auth.h"
+#include "auth_corpus.h"
+
+static int generate(int argc, char** argv) {
+    AuthCorpusConfig cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.count = strtoull(argv[3], NULL, 0);
+    cfg.engine = AUTH_CORPUS_FLOAT;
+    cfg.revision = AUTH_ENGINE_REV_LATEST;
+    if (argc > 4 && strcmp(argv[4], "fixed") == 0) {
+        cfg.engine = AUTH_CORPUS_FIXED;
+    } else if (argc > 4) {
+        cfg.revision = atoi(argv[4]);
+    }
+    cfg.seed = argc > 5 ? strtoull(argv[5], NULL, 0) : 1;
+    cfg.threads = argc > 6 ? atoi(argv[6]) : 0;
+
+    auth_simd_select(AUTH_SIMD_SCALAR);   // the reference kernel
+    printf("Generating %llu vectors (%s, seed %llu)\n", (unsigned long long)cfg.count,
+           cfg.engine == AUTH_CORPUS_FIXED ? "fixed-point" : "float",
+           (unsigned long long)cfg.seed);
+    if (!auth_corpus_generate(&cfg, argv[2])) {
+        fprintf(stderr, "Generation failed (count 1..2^32, supported revision, writable %s)\n",
+                argv[2]);
+        return 1;
+    }
+    printf("Wrote %s (%llu bytes)\n", argv[2],
+           (unsigned long long)(AUTH_CORPUS_HEADER_SIZE + cfg.count * AUTH_CORPUS_RECORD_SIZE));
+    return 0;
+}
+
+static int check(int argc, char** argv) {
+    AuthCorpus corpus;
+    if (!auth_corpus_open(&corpus, argv[2])) {
+        fprintf(stderr, "%s: not a valid corpus (or checksum mismatch)\n", argv[2]);
+        return 1;
+    }
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    AuthSimdBackend initial = auth_simd_active();
+    printf("%s: %llu vectors, %s engine", argv[2], (unsigned long long)corpus.count,
+           corpus.engine == AUTH_CORPUS_FIXED ? "fixed-point" : "float");
+    if (corpus.engine == AUTH_CORPUS_FLOAT) printf(" revision %d", corpus.revision);
+    printf(", checksum %016llx\n\n", (unsigned long long)corpus.checksum);
+    printf("  %-8s %-7s %12s %14s\n", "backend", "path", "mismatches", "vectors/min");
+
+    int failed = 0;
+    for (int b = AUTH_SIMD_SCALAR; b <= AUTH_SIMD_NEON; b++) {
+        if (!auth_simd_select((AuthSimdBackend)b)) continue;
+        for (int p = 0; p < AUTH_CORPUS_PATHS; p++) {
+            AuthCorpusReport report;
+            if (!auth_corpus_check(&corpus, (AuthCorpusPath)p, threads, &report)) continue;
+            printf("  %-8s %-7s %12llu %14.0f", auth_simd_name((AuthSimdBackend)b),
+                   auth_corpus_path_name((AuthCorpusPath)p),
+                   (unsigned long long)report.mismatches, report.vectors_per_sec * 60.0);
+            if (report.mismatches) {
+                printf("  first at vector %llu", (unsigned long long)report.first_mismatch);
+                failed = 1;
+            }
+            printf("\n");
+        }
+        // The fixed-point engine has no SIMD kernel
+        if (corpus.engine == AUTH_CORPUS_FIXED) break;
+    }
+    auth_simd_select(initial);
+    auth_corpus_close(&corpus);
+    printf("\n%s\n", failed ? "FAIL: this build does not reproduce the corpus"
+                            : "PASS: bit-identical on every path");
+    return failed;
+}
+
+int main(int argc, char** argv) {
+    auth_init();
+    if (argc >= 4 && strcmp(argv[1], "gen") == 0) return generate(argc, argv);
+    if (argc >= 3 && strcmp(argv[1], "check") == 0) return check(argc, argv);
+    fprintf(stderr, "Usage: %s gen <corpus> <count> [revision|fixed] [seed] [threads]\n"
+                    "       %s check <corpus> [threads]\n", argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,410 @@
+// auth_corpus.c
+// Conformance corpus: golden vectors every engine variant must reproduce
+
+#include "auth_corpus.h"
+#include "auth_util.h"
+#include "physics_auth_internal.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CORPUS_CHUNK 64          // vectors per claimed chunk, multiple of AUTH_CORPUS_BLOCK
+#define CORPUS_MAX_COUNT (1ull << 32)
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+static void put_u16(unsigned char* p, uint16_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void put_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint16_t get_u16(const unsigned char* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t get_u64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+// Floats travel as their bit patterns
+static void put_f32(unsigned char* p, float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    put_u32(p, u);
+}
+
+static float get_f32(const unsigned char* p) {
+    uint32_t u = get_u32(p);
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static void encode_vector(unsigned char* p, const AuthCorpusVector* v) {
+    put_f32(p, v->secret.k);
+    put_f32(p + 4, v->secret.gamma);
+    put_u32(p + 8, v->secret.seed);
+    put_u32(p + 12, v->challenge_id);
+    put_u16(p + 16, (uint16_t)v->length);
+    p[18] = (unsigned char)v->profile;
+    p[19] = 0;
+    // Both response forms are 8 x 32 bits in AuthResponse order
+    uint32_t bits[8];
+    memcpy(bits, &v->response, sizeof(bits));
+    for (int c = 0; c < 8; c++) put_u32(p + 20 + 4 * c, bits[c]);
+}
+
+static void decode_vector(const unsigned char* p, AuthCorpusVector* v) {
+    v->secret.k = get_f32(p);
+    v->secret.gamma = get_f32(p + 4);
+    v->secret.seed = get_u32(p + 8);
+    v->challenge_id = get_u32(p + 12);
+    v->length = get_u16(p + 16);
+    v->profile = p[18];
+    uint32_t bits[8];
+    for (int c = 0; c < 8; c++) bits[c] = get_u32(p + 20 + 4 * c);
+    memcpy(&v->response, bits, sizeof(bits));
+}
+
+static uint64_t fnv1a64(const unsigned char* p, size_t n) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+
+// ============================================================================
+// VECTORS
+// ============================================================================
+// Counter-based like auth_sweep: the block's profile and length come from
+// the block number, the secret and challenge id from the vector index.
+
+void auth_corpus_vector(const AuthCorpusConfig* cfg, uint64_t index, AuthCorpusVector* v) {
+    memset(v, 0, sizeof(*v));
+
+    // Per block: 5/8 default, 2/8 low-power, 1/8 hardened; 3/4 at the
+    // profile's own length, the rest anywhere in 1..CHALLENGE_LENGTH
+    uint64_t block_state = cfg->seed ^ ((index / AUTH_CORPUS_BLOCK) * 0xa0761d6478bd642full);
+    uint64_t a = auth_splitmix64(&block_state);
+    int pick = (int)(a & 7);
+    v->profile = AUTH_PROFILE_DEFAULT;
+    if (cfg->engine == AUTH_CORPUS_FLOAT && pick >= 5) {
+        v->profile = pick == 7 ? AUTH_PROFILE_HARDENED : AUTH_PROFILE_LOW_POWER;
+    }
+    v->length = ((a >> 3) & 3) ? auth_profile_presets[v->profile].challenge_length
+                               : 1 + (int)((a >> 8) % CHALLENGE_LENGTH);
+
+    uint64_t state = cfg->seed ^ (index * 0xd1b54a32d192ed03ull);
+    uint64_t b = auth_splitmix64(&state);
+    uint64_t c = auth_splitmix64(&state);
+    v->secret.k = (float)(0.5 + 3.0 * (double)(b >> 40) / 16777216.0);
+    v->secret.gamma = (float)(0.1 + 0.9 * (double)((b >> 16) & 0xFFFFFF) / 16777216.0);
+    v->secret.seed = (uint32_t)c;
+    v->challenge_id = (uint32_t)(c >> 32);
+}
+
+static void compute_reference(AuthCorpusEngine engine, int revision, AuthCorpusVector* v) {
+    if (engine == AUTH_CORPUS_FIXED) {
+        auth_q16 challenge[CHALLENGE_LENGTH];
+        auth_challenge_from_id_q16(v->challenge_id, challenge, v->length);
+        AuthSecretQ16 secret = auth_secret_to_q16(&v->secret);
+        auth_compute_response_q16(challenge, v->length, &secret, &v->response.q);
+    } else {
+        float challenge[CHALLENGE_LENGTH];
+        auth_challenge_from_id(v->challenge_id, challenge, v->length);
+        auth_compute_response_ex(challenge, v->length, &v->secret, revision,
+                                 &auth_profile_presets[v->profile], &v->response.f);
+    }
+}
+
+static int revision_ok(AuthCorpusEngine engine, int revision) {
+    if (engine == AUTH_CORPUS_FIXED) return 1;
+    return revision >= 1 && revision <= 31 && auth_engine_negotiate(1u << revision) == revision;
+}
+
+// ============================================================================
+// GENERATION
+// ============================================================================
+
+typedef struct {
+    const AuthCorpusConfig* cfg;
+    unsigned char* records;
+    uint64_t n_chunks;
+    atomic_uint_fast64_t next_chunk;
+} GenerateShared;
+
+static void* generate_worker(void* arg) {
+    GenerateShared* sh = arg;
+    const AuthCorpusConfig* cfg = sh->cfg;
+    for (;;) {
+        uint64_t chunk = atomic_fetch_add_explicit(&sh->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= sh->n_chunks) break;
+        uint64_t end = (chunk + 1) * CORPUS_CHUNK;
+        if (end > cfg->count) end = cfg->count;
+        for (uint64_t i = chunk * CORPUS_CHUNK; i < end; i++) {
+            AuthCorpusVector v;
+            auth_corpus_vector(cfg, i, &v);
+            compute_reference(cfg->engine, cfg->revision, &v);
+            encode_vector(sh->records + i * AUTH_CORPUS_RECORD_SIZE, &v);
+        }
+    }
+    return NULL;
+}
+
+int auth_corpus_generate(const AuthCorpusConfig* cfg, const char* path) {
+    if (!cfg || !path || cfg->count == 0 || cfg->count > CORPUS_MAX_COUNT) return 0;
+    if (cfg->engine != AUTH_CORPUS_FLOAT && cfg->engine != AUTH_CORPUS_FIXED) return 0;
+    if (!revision_ok(cfg->engine, cfg->revision)) return 0;
+
+    size_t size = AUTH_CORPUS_HEADER_SIZE + (size_t)cfg->count * AUTH_CORPUS_RECORD_SIZE;
+    unsigned char* data = calloc(1, size);
+    if (!data) return 0;
+
+    GenerateShared sh;
+    sh.cfg = cfg;
+    sh.records = data + AUTH_CORPUS_HEADER_SIZE;
+    sh.n_chunks = (cfg->count + CORPUS_CHUNK - 1) / CORPUS_CHUNK;
+    atomic_init(&sh.next_chunk, 0);
+    auth_tables_ensure();   // before any worker reads the tables
+    auth_workers_run(generate_worker, &sh, auth_workers_resolve(cfg->threads, sh.n_chunks));
+
+    memcpy(data, AUTH_CORPUS_MAGIC, 8);
+    put_u32(data + 8, AUTH_CORPUS_VERSION);
+    put_u32(data + 12, (uint32_t)cfg->engine);
+    put_u32(data + 16, cfg->engine == AUTH_CORPUS_FLOAT ? (uint32_t)cfg->revision : 0);
+    put_u32(data + 20, AUTH_CORPUS_RECORD_SIZE);
+    put_u64(data + 24, cfg->count);
+    put_u64(data + 32, cfg->seed);
+    put_u64(data + 40, fnv1a64(sh.records, size - AUTH_CORPUS_HEADER_SIZE));
+
+    FILE* f = fopen(path, "wb");
+    int ok = f && fwrite(data, 1, size, f) == size;
+    if (f && fclose(f) != 0) ok = 0;
+    free(data);
+    return ok;
+}
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+// Validate data and take ownership of it; frees it on failure
+static int corpus_adopt(AuthCorpus* corpus, unsigned char* data, size_t size) {
+    memset(corpus, 0, sizeof(*corpus));
+    int ok = size >= AUTH_CORPUS_HEADER_SIZE && memcmp(data, AUTH_CORPUS_MAGIC, 8) == 0 &&
+             get_u32(data + 8) == AUTH_CORPUS_VERSION &&
+             get_u32(data + 20) == AUTH_CORPUS_RECORD_SIZE;
+    uint64_t count = ok ? get_u64(data + 24) : 0;
+    ok = ok && count > 0 && count <= CORPUS_MAX_COUNT &&
+         size == AUTH_CORPUS_HEADER_SIZE + count * AUTH_CORPUS_RECORD_SIZE;
+    AuthCorpusEngine engine = ok ? (AuthCorpusEngine)get_u32(data + 12) : AUTH_CORPUS_FLOAT;
+    ok = ok && (engine == AUTH_CORPUS_FLOAT || engine == AUTH_CORPUS_FIXED) &&
+         fnv1a64(data + AUTH_CORPUS_HEADER_SIZE, size - AUTH_CORPUS_HEADER_SIZE) ==
+             get_u64(data + 40);
+
+    // Lengths and profiles index engine buffers: check every record
+    for (uint64_t i = 0; ok && i < count; i++) {
+        const unsigned char* p = data + AUTH_CORPUS_HEADER_SIZE + i * AUTH_CORPUS_RECORD_SIZE;
+        int length = get_u16(p + 16);
+        ok = length >= 1 && length <= CHALLENGE_LENGTH && p[18] < AUTH_PROFILE_PRESETS;
+    }
+    if (!ok) {
+        free(data);
+        return 0;
+    }
+    corpus->engine = engine;
+    corpus->revision = (int)get_u32(data + 16);
+    corpus->count = count;
+    corpus->seed = get_u64(data + 32);
+    corpus->checksum = get_u64(data + 40);
+    corpus->data = data;
+    corpus->size = size;
+    return 1;
+}
+
+int auth_corpus_open(AuthCorpus* corpus, const char* path) {
+    memset(corpus, 0, sizeof(*corpus));
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    unsigned char* data = NULL;
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (size > 0 && fseek(f, 0, SEEK_SET) == 0) data = malloc((size_t)size);
+    int ok = data && fread(data, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    if (!ok) {
+        free(data);
+        return 0;
+    }
+    return corpus_adopt(corpus, data, (size_t)size);
+}
+
+int auth_corpus_attach(AuthCorpus* corpus, const void* data, size_t size) {
+    memset(corpus, 0, sizeof(*corpus));
+    unsigned char* copy = malloc(size ? size : 1);
+    if (!copy) return 0;
+    memcpy(copy, data, size);
+    return corpus_adopt(corpus, copy, size);
+}
+
+void auth_corpus_close(AuthCorpus* corpus) {
+    free(corpus->data);
+    memset(corpus, 0, sizeof(*corpus));
+}
+
+void auth_corpus_get(const AuthCorpus* corpus, uint64_t index, AuthCorpusVector* v) {
+    decode_vector(corpus->data + AUTH_CORPUS_HEADER_SIZE + index * AUTH_CORPUS_RECORD_SIZE, v);
+}
+
+// ============================================================================
+// CHECKING
+// ============================================================================
+
+typedef struct {
+    const AuthCorpus* corpus;
+    AuthCorpusPath path;
+    uint64_t n_chunks;
+    atomic_uint_fast64_t next_chunk;
+    atomic_uint_fast64_t mismatches;
+    atomic_uint_fast64_t first_mismatch;
+} CheckShared;
+
+static void record_mismatch(CheckShared* sh, uint64_t index) {
+    atomic_fetch_add_explicit(&sh->mismatches, 1, memory_order_relaxed);
+    uint64_t seen = atomic_load_explicit(&sh->first_mismatch, memory_order_relaxed);
+    while (index < seen && !atomic_compare_exchange_weak_explicit(&sh->first_mismatch, &seen,
+                                                                  index, memory_order_relaxed,
+                                                                  memory_order_relaxed)) {
+    }
+}
+
+// Recompute vectors[0 .. n) (consecutive, same length and profile) along path
+static void recompute(const AuthCorpus* corpus, AuthCorpusPath path, uint64_t first,
+                      AuthCorpusVector* vectors, int n, AuthResponse* out) {
+    float lane_challenges[AUTH_CORPUS_BLOCK * CHALLENGE_LENGTH];
+    const AuthProfile* profile = &auth_profile_presets[vectors[0].profile];
+    int length = vectors[0].length;
+    for (int j = 0; j < n; j++) {
+        auth_challenge_from_id(vectors[j].challenge_id, lane_challenges + j * CHALLENGE_LENGTH,
+                               length);
+    }
+    if (path == AUTH_CORPUS_PATH_BATCH) {
+        AuthSecret secrets[AUTH_CORPUS_BLOCK];
+        for (int j = 0; j < n; j++) secrets[j] = vectors[j].secret;
+        auth_compute_response_batch_ex(lane_challenges, length, CHALLENGE_LENGTH, secrets, n,
+                                       corpus->revision, profile, out);
+        return;
+    }
+    for (int j = 0; j < n; j++) {
+        const float* challenge = lane_challenges + j * CHALLENGE_LENGTH;
+        if (path == AUTH_CORPUS_PATH_SLICED) {
+            AuthSlice slice;
+            int slice_steps = 1 + (int)((first + (uint64_t)j) % 61);
+            auth_slice_begin(&slice, &vectors[j].secret, length, corpus->revision, profile);
+            while (auth_slice_run(&slice, challenge, length, slice_steps) > 0) {
+            }
+            auth_slice_finish(&slice, &out[j]);
+        } else {
+            auth_compute_response_ex(challenge, length, &vectors[j].secret, corpus->revision,
+                                     profile, &out[j]);
+        }
+    }
+}
+
+static void* check_worker(void* arg) {
+    CheckShared* sh = arg;
+    const AuthCorpus* corpus = sh->corpus;
+    for (;;) {
+        uint64_t chunk = atomic_fetch_add_explicit(&sh->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= sh->n_chunks) break;
+        uint64_t end = (chunk + 1) * CORPUS_CHUNK;
+        if (end > corpus->count) end = corpus->count;
+
+        for (uint64_t i = chunk * CORPUS_CHUNK; i < end;) {
+            AuthCorpusVector vectors[AUTH_CORPUS_BLOCK];
+            AuthResponse out[AUTH_CORPUS_BLOCK];
+            int n = 0;
+            auth_corpus_get(corpus, i, &vectors[0]);
+            if (corpus->engine == AUTH_CORPUS_FIXED) {
+                AuthCorpusVector fixed = vectors[0];
+                compute_reference(AUTH_CORPUS_FIXED, 0, &fixed);
+                if (memcmp(&fixed.response.q, &vectors[0].response.q,
+                           sizeof(AuthResponseQ16)) != 0) {
+                    record_mismatch(sh, i);
+                }
+                i++;
+                continue;
+            }
+            // Group a run sharing length and profile (a generated block)
+            for (n = 1; n < AUTH_CORPUS_BLOCK && i + (uint64_t)n < end; n++) {
+                auth_corpus_get(corpus, i + (uint64_t)n, &vectors[n]);
+                if (vectors[n].length != vectors[0].length ||
+                    vectors[n].profile != vectors[0].profile) {
+                    break;
+                }
+            }
+            recompute(corpus, sh->path, i, vectors, n, out);
+            for (int j = 0; j < n; j++) {
+                if (memcmp(&out[j], &vectors[j].response.f, sizeof(AuthResponse)) != 0) {
+                    record_mismatch(sh, i + (uint64_t)j);
+                }
+            }
+            i += (uint64_t)n;
+        }
+    }
+    return NULL;
+}
+
+int auth_corpus_check(const AuthCorpus* corpus, AuthCorpusPath path, int threads,
+                      AuthCorpusReport* report) {
+    if (!corpus || !corpus->data || !report || path < 0 || path >= AUTH_CORPUS_PATHS) return 0;
+    if (corpus->engine == AUTH_CORPUS_FIXED && path != AUTH_CORPUS_PATH_SCALAR) return 0;
+    if (!revision_ok(corpus->engine, corpus->revision)) return 0;
+
+    CheckShared sh;
+    sh.corpus = corpus;
+    sh.path = path;
+    sh.n_chunks = (corpus->count + CORPUS_CHUNK - 1) / CORPUS_CHUNK;
+    atomic_init(&sh.next_chunk, 0);
+    atomic_init(&sh.mismatches, 0);
+    atomic_init(&sh.first_mismatch, UINT64_MAX);
+    auth_tables_ensure();
+
+    double start = auth_now_seconds();
+    auth_workers_run(check_worker, &sh, auth_workers_resolve(threads, sh.n_chunks));
+    double seconds = auth_now_seconds() - start;
+
+    report->vectors = corpus->count;
+    report->mismatches = atomic_load(&sh.mismatches);
+    report->first_mismatch = report->mismatches ? atomic_load(&sh.first_mismatch) : 0;
+    report->seconds = seconds;
+    report->vectors_per_sec = seconds > 0.0 ? (double)corpus->count / seconds : 0.0;
+    return 1;
+}
+
+const char* auth_corpus_path_name(AuthCorpusPath path) {
+    switch (path) {
+    case AUTH_CORPUS_PATH_SCALAR: return "scalar";
+    case AUTH_CORPUS_PATH_BATCH: return "batch";
+    case AUTH_CORPUS_PATH_SLICED: return "sliced";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,111 @@
+// auth_corpus.h
+// Conformance corpus: golden vectors every engine variant must reproduce
+//
+// A corpus is a binary file of (secret, challenge, response) vectors from
+// the reference scalar engine. Any other build - another CPU or libm, a
+// SIMD backend, the batch or sliced paths - replays it and must produce
+// every response bit for bit.
+// - vector i is a pure function of (corpus seed, i) (splitmix64), so a
+//   corpus is the same whatever the thread count that generated it
+// - challenges are stored as a challenge id (auth_challenge_from_id) and a
+//   length, which keeps a vector at AUTH_CORPUS_RECORD_SIZE bytes
+// - vectors come in blocks of AUTH_CORPUS_BLOCK that share profile and
+//   length, so the batch path sees full lanes of different secrets
+// - generation and checking run on worker threads claiming chunks from a
+//   shared counter
+//
+// File layout, little-endian whatever the host:
+//   header (AUTH_CORPUS_HEADER_SIZE): magic, u32 version, u32 engine,
+//     u32 revision, u32 record size, u64 count, u64 seed, u64 FNV-1a of
+//     the records, zero padding
+//   count records: f32 k, f32 gamma, u32 seed, u32 challenge id,
+//     u16 length, u8 profile, u8 0, then the 8 response channels as f32
+//     (float engine) or Q16.16 (fixed-point engine), AuthResponse order
+
+#ifndef AUTH_CORPUS_H
+#define AUTH_CORPUS_H
+
+#include <stddef.h>
+#include "physics_auth.h"
+
+#define AUTH_CORPUS_MAGIC "PAUTHCRP"
+#define AUTH_CORPUS_VERSION 1
+#define AUTH_CORPUS_HEADER_SIZE 64
+#define AUTH_CORPUS_RECORD_SIZE 52
+#define AUTH_CORPUS_BLOCK AUTH_BATCH_LANES
+
+typedef enum {
+    AUTH_CORPUS_FLOAT = 0,      // auth_compute_response_ex() at the corpus revision
+    AUTH_CORPUS_FIXED           // auth_compute_response_q16() (revision and profile unused)
+} AuthCorpusEngine;
+
+// Ways of computing a response; each must match the corpus exactly
+typedef enum {
+    AUTH_CORPUS_PATH_SCALAR = 0,  // one call per vector
+    AUTH_CORPUS_PATH_BATCH,       // auth_compute_response_batch_ex() per block
+    AUTH_CORPUS_PATH_SLICED,      // AuthSlice, slice size varying per vector
+    AUTH_CORPUS_PATHS
+} AuthCorpusPath;
+
+typedef struct {
+    AuthSecret secret;
+    uint32_t challenge_id;
+    int length;
+    int profile;                // AUTH_PROFILE_* preset
+    union {
+        AuthResponse f;
+        AuthResponseQ16 q;
+    } response;
+} AuthCorpusVector;
+
+typedef struct {
+    AuthCorpusEngine engine;
+    int revision;               // AUTH_ENGINE_REV_* (float engine)
+    uint64_t seed;
+    uint64_t count;
+    int threads;                // <= 0: one per online CPU
+} AuthCorpusConfig;
+
+// A corpus loaded into memory
+typedef struct {
+    AuthCorpusEngine engine;
+    int revision;
+    uint64_t seed;
+    uint64_t count;
+    uint64_t checksum;
+    unsigned char* data;        // the whole file
+    size_t size;
+} AuthCorpus;
+
+typedef struct {
+    uint64_t vectors;
+    uint64_t mismatches;
+    uint64_t first_mismatch;    // vector index, valid when mismatches > 0
+    double seconds;
+    double vectors_per_sec;
+} AuthCorpusReport;
+
+// The inputs of vector index (secret, challenge id, length, profile); the
+// response is left zero
+void auth_corpus_vector(const AuthCorpusConfig* cfg, uint64_t index, AuthCorpusVector* v);
+
+// Compute cfg->count vectors with the active engine and write them to
+// path. The whole corpus is built in memory first. Returns 0 on a bad
+// config, unsupported revision, allocation or I/O failure.
+int auth_corpus_generate(const AuthCorpusConfig* cfg, const char* path);
+
+// Load and validate (magic, version, sizes, checksum); 0 if invalid
+int auth_corpus_open(AuthCorpus* corpus, const char* path);
+int auth_corpus_attach(AuthCorpus* corpus, const void* data, size_t size);   // copies data
+void auth_corpus_close(AuthCorpus* corpus);
+void auth_corpus_get(const AuthCorpus* corpus, uint64_t index, AuthCorpusVector* v);
+
+// Recompute every vector along path on threads workers (<= 0: one per
+// online CPU) and compare bit for bit. Returns 0 if the path does not
+// apply (batch and sliced are float-engine only) or the revision is
+// unsupported; mismatches are in the report.
+int auth_corpus_check(const AuthCorpus* corpus, AuthCorpusPath path, int threads,
+                      AuthCorpusReport* report);
+const char* auth_corpus_path_name(AuthCorpusPath path);
+
+#endif // AUTH_CORPUS_H
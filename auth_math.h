@@ -0,0 +1,102 @@
+// auth_math.h
+// Portable, bit-reproducible sinf/cosf for the engine (REV_4 and up)
+//
+// libm sinf/cosf differ between glibc, newlib, Apple and MSVC in the last
+// ulp, which is enough to split client and server on the same challenge.
+// These use only IEEE-754 single-precision +, -, * (no libm, no division),
+// so any conforming target gives the same bits:
+// - range reduction to r in [-pi/4, pi/4] by k = round(x * 2/pi) and a
+//   three-part Cody-Waite pi/2, exact for |x| <= AUTH_MATH_REDUCE_MAX
+// - fixed-degree minimax polynomials on that interval (degree 7 sine,
+//   degree 8 cosine, the Cephes sinf/cosf coefficients), max error ~1 ulp
+// - the quadrant picks polynomial and sign with selects, no branches, so
+//   lane loops over the _reduced forms vectorize (the batch engine checks
+//   its lanes are in range first)
+// Beyond AUTH_MATH_REDUCE_MAX the argument is first folded with
+// fmodf(x, 2pi) (exact, so still deterministic, but drifting from the true
+// sine by the error of float 2pi). The engine's state never gets there.
+//
+// Requires float arithmetic evaluated in float (FLT_EVAL_METHOD 0, or 16
+// where only _Float16 is widened) and no FMA contraction (-ffp-contract=off,
+// set in the Makefile).
+
+#ifndef AUTH_MATH_H
+#define AUTH_MATH_H
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 1 || FLT_EVAL_METHOD == 2)
+#error "auth_math.h needs float evaluated in float (use -msse2 -mfpmath=sse on x86-32)"
+#endif
+
+#define AUTH_MATH_REDUCE_MAX 8192.0f
+#define AUTH_MATH_TWO_PI 6.28318548202514648438f     // float(2 pi)
+
+#define AUTH_MATH_TWO_OVER_PI 0.636619772367581343076f
+#define AUTH_MATH_ROUND_MAGIC 12582912.0f             // 1.5 * 2^23
+#define AUTH_MATH_PIO2_HI 1.5703125f                  // 8 significant bits
+#define AUTH_MATH_PIO2_MID 4.837512969970703125e-4f   // 11 significant bits
+#define AUTH_MATH_PIO2_LO 7.54978995489188216e-8f
+
+// Out-of-range arguments: NaN for inf/NaN, else the exact remainder by 2pi
+static inline float auth_math_fold(float x) {
+    if (!isfinite(x)) return x - x;
+    return fmodf(x, AUTH_MATH_TWO_PI);
+}
+
+// |x| <= AUTH_MATH_REDUCE_MAX only. Straight-line code: loops over it
+// vectorize.
+static inline void auth_sincosf_reduced(float x, float* s, float* c) {
+    // k = round-to-nearest(x * 2/pi) by the 1.5 * 2^23 trick
+    float kf = (x * AUTH_MATH_TWO_OVER_PI + AUTH_MATH_ROUND_MAGIC) - AUTH_MATH_ROUND_MAGIC;
+    int32_t q = (int32_t)kf;
+    float r = ((x - kf * AUTH_MATH_PIO2_HI) - kf * AUTH_MATH_PIO2_MID) - kf * AUTH_MATH_PIO2_LO;
+
+    float z = r * r;
+    float ps = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+    float pc = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z
+                + 4.166664568298827e-2f) * z * z;
+    pc = pc - 0.5f * z;
+    pc = pc + 1.0f;
+
+    // Quadrant q: sin = ps, pc, -ps, -pc and cos = pc, -ps, -pc, ps. The
+    // sign is a multiply by +-1 (exact), which keeps everything in float
+    // registers.
+    float sv = (q & 1) ? pc : ps;
+    float cv = (q & 1) ? ps : pc;
+    *s = sv * (float)(1 - (q & 2));
+    *c = cv * (float)(1 - ((q + 1) & 2));
+}
+
+static inline void auth_sincosf(float x, float* s, float* c) {
+    if (!(fabsf(x) <= AUTH_MATH_REDUCE_MAX)) x = auth_math_fold(x);
+    auth_sincosf_reduced(x, s, c);
+}
+
+static inline float auth_sinf_reduced(float x) {
+    float s, c;
+    auth_sincosf_reduced(x, &s, &c);
+    return s;
+}
+
+static inline float auth_cosf_reduced(float x) {
+    float s, c;
+    auth_sincosf_reduced(x, &s, &c);
+    return c;
+}
+
+static inline float auth_sinf(float x) {
+    float s, c;
+    auth_sincosf(x, &s, &c);
+    return s;
+}
+
+static inline float auth_cosf(float x) {
+    float s, c;
+    auth_sincosf(x, &s, &c);
+    return c;
+}
+
+#endif // AUTH_MATH_H
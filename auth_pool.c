@@ -0,0 +1,324 @@
+// auth_pool.c
+// Multi-threaded expected-response precompute pool for the verifier
+
+#define _GNU_SOURCE
+#include "auth_pool.h"
+#include "physics_auth_internal.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Expected responses come from the float batch engine; a device build
+// (auth_compute_response() on the Q16 engine) would never match them
+#if AUTH_FIXED_POINT
+#error "AUTH_FIXED_POINT=1 is a device-only build; build the server side without it"
+#endif
+
+#define POOL_QUEUE_SIZE 4096   // jobs in flight, power of two
+#define POOL_SPIN 256          // empty polls before a worker sleeps
+#define CACHE_LINE 64
+
+// ============================================================================
+// JOBS
+// ============================================================================
+
+// One auth_pool_compute() call. Lives on the caller's stack until
+// remaining reaches zero.
+typedef struct {
+    const float* challenges;
+    int length;
+    int challenge_stride;
+    const AuthSecret* secrets;
+    int revision;
+    const AuthProfile* profile;
+    AuthResponse* responses;
+    atomic_int remaining;
+} PoolBroadcast;
+
+// AUTH_BATCH_LANES secrets starting at first
+typedef struct {
+    PoolBroadcast* broadcast;
+    int first;
+    int n;
+} PoolJob;
+
+// ============================================================================
+// LOCK-FREE BOUNDED MPMC QUEUE
+// ============================================================================
+// Each cell carries a sequence number: seq == pos means free for the
+// producer claiming pos, seq == pos + 1 means filled for the consumer.
+// Producers and consumers only contend on their own cursor.
+
+typedef struct {
+    atomic_size_t seq;
+    PoolJob job;
+} PoolCell;
+
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_size_t head;   // next to dequeue
+    _Alignas(CACHE_LINE) atomic_size_t tail;   // next to enqueue
+    _Alignas(CACHE_LINE) PoolCell cells[POOL_QUEUE_SIZE];
+} PoolQueue;
+
+static void queue_init(PoolQueue* q) {
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    for (size_t i = 0; i < POOL_QUEUE_SIZE; i++) {
+        atomic_init(&q->cells[i].seq, i);
+    }
+}
+
+static int queue_push(PoolQueue* q, const PoolJob* job) {
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    for (;;) {
+        PoolCell* cell = &q->cells[pos & (POOL_QUEUE_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->job = *job;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // full
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static int queue_pop(PoolQueue* q, PoolJob* job) {
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    for (;;) {
+        PoolCell* cell = &q->cells[pos & (POOL_QUEUE_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *job = cell->job;
+                atomic_store_explicit(&cell->seq, pos + POOL_QUEUE_SIZE, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;   // empty
+        } else {
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+}
+
+static int queue_empty(PoolQueue* q) {
+    return atomic_load(&q->head) == atomic_load(&q->tail);
+}
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+// Per-worker bookkeeping, one cache line each so counters never share.
+// The batch engine's AgentStateBatch scratch lives on each worker's stack.
+typedef struct {
+    _Alignas(CACHE_LINE) pthread_t thread;
+    struct AuthPool* pool;
+    int index;
+    atomic_ulong jobs;
+} PoolWorker;
+
+struct AuthPool {
+    PoolQueue queue;
+    PoolWorker* workers;
+    int n_threads;
+    int pin_cores;
+    atomic_int stop;
+    atomic_int sleepers;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+};
+
+static void run_job(const PoolJob* job) {
+    PoolBroadcast* b = job->broadcast;
+    auth_compute_response_batch_ex(b->challenges + (size_t)job->first * b->challenge_stride,
+                                   b->length, b->challenge_stride, b->secrets + job->first,
+                                   job->n, b->revision, b->profile, b->responses + job->first);
+    atomic_fetch_sub_explicit(&b->remaining, 1, memory_order_release);
+}
+
+static void pin_worker(int index) {
+#ifdef __linux__
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+static void* worker_main(void* arg) {
+    PoolWorker* w = arg;
+    AuthPool* pool = w->pool;
+    if (pool->pin_cores) pin_worker(w->index);
+
+    PoolJob job;
+    int idle = 0;
+    while (!atomic_load(&pool->stop)) {
+        if (queue_pop(&pool->queue, &job)) {
+            run_job(&job);
+            atomic_fetch_add_explicit(&w->jobs, 1, memory_order_relaxed);
+            idle = 0;
+            continue;
+        }
+        if (++idle < POOL_SPIN) {
+            sched_yield();
+            continue;
+        }
+        // Sleep. Producers push before reading sleepers; we register
+        // before re-checking the queue, so a wakeup cannot be lost.
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add(&pool->sleepers, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (queue_empty(&pool->queue) && !atomic_load(&pool->stop)) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        atomic_fetch_sub(&pool->sleepers, 1);
+        pthread_mutex_unlock(&pool->lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+static void wake_workers(AuthPool* pool) {
+    atomic_thread_fence(memory_order_seq_cst);   // order the push before the read
+    if (atomic_load(&pool->sleepers) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+AuthPool* auth_pool_create(int n_threads, int pin_cores) {
+    if (n_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = cpus > 0 ? (int)cpus : 1;
+    }
+
+    // Tables must exist before workers race to use them
+    auth_tables_ensure();
+
+    AuthPool* pool = aligned_alloc(CACHE_LINE, (sizeof(AuthPool) + CACHE_LINE - 1) &
+                                               ~(size_t)(CACHE_LINE - 1));
+    if (!pool) return NULL;
+    PoolWorker* workers = aligned_alloc(CACHE_LINE, sizeof(PoolWorker) * (size_t)n_threads);
+    if (!workers) {
+        free(pool);
+        return NULL;
+    }
+
+    queue_init(&pool->queue);
+    pool->workers = workers;
+    pool->n_threads = 0;
+    pool->pin_cores = pin_cores;
+    atomic_init(&pool->stop, 0);
+    atomic_init(&pool->sleepers, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (int i = 0; i < n_threads; i++) {
+        workers[i].pool = pool;
+        workers[i].index = i;
+        atomic_init(&workers[i].jobs, 0);
+        if (pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]) != 0) {
+            break;
+        }
+        pool->n_threads++;
+    }
+    if (pool->n_threads == 0) {
+        auth_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void auth_pool_destroy(AuthPool* pool) {
+    if (!pool) return;
+    atomic_store(&pool->stop, 1);
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int auth_pool_threads(const AuthPool* pool) {
+    return pool->n_threads;
+}
+
+unsigned long auth_pool_worker_jobs(const AuthPool* pool, int worker) {
+    if (worker < 0 || worker >= pool->n_threads) return 0;
+    return atomic_load_explicit(&pool->workers[worker].jobs, memory_order_relaxed);
+}
+
+int auth_pool_compute(AuthPool* pool, const float* challenges, int length, int challenge_stride,
+                      const AuthSecret* secrets, int count, int revision,
+                      AuthResponse* responses) {
+    return auth_pool_compute_ex(pool, challenges, length, challenge_stride, secrets, count,
+                                revision, &auth_profile_presets[AUTH_PROFILE_DEFAULT], responses);
+}
+
+int auth_pool_compute_ex(AuthPool* pool, const float* challenges, int length,
+                         int challenge_stride, const AuthSecret* secrets, int count, int revision,
+                         const AuthProfile* profile, AuthResponse* responses) {
+    if (!auth_revision_supported(revision) || !auth_profile_valid(profile) || length < 1) {
+        return 0;
+    }
+    if (count <= 0) return 1;
+
+    int n_jobs = (count + AUTH_BATCH_LANES - 1) / AUTH_BATCH_LANES;
+    PoolBroadcast b = {
+        .challenges = challenges,
+        .length = length,
+        .challenge_stride = challenge_stride,
+        .secrets = secrets,
+        .revision = revision,
+        .profile = profile,
+        .responses = responses,
+    };
+    atomic_init(&b.remaining, n_jobs);
+
+    // Push every job; when the queue is full the caller runs jobs itself
+    PoolJob job;
+    for (int j = 0; j < n_jobs; j++) {
+        PoolJob next = {&b, j * AUTH_BATCH_LANES, AUTH_BATCH_LANES};
+        if (next.first + next.n > count) next.n = count - next.first;
+        while (!queue_push(&pool->queue, &next)) {
+            wake_workers(pool);
+            if (queue_pop(&pool->queue, &job)) run_job(&job);
+        }
+        if ((j & 63) == 0) wake_workers(pool);
+    }
+    wake_workers(pool);
+
+    // Help drain the queue (possibly other callers' jobs), then wait
+    while (atomic_load_explicit(&b.remaining, memory_order_acquire) > 0) {
+        if (queue_pop(&pool->queue, &job)) {
+            run_job(&job);
+        } else {
+            sched_yield();
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,38 @@
+// auth_pool.h
+// Multi-threaded expected-response precompute pool for the verifier
+//
+// A challenge broadcast (one challenge, or one per device) is split into
+// jobs of AUTH_BATCH_LANES secrets. Jobs go through a lock-free bounded
+// MPMC queue to worker threads pinned one per core; each job runs on the
+// batch engine, so results are bit-identical to auth_compute_response_rev().
+
+#ifndef AUTH_POOL_H
+#define AUTH_POOL_H
+
+#include "physics_auth.h"
+
+typedef struct AuthPool AuthPool;
+
+// n_threads <= 0 uses one worker per online CPU.
+// pin_cores != 0 pins worker i to CPU i (Linux only, ignored elsewhere).
+AuthPool* auth_pool_create(int n_threads, int pin_cores);
+void auth_pool_destroy(AuthPool* pool);
+int auth_pool_threads(const AuthPool* pool);
+
+// Fill responses[0..count) for a whole broadcast and wait for completion.
+// Arguments are as for auth_compute_response_batch_rev(); safe to call
+// from several threads at once. Returns 0 if the revision is unsupported
+// or length < 1.
+int auth_pool_compute(AuthPool* pool, const float* challenges, int length, int challenge_stride,
+                      const AuthSecret* secrets, int count, int revision,
+                      AuthResponse* responses);
+// The same under profile (auth_compute_response_batch_ex()); 0 also if
+// the profile is invalid
+int auth_pool_compute_ex(AuthPool* pool, const float* challenges, int length,
+                         int challenge_stride, const AuthSecret* secrets, int count, int revision,
+                         const AuthProfile* profile, AuthResponse* responses);
+
+// Jobs executed by each worker since creation (for scaling checks)
+unsigned long auth_pool_worker_jobs(const AuthPool* pool, int worker);
+
+#endif // AUTH_POOL_H
@@ -0,0 +1,305 @@
+// auth_population.c
+// PUF population simulator for manufacturing-lot qualification
+
+#include "auth_population.h"
+#include "auth_util.h"
+#include "physics_auth_internal.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POPULATION_CHUNK 256   // chips per claimed chunk, multiple of AUTH_BATCH_LANES
+#define ARENA_ALIGN 64
+
+// ============================================================================
+// CHIPS
+// ============================================================================
+
+HardwarePUF auth_puf_simulate(uint64_t lot_seed, uint32_t chip_id) {
+    HardwarePUF puf;
+    uint64_t state = lot_seed ^ ((uint64_t)chip_id * 0xd1b54a32d192ed03ull);
+    uint64_t a = auth_splitmix64(&state);
+    uint64_t b = auth_splitmix64(&state);
+    uint64_t c = auth_splitmix64(&state);
+
+    // SRAM cells have random startup states (50/50 per bit)
+    puf.sram_pattern = (uint32_t)a;
+
+    // Clock jitter: ±50 ppm variation
+    puf.clock_jitter = (float)((int)((a >> 32) % 10001) - 5000) / 100000.0f;
+
+    // Voltage offset: ±30mV variation around 3.3V
+    puf.voltage_offset = (float)((int)(b % 6001) - 3000) / 100000.0f;
+
+    // Temperature coefficient: varies per chip
+    puf.temp_coefficient = 1.0f + (float)((int)((b >> 32) % 1001) - 500) / 100000.0f;
+
+    // Ring oscillator: ~1MHz with ±2% variation
+    puf.ring_osc_count = 1000000u + (uint32_t)(c % 40001) - 20000u;
+
+    return puf;
+}
+
+AuthSecret auth_puf_derive_secret(const HardwarePUF* puf) {
+    AuthSecret secret;
+
+    // k: clock jitter and ring oscillator, 1.0 to 5.0
+    secret.k = 1.0f + puf->clock_jitter * 500.0f +
+               (float)(puf->ring_osc_count % 100000) / 25000.0f;
+
+    // gamma: voltage and temperature, 0.1 to 2.0
+    secret.gamma = 0.1f + puf->voltage_offset * 50.0f +
+                   fabsf(puf->temp_coefficient - 1.0f) * 20.0f +
+                   (float)(puf->sram_pattern % 1000) / 600.0f;
+
+    // seed: full 32-bit SRAM startup pattern
+    secret.seed = puf->sram_pattern ^ puf->ring_osc_count;
+
+    return secret;
+}
+
+void auth_puf_standard_challenge(float* challenge) {
+    for (int i = 0; i < CHALLENGE_LENGTH; i++) challenge[i] = 1.5f + (float)i * 0.02f;
+}
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+typedef struct {
+    AuthPopulation* pop;
+    uint64_t lot_seed;
+    int revision;
+    float challenge[CHALLENGE_LENGTH];
+    uint32_t n_chunks;
+    atomic_uint next_chunk;
+} PopulationShared;
+
+static void* population_worker(void* arg) {
+    PopulationShared* sh = arg;
+    AuthPopulation* pop = sh->pop;
+    for (;;) {
+        uint32_t chunk = atomic_fetch_add_explicit(&sh->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= sh->n_chunks) break;
+        uint32_t base = chunk * POPULATION_CHUNK;
+        int n = pop->chips - base < POPULATION_CHUNK ? (int)(pop->chips - base) : POPULATION_CHUNK;
+        for (int j = 0; j < n; j++) {
+            uint32_t i = base + (uint32_t)j;
+            pop->pufs[i] = auth_puf_simulate(sh->lot_seed, pop->first_id + i * pop->id_stride);
+            pop->secrets[i] = auth_puf_derive_secret(&pop->pufs[i]);
+        }
+        auth_compute_response_batch_rev(sh->challenge, CHALLENGE_LENGTH, 0, &pop->secrets[base],
+                                        n, sh->revision, &pop->fingerprints[base]);
+    }
+    return NULL;
+}
+
+// ============================================================================
+// SORT
+// ============================================================================
+// LSD radix sort of the psi channel, two 16-bit digits over an
+// order-preserving integer image of the float.
+
+static uint32_t float_key(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : u | 0x80000000u;
+}
+
+static float key_float(uint32_t u) {
+    u = (u & 0x80000000u) ? u & 0x7fffffffu : ~u;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static void sort_psi(AuthPopulation* pop, uint32_t* keys, uint32_t* tmp_keys, uint32_t* tmp_chip,
+                     uint32_t* counts) {
+    uint32_t n = pop->chips;
+    uint32_t* chip = pop->sorted_chip;
+    for (uint32_t i = 0; i < n; i++) {
+        keys[i] = float_key(pop->fingerprints[i].psi);
+        chip[i] = i;
+    }
+    for (int shift = 0; shift < 32; shift += 16) {
+        memset(counts, 0, 65536 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < n; i++) counts[(keys[i] >> shift) & 0xFFFF]++;
+        uint32_t sum = 0;
+        for (int d = 0; d < 65536; d++) {
+            uint32_t c = counts[d];
+            counts[d] = sum;
+            sum += c;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t at = counts[(keys[i] >> shift) & 0xFFFF]++;
+            tmp_keys[at] = keys[i];
+            tmp_chip[at] = chip[i];
+        }
+        memcpy(keys, tmp_keys, n * sizeof(uint32_t));
+        memcpy(chip, tmp_chip, n * sizeof(uint32_t));
+    }
+    for (uint32_t i = 0; i < n; i++) pop->sorted_psi[i] = key_float(keys[i]);
+}
+
+// ============================================================================
+// POPULATION
+// ============================================================================
+
+static size_t arena_take(size_t* used, size_t bytes) {
+    size_t at = *used;
+    *used += (bytes + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    return at;
+}
+
+int auth_population_create(AuthPopulation* pop, const AuthPopulationConfig* cfg) {
+    if (!pop || !cfg || cfg->chips < 1) return 0;
+    if (cfg->revision < 1 || cfg->revision > 31 ||
+        auth_engine_negotiate(1u << cfg->revision) != cfg->revision) return 0;
+    memset(pop, 0, sizeof(*pop));
+    pop->chips = cfg->chips;
+    pop->first_id = cfg->first_id;
+    pop->id_stride = cfg->id_stride ? cfg->id_stride : 1;
+
+    // Persistent arrays, then sort scratch that is only live during create
+    size_t n = cfg->chips, used = 0;
+    size_t at_pufs = arena_take(&used, n * sizeof(HardwarePUF));
+    size_t at_secrets = arena_take(&used, n * sizeof(AuthSecret));
+    size_t at_fingerprints = arena_take(&used, n * sizeof(AuthResponse));
+    size_t at_sorted_psi = arena_take(&used, n * sizeof(float));
+    size_t at_sorted_chip = arena_take(&used, n * sizeof(uint32_t));
+    size_t at_keys = arena_take(&used, n * sizeof(uint32_t));
+    size_t at_tmp_keys = arena_take(&used, n * sizeof(uint32_t));
+    size_t at_tmp_chip = arena_take(&used, n * sizeof(uint32_t));
+    size_t at_counts = arena_take(&used, 65536 * sizeof(uint32_t));
+    char* arena = aligned_alloc(ARENA_ALIGN, used);
+    if (!arena) return 0;
+    pop->arena = arena;
+    pop->arena_bytes = used;
+    pop->pufs = (HardwarePUF*)(arena + at_pufs);
+    pop->secrets = (AuthSecret*)(arena + at_secrets);
+    pop->fingerprints = (AuthResponse*)(arena + at_fingerprints);
+    pop->sorted_psi = (float*)(arena + at_sorted_psi);
+    pop->sorted_chip = (uint32_t*)(arena + at_sorted_chip);
+
+    PopulationShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.pop = pop;
+    sh.lot_seed = cfg->lot_seed;
+    sh.revision = cfg->revision;
+    auth_puf_standard_challenge(sh.challenge);
+    sh.n_chunks = (uint32_t)((n + POPULATION_CHUNK - 1) / POPULATION_CHUNK);
+    atomic_init(&sh.next_chunk, 0);
+
+    int n_threads = auth_workers_resolve(cfg->threads, sh.n_chunks);
+    auth_tables_ensure();   // before any worker reads the tables
+    double start = auth_now_seconds();
+    auth_workers_run(population_worker, &sh, n_threads);
+
+    sort_psi(pop, (uint32_t*)(arena + at_keys), (uint32_t*)(arena + at_tmp_keys),
+             (uint32_t*)(arena + at_tmp_chip), (uint32_t*)(arena + at_counts));
+    pop->seconds = auth_now_seconds() - start;
+    return 1;
+}
+
+void auth_population_destroy(AuthPopulation* pop) {
+    if (!pop) return;
+    free(pop->arena);
+    memset(pop, 0, sizeof(*pop));
+}
+
+// ============================================================================
+// ANALYSIS
+// ============================================================================
+// Everything below walks sorted_psi once or a few times: pairs within a
+// distance of each other are contiguous, so counting them is a two-pointer
+// sweep instead of a comparison per pair.
+
+// Pairs whose psi distance d has (int)(d * 10) < bucket
+static uint64_t pairs_below_bucket(const float* s, uint32_t n, int bucket) {
+    uint64_t pairs = 0;
+    uint32_t lo = 0;
+    for (uint32_t hi = 0; hi < n; hi++) {
+        while ((int)((s[hi] - s[lo]) * 10.0f) >= bucket) lo++;
+        pairs += hi - lo;
+    }
+    return pairs;
+}
+
+static int same_response(const AuthResponse* a, const AuthResponse* b, float tolerance) {
+    return fabsf(a->psi - b->psi) < tolerance && fabsf(a->i_val - b->i_val) < tolerance &&
+           fabsf(a->r_val - b->r_val) < tolerance && fabsf(a->phi_avg - b->phi_avg) < tolerance;
+}
+
+int auth_population_analyze(const AuthPopulation* pop, float tolerance,
+                            AuthPopulationReport* report) {
+    if (!pop || !pop->arena || !report) return 0;
+    memset(report, 0, sizeof(*report));
+    double start = auth_now_seconds();
+    const float* s = pop->sorted_psi;
+    uint32_t n = pop->chips;
+    report->pairs = (uint64_t)n * (n - 1) / 2;
+
+    // Mean, spread and sum of all pair distances (sorted: s[j] - s[i] for i < j)
+    double sum = 0.0, sum_sq = 0.0, pair_sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        sum += s[i];
+        sum_sq += (double)s[i] * s[i];
+        pair_sum += (double)s[i] * (2.0 * i - (double)(n - 1));
+    }
+    report->mean = sum / n;
+    double variance = sum_sq / n - report->mean * report->mean;
+    report->std_dev = variance > 0.0 ? sqrt(variance) : 0.0;
+    report->mean_pair_distance = report->pairs ? pair_sum / (double)report->pairs : 0.0;
+
+    // Nearest neighbours are adjacent
+    report->min_distance = INFINITY;
+    double nn_sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        float left = i > 0 ? s[i] - s[i - 1] : INFINITY;
+        float right = i + 1 < n ? s[i + 1] - s[i] : INFINITY;
+        float nearest = left < right ? left : right;
+        if (n > 1) nn_sum += nearest;
+        if (right < report->min_distance) {
+            report->min_distance = right;
+            report->closest_a = pop->first_id + pop->sorted_chip[i] * pop->id_stride;
+            report->closest_b = pop->first_id + pop->sorted_chip[i + 1] * pop->id_stride;
+        }
+    }
+    report->mean_nn_distance = n > 1 ? nn_sum / n : 0.0;
+
+    // Collisions: candidates within tolerance on psi, confirmed on I, R, phi_avg
+    for (uint32_t i = 0; i < n; i++) {
+        const AuthResponse* a = &pop->fingerprints[pop->sorted_chip[i]];
+        for (uint32_t j = i + 1; j < n && s[j] - s[i] < tolerance; j++) {
+            report->psi_collisions++;
+            if (same_response(a, &pop->fingerprints[pop->sorted_chip[j]], tolerance)) {
+                report->collisions++;
+            }
+        }
+    }
+
+    uint64_t below = 0;
+    for (int b = 0; b < AUTH_POPULATION_BUCKETS - 1; b++) {
+        uint64_t next = pairs_below_bucket(s, n, b + 1);
+        report->histogram[b] = next - below;
+        below = next;
+    }
+    report->histogram[AUTH_POPULATION_BUCKETS - 1] = report->pairs - below;
+
+    // Rounding is monotonic, so equal rounded values are adjacent too
+    float scale = 1.0f;
+    for (int p = 0; p < AUTH_POPULATION_PRECISIONS; p++) {
+        scale *= 10.0f;
+        uint32_t distinct = 0;
+        float last = 0.0f;
+        for (uint32_t i = 0; i < n; i++) {
+            float v = roundf(s[i] * scale) / scale;
+            if (i == 0 || v != last) distinct++;
+            last = v;
+        }
+        report->distinct[p] = distinct;
+    }
+    report->seconds = auth_now_seconds() - start;
+    return 1;
+}
@@ -0,0 +1,89 @@
+// auth_population.h
+// PUF population simulator for manufacturing-lot qualification
+//
+// Simulates a production lot of chips, derives each chip's secret from its
+// hardware PUF and fingerprints it with the standard challenge. All of it
+// goes into one arena, for millions of chips:
+//   - chip variations come from a counter-based PRNG (splitmix64 of the lot
+//     seed and chip id), so any chip can be regenerated on its own and the
+//     lot is the same whatever the thread count
+//   - secrets and fingerprints are computed by worker threads on the batch
+//     engine, one broadcast challenge per chunk
+//   - collisions, nearest-neighbour distances, the pair-distance histogram
+//     and distinct-fingerprint counts come from one radix sort of the psi
+//     channel, instead of comparing all pairs
+
+#ifndef AUTH_POPULATION_H
+#define AUTH_POPULATION_H
+
+#include "physics_auth.h"
+#include <stddef.h>
+
+#define AUTH_POPULATION_BUCKETS 10      // pair-distance histogram, 0.1 wide, last one open
+#define AUTH_POPULATION_PRECISIONS 4    // distinct psi at 0.1, 0.01, 0.001, 0.0001
+
+// Simulated hardware PUF sources
+typedef struct {
+    uint32_t sram_pattern;      // SRAM startup randomness
+    float clock_jitter;         // Clock frequency variation (ppm)
+    float voltage_offset;       // Vdd variation (mV)
+    float temp_coefficient;     // Temperature drift coefficient
+    uint32_t ring_osc_count;    // Ring oscillator measurement
+} HardwarePUF;
+
+typedef struct {
+    uint64_t lot_seed;          // manufacturing randomness of the lot
+    uint32_t chips;
+    uint32_t first_id;          // chip i has id first_id + i * id_stride
+    uint32_t id_stride;         // 0 counts as 1
+    int threads;                // <= 0: one per online CPU
+    int revision;               // AUTH_ENGINE_REV_*
+} AuthPopulationConfig;
+
+// One arena holds every array; index i is chip first_id + i * id_stride
+typedef struct {
+    uint32_t chips;
+    uint32_t first_id, id_stride;
+    HardwarePUF* pufs;
+    AuthSecret* secrets;
+    AuthResponse* fingerprints; // standard-challenge responses
+    float* sorted_psi;          // fingerprints[].psi, ascending
+    uint32_t* sorted_chip;      // chip index of each sorted_psi entry
+    void* arena;
+    size_t arena_bytes;
+    double seconds;             // simulation + fingerprinting wall time
+} AuthPopulation;
+
+typedef struct {
+    uint64_t pairs;
+    uint64_t psi_collisions;    // pairs whose psi agree within the tolerance
+    uint64_t collisions;        // pairs whose psi, I, R and phi_avg all agree
+    float min_distance;         // closest psi pair
+    uint32_t closest_a, closest_b;   // its chip ids
+    double mean_nn_distance;    // mean psi distance to the nearest other chip
+    double mean, std_dev;       // of psi
+    double mean_pair_distance;  // |psi_i - psi_j| over all pairs
+    uint64_t histogram[AUTH_POPULATION_BUCKETS];
+    uint32_t distinct[AUTH_POPULATION_PRECISIONS];
+    double seconds;             // analysis wall time
+} AuthPopulationReport;
+
+// Chip chip_id of the lot, regenerated from scratch
+HardwarePUF auth_puf_simulate(uint64_t lot_seed, uint32_t chip_id);
+
+// Hardware variations become the chip's physics secret
+AuthSecret auth_puf_derive_secret(const HardwarePUF* puf);
+
+// The challenge every chip is fingerprinted with (CHALLENGE_LENGTH values)
+void auth_puf_standard_challenge(float* challenge);
+
+// Simulate, derive and fingerprint the lot. Returns 0 on a bad config,
+// unsupported revision or allocation failure.
+int auth_population_create(AuthPopulation* pop, const AuthPopulationConfig* cfg);
+void auth_population_destroy(AuthPopulation* pop);
+
+// Uniqueness statistics of the lot; tolerance is the collision distance
+int auth_population_analyze(const AuthPopulation* pop, float tolerance,
+                            AuthPopulationReport* report);
+
+#endif // AUTH_POPULATION_H
@@ -0,0 +1,758 @@
+// auth_server.c
+// Epoll HTTP/1.1 verification server (Linux)
+//
+// Native replacement for the hot path of src/physics_auth.py's AuthServer:
+//   GET  /challenge?device=ID   challenge as a binary frame (auth_wire.h)
+//                               if the Accept header names it, else JSON
+//   POST /verify                binary response frame (float or quantized)
+//                               or the client's JSON
+//                               -> 200 AUTH_SUCCESS, 403 rejected or no
+//                                  pending challenge, 404 unknown device
+//   GET  /metrics               Prometheus text: challenge and verify
+//                               latency histograms, verifier counters
+// Every wakeup parses all complete requests on all ready connections, then
+// hands them to the verifier as one issue batch and one check batch, so
+// expected responses come out of a single batch-engine call. Keep-alive
+// and pipelined requests are answered in order.
+//
+// Latency is measured per request from its arrival (the recv that
+// completed it) to its reply being queued, so it includes batching.
+//
+// Usage: auth_server [-p port] [-d devices.txt] [-t timeout] [-w workers] [-r depth]
+//                    [-s statsd_host:port]
+//   -d  one "device_id k gamma seed [profile [i16]]" per line, profile one
+//       of low-power, default, hardened, i16 to accept quantized responses
+//       from the device (default: the client's demo device rpi-001, i16).
+//       Devices live in an AuthStore, so millions fit; SIGHUP reloads the
+//       file on a background thread while requests carry on.
+//   -t  challenge lifetime in seconds (default 30)
+//   -w  precompute threads for issue batches (default 1 = event loop thread)
+//   -r  challenges precomputed ahead per device by an idle-priority thread
+//       (default 2, 0 = compute every issue batch inline)
+//   -s  also push the latency histograms to a StatsD agent every
+//       STATSD_INTERVAL seconds
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "physics_auth.h"
+#include "auth_pool.h"
+#include "auth_store.h"
+#include "auth_telemetry.h"
+#include "auth_verifier.h"
+#include "auth_wire.h"
+
+#define DEFAULT_PORT 5000
+#define MAX_DEVICES 65536    // tracked at once (challenged recently); the store holds any number
+#define MAX_PENDING (4 * MAX_DEVICES)
+#define MAX_EVENTS 256
+#define MAX_BATCH 1024       // requests parsed before the verifier runs
+#define CONN_IN 8192         // request headers + body must fit
+#define MAX_BODY 1024
+#define METRICS_SIZE 16384   // /metrics body
+#define STATSD_INTERVAL 10
+
+typedef struct Conn {
+    int fd;
+    char in[CONN_IN];
+    size_t in_len;
+    char* out;
+    size_t out_len, out_sent, out_cap;
+    uint32_t events;         // registered epoll events
+    int closing;             // close once the output drains
+    int batched;             // has requests in the current batch
+    int dead;                // closed; freed by reap_conns once nothing refers to it
+    struct Conn* next_dead;
+} Conn;
+
+enum { REQ_CHALLENGE, REQ_VERIFY, REQ_METRICS, REQ_ERROR };
+
+typedef struct {
+    Conn* conn;
+    int kind;
+    int binary;              // answer in the wire format
+    int index;               // into issues[] / checks[]
+    int http_status;         // REQ_ERROR
+    uint64_t received_ns;
+    char device[AUTH_VERIFIER_MAX_ID + 1];
+} Request;
+
+typedef struct {
+    int epoll_fd;
+    AuthVerifier* verifier;
+    Request requests[MAX_BATCH];
+    AuthIssueRequest issues[MAX_BATCH];
+    AuthCheckRequest checks[MAX_BATCH];
+    int n_requests, n_issues, n_checks;
+    // Latency since start (/metrics) and since the last StatsD push
+    AuthHistogram challenge_latency, verify_latency;
+    AuthHistogram challenge_interval, verify_interval;
+    int statsd_fd;                // connected UDP socket, -1 without -s
+    Conn* dead;                   // closed connections awaiting reap_conns
+} Server;
+
+static volatile sig_atomic_t stop;
+static volatile sig_atomic_t reload_requested;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+static void on_reload(int sig) {
+    (void)sig;
+    reload_requested = 1;
+}
+
+static uint32_t now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static int out_reserve(Conn* c, size_t extra) {
+    if (c->out_len + extra <= c->out_cap) return 1;
+    size_t cap = c->out_cap ? c->out_cap : 4096;
+    while (cap < c->out_len + extra) cap *= 2;
+    char* out = realloc(c->out, cap);
+    if (!out) return 0;
+    c->out = out;
+    c->out_cap = cap;
+    return 1;
+}
+
+static void reply(Conn* c, int status, const char* content_type, const void* body, size_t size) {
+    const char* reason = status == 200 ? "OK" : status == 400 ? "Bad Request"
+                       : status == 403 ? "Forbidden" : status == 404 ? "Not Found"
+                       : status == 413 ? "Payload Too Large" : status == 429 ? "Too Many Requests"
+                       : "Error";
+    char head[160];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n\r\n", status,
+                     reason, content_type, size);
+    if (!out_reserve(c, (size_t)n + size)) {
+        c->closing = 1;
+        return;
+    }
+    memcpy(c->out + c->out_len, head, (size_t)n);
+    memcpy(c->out + c->out_len + n, body, size);
+    c->out_len += (size_t)n + size;
+}
+
+static void reply_status(Conn* c, int status, const char* name) {
+    char body[64];
+    int n = snprintf(body, sizeof(body), "{\"status\":\"%s\"}", name);
+    reply(c, status, "application/json", body, (size_t)n);
+}
+
+// Batched requests, the parser and the event loop may still hold c: drop
+// the socket now, free the memory in reap_conns
+static void conn_close(Server* s, Conn* c) {
+    if (c->dead) return;
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->dead = 1;
+    c->next_dead = s->dead;
+    s->dead = c;
+}
+
+// Once per event-loop pass, after the batch is flushed and parsing is done
+static void reap_conns(Server* s) {
+    while (s->dead) {
+        Conn* c = s->dead;
+        s->dead = c->next_dead;
+        free(c->out);
+        free(c);
+    }
+}
+
+// Send what is queued; arms EPOLLOUT while output remains. Returns 0 if
+// the connection was closed.
+static int conn_flush(Server* s, Conn* c) {
+    if (c->dead) return 0;
+    while (c->out_sent < c->out_len) {
+        ssize_t n = send(c->fd, c->out + c->out_sent, c->out_len - c->out_sent, MSG_NOSIGNAL);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n <= 0) {
+            conn_close(s, c);
+            return 0;
+        }
+        c->out_sent += (size_t)n;
+    }
+    if (c->out_sent == c->out_len) {
+        c->out_sent = c->out_len = 0;
+        if (c->closing) {
+            conn_close(s, c);
+            return 0;
+        }
+    }
+    // A closing connection only waits for its output to drain
+    uint32_t events = (c->closing ? 0 : EPOLLIN) | (c->out_len > 0 ? EPOLLOUT : 0);
+    if (events != c->events) {
+        struct epoll_event ev = {.events = events, .data.ptr = c};
+        epoll_ctl(s->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+        c->events = events;
+    }
+    return 1;
+}
+
+// ============================================================================
+// BATCH
+// ============================================================================
+
+static void challenge_reply(Conn* c, const AuthIssueRequest* issue, int binary) {
+    if (binary) {
+        uint8_t frame[AUTH_WIRE_CHALLENGE_SIZE(CHALLENGE_LENGTH)];
+        size_t size = auth_wire_encode_challenge(issue->challenge, issue->challenge_length,
+                                                 frame, sizeof(frame));
+        reply(c, 200, AUTH_WIRE_CONTENT_TYPE, frame, size);
+        return;
+    }
+    // %.9g round-trips a float exactly
+    char body[64 + 18 * CHALLENGE_LENGTH];
+    int n = snprintf(body, sizeof(body), "{\"challenge_id\":%u,\"length\":%d,\"perturbations\":[",
+                     issue->challenge_id, issue->challenge_length);
+    for (int i = 0; i < issue->challenge_length; i++) {
+        n += snprintf(body + n, sizeof(body) - (size_t)n, "%s%.9g", i ? "," : "",
+                      issue->challenge[i]);
+    }
+    n += snprintf(body + n, sizeof(body) - (size_t)n, "]}");
+    reply(c, 200, "application/json", body, (size_t)n);
+}
+
+static int status_code(AuthVerifyStatus status) {
+    switch (status) {
+    case AUTH_VERIFY_OK: return 200;
+    case AUTH_VERIFY_UNKNOWN_DEVICE: return 404;
+    case AUTH_VERIFY_BUSY: return 429;
+    default: return 403;
+    }
+}
+
+static void record_latency(Server* s, const Request* r, uint64_t done_ns) {
+    uint64_t ns = done_ns - r->received_ns;
+    if (r->kind == REQ_CHALLENGE) {
+        auth_histogram_record(&s->challenge_latency, ns);
+        if (s->statsd_fd >= 0) auth_histogram_record(&s->challenge_interval, ns);
+    } else {
+        auth_histogram_record(&s->verify_latency, ns);
+        if (s->statsd_fd >= 0) auth_histogram_record(&s->verify_interval, ns);
+    }
+}
+
+static void metrics_reply(Server* s, Conn* c) {
+    static char body[METRICS_SIZE];
+    size_t n = auth_histogram_prometheus(&s->challenge_latency, NULL, body, sizeof(body));
+    if (n < sizeof(body)) {
+        n += auth_histogram_prometheus(&s->verify_latency, NULL, body + n, sizeof(body) - n);
+    }
+    AuthVerifierStats st = auth_verifier_stats(s->verifier);
+    const struct {
+        const char* name;
+        const char* help;
+        uint64_t value;
+    } counters[] = {
+        {"auth_server_issued_total", "Challenges issued", st.issued},
+        {"auth_server_verified_total", "Responses accepted", st.verified},
+        {"auth_server_rejected_total", "Responses rejected", st.rejected},
+        {"auth_server_expired_total", "Challenges expired unanswered", st.expired},
+        {"auth_server_evicted_total", "Idle devices dropped from tracking", st.evicted},
+        {"auth_server_precomputed_total", "Challenges issued from a precompute ring",
+         st.ring_hits},
+    };
+    for (size_t i = 0; i < sizeof(counters) / sizeof(counters[0]) && n < sizeof(body); i++) {
+        int w = snprintf(body + n, sizeof(body) - n, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+                         counters[i].name, counters[i].help, counters[i].name, counters[i].name,
+                         (unsigned long long)counters[i].value);
+        n += w > 0 ? (size_t)w : 0;
+    }
+    if (n < sizeof(body)) {
+        int w = snprintf(body + n, sizeof(body) - n,
+                         "# HELP auth_server_pending Challenges awaiting a response\n"
+                         "# TYPE auth_server_pending gauge\nauth_server_pending %d\n",
+                         st.pending);
+        n += w > 0 ? (size_t)w : 0;
+    }
+    if (n >= sizeof(body)) n = sizeof(body) - 1;
+    reply(c, 200, "text/plain; version=0.0.4", body, n);
+}
+
+// Latency since the last push, as StatsD gauges; the interval restarts
+static void statsd_push(Server* s) {
+    char payload[1024];
+    size_t n = auth_histogram_statsd(&s->challenge_interval, NULL, payload, sizeof(payload));
+    if (n < sizeof(payload)) {
+        n += auth_histogram_statsd(&s->verify_interval, NULL, payload + n, sizeof(payload) - n);
+    }
+    if (n < sizeof(payload)) auth_telemetry_statsd_push(s->statsd_fd, payload, n);
+    auth_histogram_reset(&s->challenge_interval);
+    auth_histogram_reset(&s->verify_interval);
+}
+
+// Run the verifier over everything parsed so far and queue the replies in
+// request order
+static void flush_batch(Server* s) {
+    if (s->n_requests == 0) return;
+    uint32_t now = now_sec();
+    if (s->n_issues) auth_verifier_issue(s->verifier, s->issues, s->n_issues, now);
+    if (s->n_checks) auth_verifier_check(s->verifier, s->checks, s->n_checks, now);
+    uint64_t done_ns = auth_telemetry_now_ns();
+
+    for (int i = 0; i < s->n_requests; i++) {
+        Request* r = &s->requests[i];
+        if (r->kind == REQ_CHALLENGE || r->kind == REQ_VERIFY) record_latency(s, r, done_ns);
+        if (r->conn->dead) continue;
+        if (r->kind == REQ_ERROR) {
+            reply_status(r->conn, r->http_status, r->http_status == 404 ? "NOT_FOUND"
+                                                : r->http_status == 413 ? "PAYLOAD_TOO_LARGE"
+                                                : "BAD_REQUEST");
+        } else if (r->kind == REQ_CHALLENGE) {
+            const AuthIssueRequest* issue = &s->issues[r->index];
+            if (issue->status == AUTH_VERIFY_OK) challenge_reply(r->conn, issue, r->binary);
+            else reply_status(r->conn, status_code(issue->status),
+                              auth_verify_status_name(issue->status));
+        } else if (r->kind == REQ_VERIFY) {
+            AuthVerifyStatus st = s->checks[r->index].status;
+            reply_status(r->conn, status_code(st), auth_verify_status_name(st));
+        } else {
+            metrics_reply(s, r->conn);
+        }
+    }
+    // Each connection once, however many requests it had in the batch
+    for (int i = 0; i < s->n_requests; i++) {
+        Conn* c = s->requests[i].conn;
+        if (!c->batched) continue;
+        c->batched = 0;
+        conn_flush(s, c);
+    }
+    s->n_requests = s->n_issues = s->n_checks = 0;
+}
+
+// ============================================================================
+// HTTP PARSING
+// ============================================================================
+
+static int valid_id(const char* id, size_t n) {
+    if (n == 0 || n > AUTH_VERIFIER_MAX_ID) return 0;
+    for (size_t i = 0; i < n; i++) {
+        char ch = id[i];
+        if (!((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+              ch == '-' || ch == '_' || ch == '.')) return 0;
+    }
+    return 1;
+}
+
+// Value of header name (e.g. "content-length:") within the header block
+static const char* header_value(const char* head, size_t size, const char* name, size_t* len) {
+    size_t name_len = strlen(name);
+    const char* end = head + size;
+    for (const char* line = head; line < end;) {
+        const char* eol = memmem(line, (size_t)(end - line), "\r\n", 2);
+        if (!eol) eol = end;
+        if ((size_t)(eol - line) >= name_len && strncasecmp(line, name, name_len) == 0) {
+            const char* v = line + name_len;
+            while (v < eol && *v == ' ') v++;
+            *len = (size_t)(eol - v);
+            return v;
+        }
+        line = eol + 2;
+    }
+    return NULL;
+}
+
+// Start of the value of "key" in a NUL-terminated JSON body, or NULL
+static const char* json_value(const char* body, const char* key) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char* v = strstr(body, pattern);
+    if (!v) return NULL;
+    v += strlen(pattern);
+    while (*v == ' ') v++;
+    if (*v++ != ':') return NULL;
+    while (*v == ' ') v++;
+    return v;
+}
+
+static int json_string(const char* body, const char* key, char* out, size_t cap) {
+    const char* v = json_value(body, key);
+    if (!v || *v++ != '"') return 0;
+    const char* end = strchr(v, '"');
+    if (!end || (size_t)(end - v) >= cap) return 0;
+    memcpy(out, v, (size_t)(end - v));
+    out[end - v] = '\0';
+    return 1;
+}
+
+static int json_float(const char* body, const char* key, float* out) {
+    const char* v = json_value(body, key);
+    if (!v) return 0;
+    char* end;
+    *out = strtof(v, &end);
+    return end != v;
+}
+
+static void parse_verify(Request* r, AuthCheckRequest* check, const char* body, size_t size,
+                         int binary, int quantized) {
+    char text[MAX_BODY + 1];
+    check->quantized = quantized;
+    if (quantized) {
+        if (!auth_wire_decode_response_i16((const uint8_t*)body, size, &check->response_i16,
+                                           r->device, sizeof(r->device))) return;
+    } else if (binary) {
+        if (!auth_wire_decode_response((const uint8_t*)body, size, &check->response, r->device,
+                                       sizeof(r->device))) return;
+        check->channels = 8;
+    } else {
+        memcpy(text, body, size);
+        text[size] = '\0';
+        memset(&check->response, 0, sizeof(check->response));
+        if (!json_string(text, "device_id", r->device, sizeof(r->device)) ||
+            !json_float(text, "psi", &check->response.psi) ||
+            !json_float(text, "i", &check->response.i_val) ||
+            !json_float(text, "r", &check->response.r_val) ||
+            !json_float(text, "phi", &check->response.phi_avg)) return;
+        check->channels = 4;
+    }
+    if (!valid_id(r->device, strlen(r->device))) return;
+    check->device_id = r->device;
+    r->kind = REQ_VERIFY;
+}
+
+// The caller makes sure the batch has room
+static Request* add_request(Server* s, Conn* c, uint64_t received_ns) {
+    Request* r = &s->requests[s->n_requests++];
+    memset(r, 0, sizeof(*r));
+    r->conn = c;
+    r->received_ns = received_ns;
+    r->kind = REQ_ERROR;
+    r->http_status = 400;
+    c->batched = 1;
+    return r;
+}
+
+// Parse complete requests out of c->in into the batch. Something
+// unrecoverable is answered in order, then the connection closes. Returns
+// 1 if it stopped on a full batch: flush it, then call again for the rest.
+static int parse_requests(Server* s, Conn* c) {
+    uint64_t received_ns = auth_telemetry_now_ns();
+    size_t pos = 0;
+    int full = 0;
+    while (pos < c->in_len) {
+        if (s->n_requests == MAX_BATCH) {
+            full = 1;
+            break;
+        }
+        char* start = c->in + pos;
+        size_t avail = c->in_len - pos;
+        char* head_end = memmem(start, avail, "\r\n\r\n", 4);
+        if (!head_end) break;
+        size_t head_size = (size_t)(head_end - start) + 2;
+
+        size_t body_size = 0, len;
+        const char* v = header_value(start, head_size, "content-length:", &len);
+        if (v) body_size = strtoul(v, NULL, 10);
+        size_t total = head_size + 2 + body_size;
+        if (body_size > MAX_BODY) {
+            add_request(s, c, received_ns)->http_status = 413;
+            c->closing = 1;
+            return 0;
+        }
+        if (total > avail) break;
+
+        Request* r = add_request(s, c, received_ns);
+
+        size_t accept_len;
+        const char* ctype = header_value(start, head_size, "content-type:", &len);
+        const char* accept = header_value(start, head_size, "accept:", &accept_len);
+        const char* body = start + head_size + 2;
+        if (strncmp(start, "GET /challenge?", 15) == 0) {
+            const char* id = memmem(start, head_size, "device=", 7);
+            const char* eol = memchr(start, '\r', head_size);
+            if (id && id < eol) {
+                id += 7;
+                size_t n = strcspn(id, "& \r");
+                if (valid_id(id, n)) {
+                    memcpy(r->device, id, n);
+                    AuthIssueRequest* issue = &s->issues[s->n_issues];
+                    issue->device_id = r->device;
+                    r->index = s->n_issues++;
+                    r->kind = REQ_CHALLENGE;
+                    r->binary = accept && memmem(accept, accept_len, AUTH_WIRE_CONTENT_TYPE,
+                                                 strlen(AUTH_WIRE_CONTENT_TYPE)) != NULL;
+                }
+            }
+        } else if (strncmp(start, "GET /metrics ", 13) == 0) {
+            r->kind = REQ_METRICS;
+        } else if (strncmp(start, "POST /verify ", 13) == 0) {
+            // AUTH_WIRE_CONTENT_TYPE is a prefix of the quantized type
+            int quantized = ctype && strncmp(ctype, AUTH_WIRE_CONTENT_TYPE_I16,
+                                             strlen(AUTH_WIRE_CONTENT_TYPE_I16)) == 0;
+            int binary = ctype && strncmp(ctype, AUTH_WIRE_CONTENT_TYPE,
+                                          strlen(AUTH_WIRE_CONTENT_TYPE)) == 0;
+            AuthCheckRequest* check = &s->checks[s->n_checks];
+            parse_verify(r, check, body, body_size, binary, quantized);
+            if (r->kind == REQ_VERIFY) r->index = s->n_checks++;
+            r->binary = binary;
+        } else {
+            r->http_status = 404;
+        }
+        pos += total;
+    }
+    if (!full && pos == 0 && c->in_len == CONN_IN) {
+        add_request(s, c, received_ns);   // headers never ended: 400
+        c->closing = 1;
+        return 0;
+    }
+    memmove(c->in, c->in + pos, c->in_len - pos);
+    c->in_len -= pos;
+    return full;
+}
+
+// ============================================================================
+// EVENT LOOP
+// ============================================================================
+
+static int listen_on(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons((uint16_t)port),
+                               .sin_addr.s_addr = htonl(INADDR_ANY)};
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, 1024) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void accept_all(Server* s, int listen_fd) {
+    for (;;) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0) return;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        Conn* c = calloc(1, sizeof(Conn));
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->events = EPOLLIN;
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = c};
+        if (epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            free(c);
+        }
+    }
+}
+
+// Returns the number of devices loaded, -1 if the store was left unchanged
+static long load_devices(AuthStore* store, const char* path) {
+    AuthStoreLoadReport report;
+    if (!auth_store_load(store, path, &report)) {
+        if (report.collision_line) {
+            fprintf(stderr, "%s:%llu: device id hash collides with an earlier one\n", path,
+                    (unsigned long long)report.collision_line);
+        } else {
+            perror(path);
+        }
+        return -1;
+    }
+    if (report.skipped) {
+        fprintf(stderr, "%s: %llu lines skipped (unknown profile or id over %d bytes)\n", path,
+                (unsigned long long)report.skipped, AUTH_STORE_MAX_ID);
+    }
+    return (long)report.devices;
+}
+
+// SIGHUP: reload the devices file off the event loop
+typedef struct {
+    AuthStore* store;
+    const char* path;
+    pthread_t thread;
+    atomic_int running;
+    int started;
+} Reloader;
+
+static void* reload_main(void* arg) {
+    Reloader* r = arg;
+    long devices = load_devices(r->store, r->path);
+    if (devices >= 0) printf("auth_server: reloaded %s, %ld devices\n", r->path, devices);
+    else fprintf(stderr, "auth_server: reload failed, keeping the current devices\n");
+    fflush(stdout);
+    atomic_store(&r->running, 0);
+    return NULL;
+}
+
+static void reload_start(Reloader* r) {
+    if (atomic_load(&r->running)) return;   // the running reload reads the new file anyway
+    if (r->started) pthread_join(r->thread, NULL);
+    atomic_store(&r->running, 1);
+    r->started = pthread_create(&r->thread, NULL, reload_main, r) == 0;
+    if (!r->started) atomic_store(&r->running, 0);
+}
+
+#define USAGE "Usage: %s [-p port] [-d devices.txt] [-t timeout] [-w workers] [-r depth]" \
+              " [-s statsd_host:port]\n"
+
+int main(int argc, char** argv) {
+    int port = DEFAULT_PORT, timeout = 30, workers = 1, ring_depth = 2;
+    const char* devices_path = NULL;
+    const char* statsd = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-p") == 0) port = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-d") == 0) devices_path = argv[i + 1];
+        else if (strcmp(argv[i], "-t") == 0) timeout = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-w") == 0) workers = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-r") == 0) ring_depth = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-s") == 0) statsd = argv[i + 1];
+        else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 1;
+        }
+    }
+    if (argc % 2 == 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 1;
+    }
+
+    auth_init();
+    uint64_t seed;
+    if (getrandom(&seed, sizeof(seed), 0) != sizeof(seed)) {
+        seed = (uint64_t)time(NULL) ^ ((uint64_t)getpid() << 32);
+    }
+    AuthPool* pool = workers > 1 ? auth_pool_create(workers, 1) : NULL;
+    AuthVerifier* verifier = auth_verifier_create(MAX_DEVICES, MAX_PENDING, timeout,
+                                                  AUTH_ENGINE_REV_1, pool, seed);
+    if (!verifier) {
+        fprintf(stderr, "Invalid timeout %d (1..%d)\n", timeout, AUTH_VERIFIER_WHEEL_SLOTS - 1);
+        return 1;
+    }
+    AuthStore* store = auth_store_create(seed ^ 0x2545f4914f6cdd1dull);
+    if (!store || !auth_verifier_attach_store(verifier, store)) {
+        fprintf(stderr, "Cannot create the device store\n");
+        return 1;
+    }
+    long devices = 1;
+    if (devices_path) {
+        devices = load_devices(store, devices_path);
+        if (devices < 0) return 1;
+    } else {
+        AuthSecret demo = {2.5f, 0.8f, 12345};   // client.c's default secret
+        auth_store_put_ex(store, "rpi-001", &demo, NULL, AUTH_STORE_QUANTIZED);
+    }
+    Reloader reloader = {.store = store, .path = devices_path};
+    atomic_init(&reloader.running, 0);
+    if (ring_depth > 0 && !auth_verifier_start_refill(verifier, ring_depth)) {
+        fprintf(stderr, "Cannot start challenge precompute (depth %d)\n", ring_depth);
+        return 1;
+    }
+
+    int listen_fd = listen_on(port);
+    if (listen_fd < 0) {
+        perror("listen");
+        return 1;
+    }
+    static Server server;
+    Server* s = &server;
+    s->verifier = verifier;
+    s->statsd_fd = -1;
+    if (statsd && (s->statsd_fd = auth_telemetry_statsd_open(statsd)) < 0) {
+        fprintf(stderr, "Cannot resolve StatsD address %s\n", statsd);
+        return 1;
+    }
+    auth_histogram_init(&s->challenge_latency, "auth_server_challenge_seconds",
+                        "GET /challenge latency, arrival to reply");
+    auth_histogram_init(&s->verify_latency, "auth_server_verify_seconds",
+                        "POST /verify latency, arrival to reply");
+    auth_histogram_init(&s->challenge_interval, s->challenge_latency.name, NULL);
+    auth_histogram_init(&s->verify_interval, s->verify_latency.name, NULL);
+    uint32_t next_push = now_sec() + STATSD_INTERVAL;
+    s->epoll_fd = epoll_create1(0);
+    struct epoll_event lev = {.events = EPOLLIN, .data.ptr = NULL};
+    epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, listen_fd, &lev);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGHUP, on_reload);
+    printf("auth_server: port %d, %ld devices, %ds challenges, %d worker%s, %d precomputed\n",
+           port, devices, timeout, workers, workers == 1 ? "" : "s", ring_depth);
+
+    struct epoll_event events[MAX_EVENTS];
+    while (!stop) {
+        // Wake at least once a second so expiry runs while idle
+        int n = epoll_wait(s->epoll_fd, events, MAX_EVENTS, 1000);
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n; i++) {
+            Conn* c = events[i].data.ptr;
+            if (!c) {
+                accept_all(s, listen_fd);
+                continue;
+            }
+            if (c->dead) continue;   // closed earlier in this pass
+            if ((events[i].events & EPOLLOUT) && !c->batched) {
+                if (!conn_flush(s, c)) continue;
+            }
+            if (!(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) || c->closing) continue;
+            ssize_t got = recv(c->fd, c->in + c->in_len, CONN_IN - c->in_len, 0);
+            if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+            if (got > 0) c->in_len += (size_t)got;
+            while (parse_requests(s, c)) {
+                flush_batch(s);   // batch full: answer it, then parse the rest
+                if (c->dead) break;
+            }
+            if (c->dead) continue;
+            if (got <= 0) c->closing = 1;   // peer closed: answer what it sent, then close
+            // In the batch: flushed (and closed if closing) by flush_batch
+            if (!c->batched) conn_flush(s, c);
+        }
+        flush_batch(s);
+        reap_conns(s);
+        auth_verifier_expire(verifier, now_sec());
+        if (s->statsd_fd >= 0 && now_sec() >= next_push) {
+            statsd_push(s);
+            next_push = now_sec() + STATSD_INTERVAL;
+        }
+        if (reload_requested) {
+            reload_requested = 0;
+            if (devices_path) reload_start(&reloader);
+        }
+    }
+
+    AuthVerifierStats st = auth_verifier_stats(verifier);
+    printf("\nauth_server: %llu issued, %llu verified, %llu rejected, %llu expired\n",
+           (unsigned long long)st.issued, (unsigned long long)st.verified,
+           (unsigned long long)st.rejected, (unsigned long long)st.expired);
+    printf("auth_server: %llu issued precomputed, %llu inline\n",
+           (unsigned long long)st.ring_hits, (unsigned long long)st.ring_misses);
+    printf("auth_server: verify p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+           auth_histogram_quantile(&s->verify_latency, 0.5) / 1e6,
+           auth_histogram_quantile(&s->verify_latency, 0.99) / 1e6,
+           auth_histogram_quantile(&s->verify_latency, 1.0) / 1e6);
+    if (reloader.started) pthread_join(reloader.thread, NULL);
+    auth_verifier_destroy(verifier);
+    auth_store_destroy(store);
+    if (pool) auth_pool_destroy(pool);
+    if (s->statsd_fd >= 0) close(s->statsd_fd);
+    close(listen_fd);
+    return 0;
+}
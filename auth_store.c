@@ -0,0 +1,596 @@
+// auth_store.c
+// Sharded device secret store (see auth_store.h)
+
+#include "auth_store.h"
+#include "auth_util.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define CACHE_LINE 64
+#define BUCKET_SLOTS 3
+#define MIN_BUCKETS 16
+#define SHARD_BITS 6
+#define LOAD_NUM 2               // slots in use at most LOAD_NUM / LOAD_DEN: at 2/3 a lookup
+#define LOAD_DEN 3               // reads ~1.25 buckets (4/5: ~1.55), at ~32 bytes per device
+#define LOOKUP_GROUP 32          // get_many: lookups prefetched ahead together
+
+_Static_assert(AUTH_STORE_SHARDS == 1 << SHARD_BITS, "SHARD_BITS must match the shard count");
+
+#define ENTRY_QUANTIZED 0x80     // profile byte: AUTH_STORE_QUANTIZED
+#define ENTRY_PRESET 0x7f
+
+// Slots fill in order and are never emptied, so a lookup that meets an
+// empty slot can stop there
+typedef struct {
+    _Atomic uint64_t hash[BUCKET_SLOTS];   // 0 = empty
+    AuthSecret secret[BUCKET_SLOTS];
+    uint8_t profile[BUCKET_SLOTS];         // AuthProfilePreset | ENTRY_QUANTIZED
+    uint8_t unused;
+} StoreBucket;
+
+_Static_assert(sizeof(StoreBucket) == CACHE_LINE, "a bucket is one cache line");
+
+typedef struct {
+    StoreBucket* buckets;
+    uint32_t* check;         // while building: second hash of each slot's id
+    uint64_t n_buckets;      // any count: the home bucket is a multiply-shift of the hash
+    uint64_t count;
+} StoreTable;
+
+typedef struct {
+    _Alignas(CACHE_LINE) _Atomic(StoreTable*) table;
+    atomic_uint seq;         // seqlock: odd while a secret is replaced in place
+    pthread_mutex_t lock;    // writers
+} StoreShard;
+
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_uint_fast64_t epoch;   // store epoch at lookup start, 0 = idle
+    atomic_int joined;
+} StoreReader;
+
+struct AuthStore {
+    StoreShard shards[AUTH_STORE_SHARDS];
+    StoreReader readers[AUTH_STORE_MAX_READERS];
+    _Alignas(CACHE_LINE) atomic_uint_fast64_t epoch;
+    uint64_t key;
+    pthread_mutex_t replace_lock;   // one load/replace at a time
+    atomic_uint_fast64_t reloads;
+    atomic_uint_fast64_t grows;
+};
+
+// ============================================================================
+// ID HASHES
+// ============================================================================
+
+// Keyed: 8 id bytes at a time through a bijective mix
+static uint64_t id_hash(uint64_t key, const char* id, size_t len) {
+    uint64_t h = auth_mix64(key ^ ((uint64_t)len * 0x9e3779b97f4a7c15ull));
+    for (size_t i = 0; i < len; i += 8) {
+        uint64_t w = 0;
+        for (size_t b = 0; b < 8 && i + b < len; b++) {
+            w |= (uint64_t)(uint8_t)id[i + b] << (8 * b);
+        }
+        h = auth_mix64(h ^ w);
+    }
+    return h ? h : 1;   // never the empty marker
+}
+
+// Independent of id_hash: tells a repeated id from a collision while building
+static uint32_t id_check(const char* id) {
+    uint32_t h = 0x811c9dc5u;   // FNV-1a
+    for (; *id; id++) h = (h ^ (uint8_t)*id) * 0x01000193u;
+    return h;
+}
+
+static StoreShard* shard_of(AuthStore* store, uint64_t hash) {
+    return &store->shards[hash >> (64 - SHARD_BITS)];
+}
+
+static int preset_of(const AuthProfile* profile) {
+    if (!profile) return AUTH_PROFILE_DEFAULT;
+    for (int p = 0; p < AUTH_PROFILE_PRESETS; p++) {
+        if (profile == &auth_profile_presets[p]) return p;
+    }
+    return -1;
+}
+
+// The profile byte of an entry, -1 for a profile that is not a preset
+static int entry_of(const AuthProfile* profile, unsigned flags) {
+    int preset = preset_of(profile);
+    if (preset < 0) return -1;
+    return preset | (flags & AUTH_STORE_QUANTIZED ? ENTRY_QUANTIZED : 0);
+}
+
+// ============================================================================
+// TABLES
+// ============================================================================
+
+static StoreTable* table_create(uint64_t buckets, int building) {
+    StoreTable* t = calloc(1, sizeof(StoreTable));
+    if (!t) return NULL;
+    t->buckets = aligned_alloc(CACHE_LINE, buckets * sizeof(StoreBucket));
+    t->check = building ? calloc(buckets * BUCKET_SLOTS, sizeof(uint32_t)) : NULL;
+    if (!t->buckets || (building && !t->check)) {
+        free(t->buckets);
+        free(t->check);
+        free(t);
+        return NULL;
+    }
+    memset(t->buckets, 0, buckets * sizeof(StoreBucket));
+    t->n_buckets = buckets;
+    return t;
+}
+
+static void table_free(StoreTable* t) {
+    if (!t) return;
+    free(t->buckets);
+    free(t->check);
+    free(t);
+}
+
+static uint64_t table_limit(const StoreTable* t) {
+    return t->n_buckets * BUCKET_SLOTS * LOAD_NUM / LOAD_DEN;
+}
+
+static uint64_t buckets_for(uint64_t devices) {
+    uint64_t buckets = (devices * LOAD_DEN + BUCKET_SLOTS * LOAD_NUM - 1) /
+                       (BUCKET_SLOTS * LOAD_NUM);
+    return buckets < MIN_BUCKETS ? MIN_BUCKETS : buckets;
+}
+
+// Low 32 hash bits scaled to [0, n_buckets); the shard took the top bits
+static uint64_t home_bucket(const StoreTable* t, uint64_t hash) {
+    return ((hash & 0xffffffffull) * t->n_buckets) >> 32;
+}
+
+// Slot (bucket * BUCKET_SLOTS + i) holding hash, or the empty slot it
+// would be added at
+static uint64_t table_find(const StoreTable* t, uint64_t hash, int* found) {
+    for (uint64_t b = home_bucket(t, hash);; b = b + 1 == t->n_buckets ? 0 : b + 1) {
+        const StoreBucket* bucket = &t->buckets[b];
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            uint64_t h = atomic_load_explicit(&bucket->hash[i], memory_order_acquire);
+            if (h == hash || h == 0) {
+                *found = h != 0;
+                return b * BUCKET_SLOTS + (uint64_t)i;
+            }
+        }
+    }
+}
+
+// Fill an empty slot; the hash goes last, so a concurrent lookup that
+// sees it also sees the secret
+static void slot_fill(StoreTable* t, uint64_t slot, uint64_t hash, const AuthSecret* secret,
+                      int entry) {
+    StoreBucket* bucket = &t->buckets[slot / BUCKET_SLOTS];
+    int i = (int)(slot % BUCKET_SLOTS);
+    bucket->secret[i] = *secret;
+    bucket->profile[i] = (uint8_t)entry;
+    atomic_store_explicit(&bucket->hash[i], hash, memory_order_release);
+    t->count++;
+}
+
+// Copy of t with buckets buckets (caller holds the shard lock)
+static StoreTable* table_rehash(const StoreTable* t, uint64_t buckets) {
+    StoreTable* bigger = table_create(buckets, t->check != NULL);
+    if (!bigger) return NULL;
+    for (uint64_t b = 0; b < t->n_buckets; b++) {
+        const StoreBucket* bucket = &t->buckets[b];
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            uint64_t h = atomic_load_explicit(&bucket->hash[i], memory_order_relaxed);
+            if (h == 0) break;
+            int found;
+            uint64_t slot = table_find(bigger, h, &found);
+            slot_fill(bigger, slot, h, &bucket->secret[i], bucket->profile[i]);
+            if (t->check) bigger->check[slot] = t->check[b * BUCKET_SLOTS + (uint64_t)i];
+        }
+    }
+    return bigger;
+}
+
+// ============================================================================
+// READERS AND GRACE PERIODS
+// ============================================================================
+// A lookup publishes the store epoch it started in. A writer that
+// unlinked a table bumps the epoch and waits until every reader is idle
+// or started after the bump; from then on nobody can hold the old table.
+
+int auth_store_reader_join(AuthStore* store) {
+    for (int r = 0; r < AUTH_STORE_MAX_READERS; r++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&store->readers[r].joined, &expected, 1)) return r;
+    }
+    return -1;
+}
+
+void auth_store_reader_leave(AuthStore* store, int reader) {
+    atomic_store_explicit(&store->readers[reader].epoch, 0, memory_order_release);
+    atomic_store_explicit(&store->readers[reader].joined, 0, memory_order_release);
+}
+
+static void read_begin(AuthStore* store, int reader) {
+    atomic_store(&store->readers[reader].epoch, atomic_load(&store->epoch));
+}
+
+static void read_end(AuthStore* store, int reader) {
+    atomic_store_explicit(&store->readers[reader].epoch, 0, memory_order_release);
+}
+
+static void synchronize(AuthStore* store) {
+    uint64_t epoch = atomic_fetch_add(&store->epoch, 1) + 1;
+    for (int r = 0; r < AUTH_STORE_MAX_READERS; r++) {
+        for (;;) {
+            uint64_t seen = atomic_load(&store->readers[r].epoch);
+            if (seen == 0 || seen >= epoch) break;
+            sched_yield();
+        }
+    }
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+AuthStore* auth_store_create(uint64_t hash_key) {
+    size_t size = (sizeof(AuthStore) + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1);
+    AuthStore* store = aligned_alloc(CACHE_LINE, size);
+    if (!store) return NULL;
+    memset(store, 0, sizeof(AuthStore));
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) {
+        StoreTable* t = table_create(MIN_BUCKETS, 0);
+        if (!t) {
+            for (int j = 0; j < s; j++) table_free(atomic_load(&store->shards[j].table));
+            free(store);
+            return NULL;
+        }
+        atomic_init(&store->shards[s].table, t);
+        atomic_init(&store->shards[s].seq, 0);
+        pthread_mutex_init(&store->shards[s].lock, NULL);
+    }
+    for (int r = 0; r < AUTH_STORE_MAX_READERS; r++) {
+        atomic_init(&store->readers[r].epoch, 0);
+        atomic_init(&store->readers[r].joined, 0);
+    }
+    atomic_init(&store->epoch, 1);
+    atomic_init(&store->reloads, 0);
+    atomic_init(&store->grows, 0);
+    store->key = hash_key;
+    pthread_mutex_init(&store->replace_lock, NULL);
+    return store;
+}
+
+void auth_store_destroy(AuthStore* store) {
+    if (!store) return;
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) {
+        table_free(atomic_load(&store->shards[s].table));
+        pthread_mutex_destroy(&store->shards[s].lock);
+    }
+    pthread_mutex_destroy(&store->replace_lock);
+    free(store);
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+// Within read_begin/read_end
+// Returns 0 or AUTH_STORE_FOUND with the entry's flags
+static int shard_lookup(StoreShard* shard, uint64_t hash, AuthSecret* secret,
+                        const AuthProfile** profile) {
+    for (;;) {
+        unsigned seq = atomic_load_explicit(&shard->seq, memory_order_acquire);
+        if (seq & 1) continue;   // a put is mid-write: a handful of stores
+        const StoreTable* t = atomic_load_explicit(&shard->table, memory_order_acquire);
+        int found;
+        uint64_t slot = table_find(t, hash, &found);
+        AuthSecret s = {0};
+        uint8_t entry = AUTH_PROFILE_DEFAULT;
+        if (found) {
+            const StoreBucket* bucket = &t->buckets[slot / BUCKET_SLOTS];
+            memcpy(&s, &bucket->secret[slot % BUCKET_SLOTS], sizeof(s));
+            entry = bucket->profile[slot % BUCKET_SLOTS];
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&shard->seq, memory_order_relaxed) != seq) continue;
+        if (!found) return 0;
+        if (secret) *secret = s;
+        if (profile) *profile = &auth_profile_presets[entry & ENTRY_PRESET];
+        return AUTH_STORE_FOUND | (entry & ENTRY_QUANTIZED ? AUTH_STORE_QUANTIZED : 0);
+    }
+}
+
+int auth_store_get(AuthStore* store, int reader, const char* device_id, AuthSecret* secret,
+                   const AuthProfile** profile) {
+    size_t len = strlen(device_id);
+    if (len > AUTH_STORE_MAX_ID) return 0;
+    uint64_t hash = id_hash(store->key, device_id, len);
+    read_begin(store, reader);
+    int found = shard_lookup(shard_of(store, hash), hash, secret, profile);
+    read_end(store, reader);
+    return found;
+}
+
+int auth_store_get_many(AuthStore* store, int reader, const char* const* device_ids,
+                        int count, AuthSecret* secrets, const AuthProfile** profiles,
+                        unsigned char* found) {
+    uint64_t hashes[LOOKUP_GROUP];
+    int total = 0;
+    read_begin(store, reader);
+    for (int base = 0; base < count; base += LOOKUP_GROUP) {
+        int n = count - base < LOOKUP_GROUP ? count - base : LOOKUP_GROUP;
+        // Hash and prefetch every home bucket first, so the misses overlap
+        for (int i = 0; i < n; i++) {
+            size_t len = strlen(device_ids[base + i]);
+            hashes[i] = len > AUTH_STORE_MAX_ID ? 0
+                                                : id_hash(store->key, device_ids[base + i], len);
+            if (!hashes[i]) continue;
+            const StoreTable* t = atomic_load_explicit(&shard_of(store, hashes[i])->table,
+                                                       memory_order_acquire);
+            __builtin_prefetch(&t->buckets[home_bucket(t, hashes[i])]);
+        }
+        for (int i = 0; i < n; i++) {
+            int j = base + i;
+            found[j] = hashes[i] ? (unsigned char)shard_lookup(shard_of(store, hashes[i]),
+                                                               hashes[i], &secrets[j],
+                                                               &profiles[j])
+                                 : 0;
+            total += found[j] != 0;
+        }
+    }
+    read_end(store, reader);
+    return total;
+}
+
+// ============================================================================
+// UPDATES
+// ============================================================================
+
+int auth_store_put(AuthStore* store, const char* device_id, const AuthSecret* secret,
+                   const AuthProfile* profile) {
+    return auth_store_put_ex(store, device_id, secret, profile, 0);
+}
+
+int auth_store_put_ex(AuthStore* store, const char* device_id, const AuthSecret* secret,
+                      const AuthProfile* profile, unsigned flags) {
+    size_t len = strlen(device_id);
+    int entry = entry_of(profile, flags);
+    if (len > AUTH_STORE_MAX_ID || entry < 0) return 0;
+    uint64_t hash = id_hash(store->key, device_id, len);
+    StoreShard* shard = shard_of(store, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    StoreTable* t = atomic_load_explicit(&shard->table, memory_order_relaxed);
+    int found;
+    uint64_t slot = table_find(t, hash, &found);
+    if (found) {
+        // In place: lookups retry around the write
+        StoreBucket* bucket = &t->buckets[slot / BUCKET_SLOTS];
+        atomic_fetch_add_explicit(&shard->seq, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        bucket->secret[slot % BUCKET_SLOTS] = *secret;
+        bucket->profile[slot % BUCKET_SLOTS] = (uint8_t)entry;
+        atomic_fetch_add_explicit(&shard->seq, 1, memory_order_release);
+    } else if (t->count < table_limit(t)) {
+        slot_fill(t, slot, hash, secret, entry);
+    } else {
+        // Full: a twice-as-large copy replaces the table, lookups carry on
+        // in the old one until the grace period ends
+        StoreTable* bigger = table_rehash(t, t->n_buckets * 2);
+        if (!bigger) {
+            pthread_mutex_unlock(&shard->lock);
+            return 0;
+        }
+        slot_fill(bigger, table_find(bigger, hash, &found), hash, secret, entry);
+        atomic_store_explicit(&shard->table, bigger, memory_order_release);
+        synchronize(store);
+        table_free(t);
+        atomic_fetch_add_explicit(&store->grows, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return 1;
+}
+
+// ============================================================================
+// RELOAD
+// ============================================================================
+
+typedef struct {
+    StoreTable* tables[AUTH_STORE_SHARDS];
+    uint64_t key;
+} StoreBuild;
+
+static int build_init(StoreBuild* b, uint64_t key, uint64_t expected) {
+    b->key = key;
+    uint64_t buckets = buckets_for(expected / AUTH_STORE_SHARDS + 1);
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) {
+        b->tables[s] = table_create(buckets, 1);
+        if (!b->tables[s]) return 0;
+    }
+    return 1;
+}
+
+static void build_free(StoreBuild* b) {
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) table_free(b->tables[s]);
+}
+
+// 1 added or replaced, 0 a hash collision, -1 out of memory
+static int build_add(StoreBuild* b, const char* id, size_t len, const AuthSecret* secret,
+                     int entry) {
+    uint64_t hash = id_hash(b->key, id, len);
+    uint32_t check = id_check(id);
+    int s = (int)(hash >> (64 - SHARD_BITS));
+    StoreTable* t = b->tables[s];
+    int found;
+    uint64_t slot = table_find(t, hash, &found);
+    if (found) {
+        if (t->check[slot] != check) return 0;
+        t->buckets[slot / BUCKET_SLOTS].secret[slot % BUCKET_SLOTS] = *secret;
+        t->buckets[slot / BUCKET_SLOTS].profile[slot % BUCKET_SLOTS] = (uint8_t)entry;
+        return 1;
+    }
+    if (t->count >= table_limit(t)) {
+        StoreTable* bigger = table_rehash(t, t->n_buckets * 2);
+        if (!bigger) return -1;
+        table_free(t);
+        b->tables[s] = t = bigger;
+        slot = table_find(t, hash, &found);
+    }
+    slot_fill(t, slot, hash, secret, entry);
+    t->check[slot] = check;
+    return 1;
+}
+
+// Shrink each built table to the smallest that holds its devices (the
+// size estimate or the doubling may have overshot), 0 if out of memory
+static int build_compact(StoreBuild* b) {
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) {
+        StoreTable* t = b->tables[s];
+        free(t->check);
+        t->check = NULL;
+        uint64_t buckets = buckets_for(t->count);
+        if (buckets >= t->n_buckets) continue;
+        StoreTable* exact = table_rehash(t, buckets);
+        if (!exact) return 0;
+        table_free(t);
+        b->tables[s] = exact;
+    }
+    return 1;
+}
+
+// Swap every shard's table for the built one, then free the old tables
+// after one grace period
+static void build_publish(AuthStore* store, StoreBuild* b) {
+    StoreTable* old[AUTH_STORE_SHARDS];
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) {
+        StoreShard* shard = &store->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        old[s] = atomic_exchange_explicit(&shard->table, b->tables[s], memory_order_acq_rel);
+        pthread_mutex_unlock(&shard->lock);
+        b->tables[s] = NULL;
+    }
+    synchronize(store);
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) table_free(old[s]);
+    atomic_fetch_add_explicit(&store->reloads, 1, memory_order_relaxed);
+}
+
+static void report_done(AuthStoreLoadReport* report, const StoreBuild* b, double start) {
+    report->devices = 0;
+    for (int s = 0; s < AUTH_STORE_SHARDS; s++) report->devices += b->tables[s]->count;
+    report->seconds = auth_now_seconds() - start;
+}
+
+int auth_store_replace(AuthStore* store, const char* const* device_ids,
+                       const AuthSecret* secrets, const AuthProfile* const* profiles,
+                       size_t count, AuthStoreLoadReport* report) {
+    AuthStoreLoadReport local;
+    if (!report) report = &local;
+    memset(report, 0, sizeof(*report));
+    double start = auth_now_seconds();
+
+    pthread_mutex_lock(&store->replace_lock);
+    StoreBuild b;
+    memset(&b, 0, sizeof(b));
+    int ok = build_init(&b, store->key, count);
+    for (size_t i = 0; ok && i < count; i++) {
+        report->lines++;
+        size_t len = strlen(device_ids[i]);
+        int entry = entry_of(profiles ? profiles[i] : NULL, 0);
+        if (len > AUTH_STORE_MAX_ID || entry < 0) {
+            report->skipped++;
+            continue;
+        }
+        int added = build_add(&b, device_ids[i], len, &secrets[i], entry);
+        if (added == 0) report->collision_line = i + 1;
+        ok = added > 0;
+    }
+    ok = ok && build_compact(&b);
+    if (ok) {
+        report_done(report, &b, start);
+        build_publish(store, &b);
+    }
+    build_free(&b);
+    pthread_mutex_unlock(&store->replace_lock);
+    return ok;
+}
+
+int auth_store_load(AuthStore* store, const char* path, AuthStoreLoadReport* report) {
+    AuthStoreLoadReport local;
+    if (!report) report = &local;
+    memset(report, 0, sizeof(*report));
+    double start = auth_now_seconds();
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    struct stat st;
+    uint64_t expected = fstat(fileno(f), &st) == 0 ? (uint64_t)st.st_size / 24 : 0;
+
+    pthread_mutex_lock(&store->replace_lock);
+    StoreBuild b;
+    memset(&b, 0, sizeof(b));
+    int ok = build_init(&b, store->key, expected);
+    // One device per line: id k gamma seed [profile [i16]]
+    char line[256], id[AUTH_STORE_MAX_ID + 1], profile_name[32], option[8];
+    AuthSecret secret;
+    while (ok && fgets(line, sizeof(line), f)) {
+        report->lines++;
+        if (!strchr(line, '\n') && !feof(f)) {
+            // Longer than any valid line: skip the rest of it too
+            int c;
+            while ((c = fgetc(f)) != EOF && c != '\n') {}
+            report->skipped++;
+            continue;
+        }
+        // Measure the id token itself: %63s would split a longer one and
+        // parse its tail as k
+        const char* token = line + strspn(line, " \t");
+        size_t len = strcspn(token, " \t\r\n");
+        if (len > AUTH_STORE_MAX_ID) {
+            report->skipped++;
+            continue;
+        }
+        int fields = sscanf(token, "%63s %f %f %u %31s %7s", id, &secret.k, &secret.gamma,
+                            &secret.seed, profile_name, option);
+        if (fields < 4) continue;
+        const AuthProfile* profile = fields >= 5 ? auth_profile_find(profile_name) : NULL;
+        int quantized = fields == 6 && strcmp(option, "i16") == 0;
+        if ((fields >= 5 && !profile) || (fields == 6 && !quantized)) {
+            report->skipped++;
+            continue;
+        }
+        int added = build_add(&b, id, len, &secret,
+                              entry_of(profile, quantized ? AUTH_STORE_QUANTIZED : 0));
+        if (added == 0) report->collision_line = report->lines;
+        ok = added > 0;
+    }
+    ok = ok && !ferror(f);
+    fclose(f);
+    ok = ok && build_compact(&b);
+    if (ok) {
+        report_done(report, &b, start);
+        build_publish(store, &b);
+    }
+    build_free(&b);
+    pthread_mutex_unlock(&store->replace_lock);
+    return ok;
+}
+
+AuthStoreStats auth_store_stats(AuthStore* store) {
+    AuthStoreStats s;
+    memset(&s, 0, sizeof(s));
+    for (int i = 0; i < AUTH_STORE_SHARDS; i++) {
+        StoreShard* shard = &store->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        const StoreTable* t = atomic_load_explicit(&shard->table, memory_order_relaxed);
+        s.devices += t->count;
+        s.bytes += t->n_buckets * sizeof(StoreBucket) + sizeof(StoreTable);
+        pthread_mutex_unlock(&shard->lock);
+    }
+    s.bytes += sizeof(AuthStore);
+    s.reloads = atomic_load_explicit(&store->reloads, memory_order_relaxed);
+    s.grows = atomic_load_explicit(&store->grows, memory_order_relaxed);
+    return s;
+}
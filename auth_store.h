@@ -0,0 +1,95 @@
+// auth_store.h
+// Sharded device secret store for the verifier
+//
+// The registry behind auth_server (device id -> secret, profile), sized
+// for millions of devices:
+//   - AUTH_STORE_SHARDS shards picked by the top bits of a keyed 64-bit
+//     hash of the id; ids themselves are not stored
+//   - each shard is an open-addressing table of 64-byte buckets, three
+//     (hash, AuthSecret, profile) entries per bucket, so a lookup usually
+//     reads one cache line; ~32 bytes per device
+//   - lookups never lock or wait: tables are swapped by pointer and old
+//     ones freed after an epoch grace period (RCU), an in-place secret
+//     change is covered by a per-shard seqlock
+//   - writers take the shard's lock; one growing (rehash) shard does not
+//     stall the others
+//   - reload builds complete new tables from a devices file while lookups
+//     continue on the old ones, then swaps them in shard by shard
+// Two ids are only told apart by their hash: load and replace detect a
+// collision (a second, independent hash of each id) and refuse the file;
+// auth_store_put() cannot, so it takes the odds (~2^-64 per pair).
+
+#ifndef AUTH_STORE_H
+#define AUTH_STORE_H
+
+#include <stddef.h>
+#include "physics_auth.h"
+
+#define AUTH_STORE_SHARDS 64
+#define AUTH_STORE_MAX_READERS 64     // threads joined at once
+#define AUTH_STORE_MAX_ID 63          // device id bytes
+
+// Lookup results and put flags
+#define AUTH_STORE_FOUND 1
+#define AUTH_STORE_QUANTIZED 2        // device may answer with AuthResponseI16
+
+typedef struct AuthStore AuthStore;
+
+typedef struct {
+    uint64_t devices;
+    uint64_t bytes;                   // tables, including empty slots
+    uint64_t reloads;                 // successful load/replace calls
+    uint64_t grows;                   // shard rehashes by auth_store_put()
+} AuthStoreStats;
+
+typedef struct {
+    uint64_t devices;                 // in the new contents
+    uint64_t lines;                   // lines read
+    uint64_t skipped;                 // unknown profile or option, id or line too long
+    uint64_t collision_line;          // line whose id hash collided, 0 if none
+    double seconds;
+} AuthStoreLoadReport;
+
+// hash_key seeds the id hash; take it from a system entropy source so ids
+// cannot be chosen to collide
+AuthStore* auth_store_create(uint64_t hash_key);
+void auth_store_destroy(AuthStore* store);   // no reader may be joined
+
+// Each thread that looks up joins once and passes its reader number;
+// -1 if AUTH_STORE_MAX_READERS are joined
+int auth_store_reader_join(AuthStore* store);
+void auth_store_reader_leave(AuthStore* store, int reader);
+
+// 0 if the device is unknown, else AUTH_STORE_FOUND with its flags.
+// profile points into auth_profile_presets.
+int auth_store_get(AuthStore* store, int reader, const char* device_id, AuthSecret* secret,
+                   const AuthProfile** profile);
+// count lookups at once, bucket reads overlapped by prefetching; found[i]
+// is what auth_store_get() returns. Returns the number found.
+int auth_store_get_many(AuthStore* store, int reader, const char* const* device_ids,
+                        int count, AuthSecret* secrets, const AuthProfile** profiles,
+                        unsigned char* found);
+
+// Add or replace one device (profile: a preset, NULL = default). 0 if the
+// id is too long, the profile not a preset, or out of memory.
+int auth_store_put(AuthStore* store, const char* device_id, const AuthSecret* secret,
+                   const AuthProfile* profile);
+// The same with flags (AUTH_STORE_QUANTIZED); put() passes none
+int auth_store_put_ex(AuthStore* store, const char* device_id, const AuthSecret* secret,
+                      const AuthProfile* profile, unsigned flags);
+
+// Replace the whole contents: with count devices (profiles may be NULL,
+// no flags), or with a devices file of "device_id k gamma seed [profile
+// [i16]]" lines, i16 setting AUTH_STORE_QUANTIZED (auth_server -d; a
+// repeated id keeps its last line). Lookups are served
+// from the old contents until each shard is swapped. The store is left
+// unchanged and 0 returned if the file cannot be read, an id hash
+// collides, or memory runs out. report may be NULL.
+int auth_store_replace(AuthStore* store, const char* const* device_ids,
+                       const AuthSecret* secrets, const AuthProfile* const* profiles,
+                       size_t count, AuthStoreLoadReport* report);
+int auth_store_load(AuthStore* store, const char* path, AuthStoreLoadReport* report);
+
+AuthStoreStats auth_store_stats(AuthStore* store);
+
+#endif // AUTH_STORE_H
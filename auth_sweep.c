@@ -0,0 +1,192 @@
+// auth_sweep.c
+// Parallel keyspace sweep for brute-force audits
+
+#include "auth_sweep.h"
+#include "auth_util.h"
+#include "physics_auth_internal.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SWEEP_CHUNK 256   // guesses per claimed chunk, multiple of AUTH_BATCH_LANES
+
+// ============================================================================
+// GUESSES
+// ============================================================================
+// Random mode is counter-based: guess i is a pure function of (rng_seed, i)
+// through splitmix64, so every thread generates its own guesses without
+// shared PRNG state and any guess can be replayed on its own.
+
+static float lerp_unit(float lo, float hi, double t) {
+    return lo + (float)((double)(hi - lo) * t);
+}
+
+static uint64_t grid_points(const AuthSweepConfig* cfg) {
+    return (uint64_t)cfg->k_steps * (uint64_t)cfg->gamma_steps * (uint64_t)cfg->seed_steps;
+}
+
+// Position i of steps evenly spaced points over [0, 1]
+static double grid_t(uint64_t i, int steps) {
+    return steps > 1 ? (double)i / (double)(steps - 1) : 0.0;
+}
+
+AuthSecret auth_sweep_guess(const AuthSweepConfig* cfg, uint64_t index) {
+    AuthSecret s;
+    uint64_t seed_span = (uint64_t)cfg->seed_max - cfg->seed_min + 1;
+    if (cfg->mode == AUTH_SWEEP_GRID) {
+        uint64_t si = index % (uint64_t)cfg->seed_steps;
+        uint64_t gi = index / (uint64_t)cfg->seed_steps % (uint64_t)cfg->gamma_steps;
+        uint64_t ki = index / ((uint64_t)cfg->seed_steps * (uint64_t)cfg->gamma_steps);
+        s.k = lerp_unit(cfg->k_min, cfg->k_max, grid_t(ki, cfg->k_steps));
+        s.gamma = lerp_unit(cfg->gamma_min, cfg->gamma_max, grid_t(gi, cfg->gamma_steps));
+        s.seed = cfg->seed_min + (uint32_t)((double)(seed_span - 1) * grid_t(si, cfg->seed_steps));
+    } else {
+        uint64_t state = cfg->rng_seed ^ (index * 0xd1b54a32d192ed03ull);
+        uint64_t a = auth_splitmix64(&state);
+        uint64_t b = auth_splitmix64(&state);
+        s.k = lerp_unit(cfg->k_min, cfg->k_max, (double)(a >> 40) / 16777216.0);
+        s.gamma = lerp_unit(cfg->gamma_min, cfg->gamma_max,
+                            (double)((a >> 16) & 0xFFFFFF) / 16777216.0);
+        s.seed = cfg->seed_min + (uint32_t)(b % seed_span);
+    }
+    return s;
+}
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+typedef struct {
+    const AuthSweepConfig* cfg;
+    const float* challenge;
+    int length;
+    const AuthResponse* target;
+    uint64_t total;
+    uint64_t n_chunks;
+    atomic_uint_fast64_t next_chunk;
+    atomic_uint_fast64_t matches;
+    atomic_uint_fast64_t full_matches;
+
+    // Lowest-index matches, guarded by lock (matches are rare)
+    pthread_mutex_t lock;
+    AuthSweepMatch* recorded;
+    int max_recorded;
+    int n_recorded;
+} SweepShared;
+
+static void record_match(SweepShared* sh, const AuthSecret* secret, uint64_t index) {
+    if (!sh->recorded || sh->max_recorded < 1) return;
+    pthread_mutex_lock(&sh->lock);
+    int slot = -1;
+    if (sh->n_recorded < sh->max_recorded) {
+        slot = sh->n_recorded++;
+    } else {
+        // Full: replace the highest index if this one is lower
+        int highest = 0;
+        for (int i = 1; i < sh->n_recorded; i++) {
+            if (sh->recorded[i].index > sh->recorded[highest].index) highest = i;
+        }
+        if (index < sh->recorded[highest].index) slot = highest;
+    }
+    if (slot >= 0) {
+        sh->recorded[slot].secret = *secret;
+        sh->recorded[slot].index = index;
+    }
+    pthread_mutex_unlock(&sh->lock);
+}
+
+static void* sweep_worker(void* arg) {
+    SweepShared* sh = arg;
+    const AuthSweepConfig* cfg = sh->cfg;
+    AuthSecret guesses[SWEEP_CHUNK];
+    AuthResponse responses[SWEEP_CHUNK];
+    uint64_t full[SWEEP_CHUNK / 64];
+    const float* t = (const float*)sh->target;
+
+    for (;;) {
+        uint64_t chunk = atomic_fetch_add_explicit(&sh->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= sh->n_chunks) break;
+        uint64_t base = chunk * SWEEP_CHUNK;
+        int n = sh->total - base < SWEEP_CHUNK ? (int)(sh->total - base) : SWEEP_CHUNK;
+
+        for (int j = 0; j < n; j++) guesses[j] = auth_sweep_guess(cfg, base + (uint64_t)j);
+        auth_compute_response_batch_rev(sh->challenge, sh->length, 0, guesses, n, cfg->revision,
+                                        responses);
+        uint64_t n_full = (uint64_t)auth_verify_batch(responses, sh->target, 0, n,
+                                                      cfg->tolerance, full);
+
+        uint64_t n_matched = 0;
+        for (int j = 0; j < n; j++) {
+            const float* r = (const float*)&responses[j];
+            int ok = 1;
+            for (int c = 0; c < cfg->channels; c++) {
+                if (!(fabsf(r[c] - t[c]) < cfg->tolerance)) {
+                    ok = 0;
+                    break;
+                }
+            }
+            if (ok) {
+                n_matched++;
+                record_match(sh, &guesses[j], base + (uint64_t)j);
+            }
+        }
+        if (n_full) atomic_fetch_add_explicit(&sh->full_matches, n_full, memory_order_relaxed);
+        if (n_matched) atomic_fetch_add_explicit(&sh->matches, n_matched, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+// ============================================================================
+// SWEEP
+// ============================================================================
+
+static int cmp_match(const void* a, const void* b) {
+    uint64_t x = ((const AuthSweepMatch*)a)->index, y = ((const AuthSweepMatch*)b)->index;
+    return (x > y) - (x < y);
+}
+
+int auth_sweep(const AuthSweepConfig* cfg, const float* challenge, int length,
+               const AuthResponse* target, AuthSweepMatch* matches, int max_matches,
+               AuthSweepResult* result) {
+    if (!cfg || !challenge || !target || !result || length < 1) return 0;
+    if (cfg->channels < 1 || cfg->channels > 8 || cfg->seed_max < cfg->seed_min) return 0;
+    if (cfg->mode == AUTH_SWEEP_GRID &&
+        (cfg->k_steps < 1 || cfg->gamma_steps < 1 || cfg->seed_steps < 1)) return 0;
+    if (cfg->revision < 1 || cfg->revision > 31 ||
+        auth_engine_negotiate(1u << cfg->revision) != cfg->revision) return 0;
+
+    SweepShared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.cfg = cfg;
+    sh.challenge = challenge;
+    sh.length = length;
+    sh.target = target;
+    sh.total = cfg->mode == AUTH_SWEEP_GRID ? grid_points(cfg) : cfg->guesses;
+    sh.n_chunks = (sh.total + SWEEP_CHUNK - 1) / SWEEP_CHUNK;
+    atomic_init(&sh.next_chunk, 0);
+    atomic_init(&sh.matches, 0);
+    atomic_init(&sh.full_matches, 0);
+    pthread_mutex_init(&sh.lock, NULL);
+    sh.recorded = matches;
+    sh.max_recorded = max_matches;
+
+    int n_threads = auth_workers_resolve(cfg->threads, sh.n_chunks);
+    auth_tables_ensure();   // before any worker reads the tables
+    double start = auth_now_seconds();
+    auth_workers_run(sweep_worker, &sh, n_threads);
+    double seconds = auth_now_seconds() - start;
+    pthread_mutex_destroy(&sh.lock);
+
+    if (matches && sh.n_recorded > 1) {
+        qsort(matches, (size_t)sh.n_recorded, sizeof(AuthSweepMatch), cmp_match);
+    }
+    result->guesses = sh.total;
+    result->matches = atomic_load(&sh.matches);
+    result->full_matches = atomic_load(&sh.full_matches);
+    result->recorded = sh.n_recorded;
+    result->seconds = seconds;
+    result->guesses_per_sec = seconds > 0.0 ? (double)sh.total / seconds : 0.0;
+    return 1;
+}
@@ -0,0 +1,59 @@
+// auth_sweep.h
+// Parallel keyspace sweep for brute-force audits
+//
+// Guesses are drawn from a (k, gamma, seed) box, at random or on a grid,
+// in chunks that worker threads claim from a shared counter. Each chunk
+// runs on the batch engine against one captured challenge and is screened
+// against the captured response. Random guesses come from a per-chunk
+// PRNG stream derived from the sweep seed, so a sweep finds the same
+// guesses whatever the thread count.
+
+#ifndef AUTH_SWEEP_H
+#define AUTH_SWEEP_H
+
+#include "physics_auth.h"
+
+typedef enum {
+    AUTH_SWEEP_RANDOM = 0,   // cfg.guesses uniform samples of the box
+    AUTH_SWEEP_GRID          // k_steps x gamma_steps x seed_steps points, ends inclusive
+} AuthSweepMode;
+
+typedef struct {
+    float k_min, k_max;
+    float gamma_min, gamma_max;
+    uint32_t seed_min, seed_max;   // inclusive
+    AuthSweepMode mode;
+    uint64_t guesses;              // random mode
+    int k_steps, gamma_steps, seed_steps;   // grid mode
+    uint64_t rng_seed;             // random mode
+    int threads;                   // <= 0: one per online CPU
+    int revision;                  // AUTH_ENGINE_REV_*
+    float tolerance;
+    int channels;                  // leading response channels that must match (1..8)
+} AuthSweepConfig;
+
+typedef struct {
+    AuthSecret secret;
+    uint64_t index;                // guess number within the sweep
+} AuthSweepMatch;
+
+typedef struct {
+    uint64_t guesses;
+    uint64_t matches;              // guesses matching the first cfg.channels channels
+    uint64_t full_matches;         // guesses matching all 8 (auth_verify)
+    int recorded;                  // matches stored, lowest guess index first
+    double seconds;
+    double guesses_per_sec;
+} AuthSweepResult;
+
+// Sweep cfg's keyspace against (challenge, target). Up to max_matches
+// matching guesses are stored in matches (may be NULL). Returns 0 on a bad
+// config or unsupported revision.
+int auth_sweep(const AuthSweepConfig* cfg, const float* challenge, int length,
+               const AuthResponse* target, AuthSweepMatch* matches, int max_matches,
+               AuthSweepResult* result);
+
+// The guess with index i (for replaying a match or a serial reference)
+AuthSecret auth_sweep_guess(const AuthSweepConfig* cfg, uint64_t index);
+
+#endif // AUTH_SWEEP_H
@@ -0,0 +1,142 @@
+// auth_table_gen.c
+// Offline-mode table generator: precomputes the expected response of every
+// secret to a range of challenge ids and writes an mmap-able table
+// (format in physics_auth.h, loaded with auth_table_open()).
+//
+// Usage: auth_table_gen <secrets.txt> <output.tbl> <first_id> <count> [revision] [threads]
+// secrets.txt: one "k gamma seed" per line; '#' starts a comment.
+// The line order is the secret index used by auth_table_lookup().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "physics_auth.h"
+#include "auth_pool.h"
+
+#define GEN_CHUNK_ENTRIES 8192   // responses computed per pool call
+#define MAX_SECRETS 1000000
+
+static AuthSecret* load_secrets(const char* path, int* count) {
+    FILE* f = fopen(path, "r");
+    if (!f) return NULL;
+
+    int capacity = 64;
+    AuthSecret* secrets = malloc(sizeof(AuthSecret) * capacity);
+    char line[256];
+    *count = 0;
+    while (secrets && fgets(line, sizeof(line), f)) {
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        AuthSecret s;
+        if (sscanf(line, "%f %f %u", &s.k, &s.gamma, &s.seed) != 3) continue;
+        if (*count == capacity) {
+            capacity *= 2;
+            AuthSecret* grown = realloc(secrets, sizeof(AuthSecret) * capacity);
+            if (!grown) {
+                free(secrets);
+                secrets = NULL;
+                break;
+            }
+            secrets = grown;
+        }
+        secrets[(*count)++] = s;
+        if (*count > MAX_SECRETS) break;
+    }
+    fclose(f);
+    return secrets;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s <secrets.txt> <output.tbl> <first_id> <count> "
+                        "[revision] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t first_id = (uint32_t)strtoul(argv[3], NULL, 0);
+    uint64_t count = strtoull(argv[4], NULL, 0);
+    int revision = argc > 5 ? atoi(argv[5]) : AUTH_ENGINE_REV_1;
+    int threads = argc > 6 ? atoi(argv[6]) : 0;
+
+    auth_init();
+
+    int n_secrets = 0;
+    AuthSecret* secrets = load_secrets(argv[1], &n_secrets);
+    if (!secrets || n_secrets == 0 || n_secrets > MAX_SECRETS) {
+        fprintf(stderr, "No usable secrets in %s\n", argv[1]);
+        return 1;
+    }
+    if (revision < 1 || revision > 31 || auth_engine_negotiate(1u << revision) != revision) {
+        fprintf(stderr, "Unsupported engine revision %d\n", revision);
+        return 1;
+    }
+    if (count == 0 || count > (1ull << 32)) {
+        fprintf(stderr, "Challenge count must be in 1..2^32\n");
+        return 1;
+    }
+
+    FILE* out = fopen(argv[2], "wb");
+    if (!out) {
+        perror(argv[2]);
+        return 1;
+    }
+    AuthTableHeader header;
+    auth_table_header_init(&header, revision, CHALLENGE_LENGTH, (uint32_t)n_secrets,
+                           first_id, count);
+    fwrite(&header, sizeof(header), 1, out);
+
+    AuthPool* pool = auth_pool_create(threads, 1);
+    if (!pool) {
+        fprintf(stderr, "Failed to start worker pool\n");
+        return 1;
+    }
+
+    // Rows are computed a chunk at a time with per-secret challenges, so
+    // the pool stays busy even when there are only a few secrets
+    int rows = GEN_CHUNK_ENTRIES / n_secrets;
+    if (rows < 1) rows = 1;
+    size_t entries = (size_t)rows * n_secrets;
+    AuthSecret* lane_secrets = malloc(sizeof(AuthSecret) * entries);
+    float* challenges = malloc(sizeof(float) * CHALLENGE_LENGTH * entries);
+    AuthResponse* responses = malloc(sizeof(AuthResponse) * entries);
+    if (!lane_secrets || !challenges || !responses) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (size_t e = 0; e < entries; e++) lane_secrets[e] = secrets[e % n_secrets];
+
+    printf("Generating %llu challenges x %d secrets (revision %d, %d threads)\n",
+           (unsigned long long)count, n_secrets, revision, auth_pool_threads(pool));
+
+    for (uint64_t row = 0; row < count; row += rows) {
+        int n_rows = count - row < (uint64_t)rows ? (int)(count - row) : rows;
+        for (int r = 0; r < n_rows; r++) {
+            float* c = challenges + (size_t)r * n_secrets * CHALLENGE_LENGTH;
+            auth_challenge_from_id(first_id + (uint32_t)(row + r), c, CHALLENGE_LENGTH);
+            for (int s = 1; s < n_secrets; s++) {
+                memcpy(c + (size_t)s * CHALLENGE_LENGTH, c, sizeof(float) * CHALLENGE_LENGTH);
+            }
+        }
+        int n = n_rows * n_secrets;
+        auth_pool_compute(pool, challenges, CHALLENGE_LENGTH, CHALLENGE_LENGTH,
+                          lane_secrets, n, revision, responses);
+        if (fwrite(responses, sizeof(AuthResponse), (size_t)n, out) != (size_t)n) {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    if (fclose(out) != 0) {
+        perror(argv[2]);
+        return 1;
+    }
+    auth_pool_destroy(pool);
+    printf("Wrote %s (%llu bytes)\n", argv[2],
+           (unsigned long long)(sizeof(header) + count * n_secrets * sizeof(AuthResponse)));
+
+    free(lane_secrets);
+    free(challenges);
+    free(responses);
+    free(secrets);
+    return 0;
+}
@@ -0,0 +1,212 @@
+// auth_telemetry.c
+// Latency histograms and their Prometheus / StatsD export
+
+#define _GNU_SOURCE
+#include "auth_telemetry.h"
+#include "auth_util.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AUTH_HAVE_SOCKETS 1
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#define SUB AUTH_HISTOGRAM_SUB_BITS
+#define SUB_COUNT (1u << SUB)
+#define MAX_SAMPLE ((1ull << AUTH_HISTOGRAM_MAX_BITS) - 1)
+
+uint64_t auth_telemetry_now_ns(void) {
+    return auth_now_ns();
+}
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+// Values below SUB_COUNT get a bucket each. Above, octave e (2^e <= v <
+// 2^(e+1)) is split into SUB_COUNT buckets by the SUB bits after the
+// leading one, so bucket width is 2^(e - SUB).
+
+static inline int bucket_index(uint64_t v) {
+    if (v > MAX_SAMPLE) v = MAX_SAMPLE;
+    if (v < SUB_COUNT) return (int)v;
+    int e = 63 - __builtin_clzll(v);
+    return ((e - SUB + 1) << SUB) + (int)((v >> (e - SUB)) & (SUB_COUNT - 1));
+}
+
+// Largest value that lands in bucket i
+static uint64_t bucket_high(int i) {
+    if (i < (int)SUB_COUNT) return (uint64_t)i;
+    int e = (i >> SUB) + SUB - 1;
+    uint64_t low = (uint64_t)(SUB_COUNT + (i & (SUB_COUNT - 1))) << (e - SUB);
+    return low + (1ull << (e - SUB)) - 1;
+}
+
+void auth_histogram_init(AuthHistogram* h, const char* name, const char* help) {
+    h->name = name;
+    h->help = help;
+    auth_histogram_reset(h);
+}
+
+void auth_histogram_reset(AuthHistogram* h) {
+    h->count = 0;
+    h->sum_ns = 0;
+    h->min_ns = UINT64_MAX;
+    h->max_ns = 0;
+    memset(h->buckets, 0, sizeof(h->buckets));
+}
+
+void auth_histogram_record(AuthHistogram* h, uint64_t ns) {
+    h->buckets[bucket_index(ns)]++;
+    h->count++;
+    h->sum_ns += ns;
+    if (ns < h->min_ns) h->min_ns = ns;
+    if (ns > h->max_ns) h->max_ns = ns;
+}
+
+void auth_histogram_merge(AuthHistogram* into, const AuthHistogram* from) {
+    for (int i = 0; i < AUTH_HISTOGRAM_BUCKETS; i++) into->buckets[i] += from->buckets[i];
+    into->count += from->count;
+    into->sum_ns += from->sum_ns;
+    if (from->min_ns < into->min_ns) into->min_ns = from->min_ns;
+    if (from->max_ns > into->max_ns) into->max_ns = from->max_ns;
+}
+
+uint64_t auth_histogram_quantile(const AuthHistogram* h, double q) {
+    if (h->count == 0) return 0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    // Smallest value with at least ceil(q * count) samples at or below it
+    uint64_t rank = (uint64_t)(q * (double)h->count + 0.999999);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < AUTH_HISTOGRAM_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t v = bucket_high(i);
+            if (v > h->max_ns) v = h->max_ns;
+            return v < h->min_ns ? h->min_ns : v;
+        }
+    }
+    return h->max_ns;
+}
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+// snprintf at out + len; returns the length needed so far
+static size_t append(char* out, size_t cap, size_t len, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = len < cap ? vsnprintf(out + len, cap - len, fmt, ap) : vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    return n > 0 ? len + (size_t)n : len;
+}
+
+// Prometheus bucket bounds in seconds
+static const double prometheus_bounds[] = {
+    1e-5, 2e-5, 5e-5, 1e-4, 2e-4, 5e-4, 1e-3, 2e-3, 5e-3, 1e-2,
+    2e-2, 5e-2, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0,
+};
+
+size_t auth_histogram_prometheus(const AuthHistogram* h, const char* labels, char* out,
+                                 size_t cap) {
+    const char* sep = labels && *labels ? "," : "";
+    if (!labels) labels = "";
+    if (cap) out[0] = '\0';
+    size_t len = append(out, cap, 0, "# HELP %s %s\n# TYPE %s histogram\n", h->name, h->help,
+                        h->name);
+    int bucket = 0;
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < sizeof(prometheus_bounds) / sizeof(prometheus_bounds[0]); b++) {
+        uint64_t bound_ns = (uint64_t)(prometheus_bounds[b] * 1e9 + 0.5);
+        while (bucket < AUTH_HISTOGRAM_BUCKETS && bucket_high(bucket) <= bound_ns) {
+            cumulative += h->buckets[bucket++];
+        }
+        len = append(out, cap, len, "%s_bucket{%s%sle=\"%g\"} %llu\n", h->name, labels, sep,
+                     prometheus_bounds[b], (unsigned long long)cumulative);
+    }
+    len = append(out, cap, len, "%s_bucket{%s%sle=\"+Inf\"} %llu\n", h->name, labels, sep,
+                 (unsigned long long)h->count);
+    const char* open = *labels ? "{" : "";
+    const char* close = *labels ? "}" : "";
+    len = append(out, cap, len, "%s_sum%s%s%s %.9f\n", h->name, open, labels, close,
+                 (double)h->sum_ns / 1e9);
+    len = append(out, cap, len, "%s_count%s%s%s %llu\n", h->name, open, labels, close,
+                 (unsigned long long)h->count);
+    return len;
+}
+
+size_t auth_histogram_statsd(const AuthHistogram* h, const char* prefix, char* out,
+                             size_t cap) {
+    static const struct {
+        const char* suffix;
+        double q;
+    } stats[] = {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}, {"max", 1.0}};
+    if (!prefix) prefix = "";
+    if (cap) out[0] = '\0';
+    size_t len = append(out, cap, 0, "%s%s.count:%llu|c\n", prefix, h->name,
+                        (unsigned long long)h->count);
+    if (h->count == 0) return len;
+    for (size_t i = 0; i < sizeof(stats) / sizeof(stats[0]); i++) {
+        len = append(out, cap, len, "%s%s.%s:%.9f|g\n", prefix, h->name, stats[i].suffix,
+                     (double)auth_histogram_quantile(h, stats[i].q) / 1e9);
+    }
+    return len;
+}
+
+int auth_telemetry_statsd_open(const char* host_port) {
+#if AUTH_HAVE_SOCKETS
+    char host[256];
+    const char* colon = strrchr(host_port, ':');
+    if (!colon || colon == host_port || (size_t)(colon - host_port) >= sizeof(host)) return -1;
+    memcpy(host, host_port, (size_t)(colon - host_port));
+    host[colon - host_port] = '\0';
+
+    struct addrinfo hints, *addr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, colon + 1, &hints, &addr) != 0) return -1;
+    int fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (fd >= 0 && (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) < 0 ||
+                    connect(fd, addr->ai_addr, addr->ai_addrlen) < 0)) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addr);
+    return fd;
+#else
+    (void)host_port;
+    return -1;
+#endif
+}
+
+int auth_telemetry_statsd_push(int fd, const char* payload, size_t size) {
+#if AUTH_HAVE_SOCKETS
+    // A full socket buffer (EAGAIN) or an ICMP error from an earlier push
+    // (ECONNREFUSED) drops this interval; the next push tries again
+    return fd >= 0 && send(fd, payload, size, 0) == (ssize_t)size;
+#else
+    (void)fd;
+    (void)payload;
+    (void)size;
+    return 0;
+#endif
+}
+
+int auth_telemetry_statsd_send(const char* host_port, const char* payload, size_t size) {
+    int fd = auth_telemetry_statsd_open(host_port);
+    if (fd < 0) return 0;
+    int ok = auth_telemetry_statsd_push(fd, payload, size);
+#if AUTH_HAVE_SOCKETS
+    close(fd);
+#endif
+    return ok;
+}
@@ -0,0 +1,73 @@
+// auth_telemetry.h
+// Latency histograms for live-fleet telemetry (client and server)
+//
+// An AuthHistogram is an HDR-style log-linear histogram of nanosecond
+// latencies: exact below 32 ns, then 32 buckets per power of two, so any
+// reading is within 1/32 (3.2%) of the true value, up to 2^36 ns (~69 s;
+// longer samples land in the top bucket, max_ns stays exact). Recording is
+// an index computation and two adds - nothing is allocated or locked, so it
+// can stay on in production. A histogram has one writer thread; merge
+// per-thread histograms to combine them.
+//
+// Exports:
+//   - Prometheus text format: a histogram with 1-2-5 bucket bounds from
+//     10 us to 10 s, plus _sum and _count; cumulative since init, so
+//     scrapes can be rated and summed across the fleet
+//   - StatsD: count as a counter, p50/p90/p99/p999/max as gauges in
+//     seconds; per interval - reset the histogram after each send
+// A sample is reported at its bucket's upper end (at most 3.2% high).
+
+#ifndef AUTH_TELEMETRY_H
+#define AUTH_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AUTH_HISTOGRAM_SUB_BITS 5                     // 2^5 buckets per octave
+#define AUTH_HISTOGRAM_MAX_BITS 36                    // samples below 2^36 ns
+#define AUTH_HISTOGRAM_BUCKETS \
+    ((AUTH_HISTOGRAM_MAX_BITS - AUTH_HISTOGRAM_SUB_BITS + 1) << AUTH_HISTOGRAM_SUB_BITS)
+
+typedef struct {
+    const char* name;             // metric name, e.g. "auth_client_compute_seconds"
+    const char* help;
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t buckets[AUTH_HISTOGRAM_BUCKETS];
+} AuthHistogram;
+
+// Monotonic wall clock in nanoseconds (not process CPU time)
+uint64_t auth_telemetry_now_ns(void);
+
+void auth_histogram_init(AuthHistogram* h, const char* name, const char* help);
+void auth_histogram_reset(AuthHistogram* h);      // keeps name and help
+void auth_histogram_record(AuthHistogram* h, uint64_t ns);
+void auth_histogram_merge(AuthHistogram* into, const AuthHistogram* from);
+
+// Latency at quantile q in [0, 1] (0.99 = p99); 0 if empty
+uint64_t auth_histogram_quantile(const AuthHistogram* h, double q);
+
+// Append the export of h to out (cap bytes, NUL-terminated). labels is a
+// Prometheus label list without braces (device="rpi-001"), may be NULL;
+// prefix is prepended to StatsD names (e.g. "door.", may be NULL).
+// Return the length the export needs, like snprintf: out holds all of it
+// only if that is below cap.
+size_t auth_histogram_prometheus(const AuthHistogram* h, const char* labels, char* out,
+                                 size_t cap);
+size_t auth_histogram_statsd(const AuthHistogram* h, const char* prefix, char* out, size_t cap);
+
+// StatsD agent at "host:port": resolve it once and return a connected,
+// non-blocking UDP socket (close() it when done), -1 on a bad address.
+// auth_telemetry_statsd_push then sends payload as one datagram (keep it
+// under ~1400 bytes) without blocking: 0 if it was not sent whole. For
+// event loops, which must not resolve names or create sockets per push.
+int auth_telemetry_statsd_open(const char* host_port);
+int auth_telemetry_statsd_push(int fd, const char* payload, size_t size);
+
+// One-shot open, push and close, for short-lived processes. Returns 0 on a
+// bad address or send error.
+int auth_telemetry_statsd_send(const char* host_port, const char* payload, size_t size);
+
+#endif // AUTH_TELEMETRY_H
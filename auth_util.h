@@ -0,0 +1,86 @@
+// auth_util.h
+// Internal helpers shared by the host-side modules (not part of the API)
+//
+// One monotonic clock, one splitmix64 and one way of fanning chunked work
+// out to threads, so the sweep, population, corpus, store, telemetry,
+// benchmark and ML code all time and seed things the same way.
+
+#ifndef AUTH_UTIL_H
+#define AUTH_UTIL_H
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AUTH_HAVE_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define AUTH_WORKERS_MAX 256
+
+// ============================================================================
+// CLOCK
+// ============================================================================
+
+// Monotonic wall clock (not process CPU time)
+static inline uint64_t auth_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline double auth_now_seconds(void) {
+    return (double)auth_now_ns() * 1e-9;
+}
+
+// ============================================================================
+// SPLITMIX64
+// ============================================================================
+// Counter-based generators hash (seed, index) through the finalizer, so
+// any thread can produce element i without shared PRNG state.
+
+static inline uint64_t auth_mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t auth_splitmix64(uint64_t* state) {
+    return auth_mix64(*state += 0x9e3779b97f4a7c15ull);
+}
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+// Workers claim chunks from an atomic counter in shared state until none
+// are left. Call auth_tables_ensure() before starting them.
+
+#if AUTH_HAVE_THREADS
+// threads <= 0 means one per online CPU; never more than there are chunks
+static inline int auth_workers_resolve(int threads, uint64_t n_chunks) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > AUTH_WORKERS_MAX) threads = AUTH_WORKERS_MAX;
+    if ((uint64_t)threads > n_chunks) threads = n_chunks > 0 ? (int)n_chunks : 1;
+    return threads;
+}
+
+// Run worker(shared) on n_threads threads and wait for all of them. The
+// caller is worker 0; if a thread cannot be started the others take its
+// chunks.
+static inline void auth_workers_run(void* (*worker)(void*), void* shared, int n_threads) {
+    pthread_t threads[AUTH_WORKERS_MAX];
+    int started = 0;
+    for (int i = 1; i < n_threads && i < AUTH_WORKERS_MAX; i++) {
+        if (pthread_create(&threads[started], NULL, worker, shared) != 0) break;
+        started++;
+    }
+    worker(shared);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+}
+#endif
+
+#endif // AUTH_UTIL_H
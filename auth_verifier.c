@@ -0,0 +1,852 @@
+// auth_verifier.c
+// Verification core of the C authentication server (see auth_verifier.h)
+
+#include "auth_verifier.h"
+#include "auth_util.h"
+#include "physics_auth_internal.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Expected responses come from the float batch engine; a device build
+// (auth_compute_response() on the Q16 engine) would never match them
+#if AUTH_FIXED_POINT
+#error "AUTH_FIXED_POINT=1 is a device-only build; build the server side without it"
+#endif
+
+#define VERIFIER_CHUNK 256   // requests per batch-engine / verify_batch call
+#define REFILL_LANES 64      // ring entries per refill batch-engine call
+
+// Device record. Records never move: pending challenges and the refill
+// thread refer to them by number.
+typedef struct {
+    uint64_t hash;           // 0 = free record
+    char id[AUTH_VERIFIER_MAX_ID + 1];
+    AuthSecret secret;
+    const AuthProfile* profile;   // replaced together with secret
+    int quantized;           // registry mode: AuthResponseI16 accepted
+    int head, tail;          // pending queue, oldest first, -1 when empty
+    int pending;
+    int ring;                // the record's number, indexes the precompute rings
+    atomic_uint gen;         // seqlock on secret: odd while it is being replaced.
+                             // Never reused, by this or any other record.
+} DeviceSlot;
+
+// Lanes of one profile, gathered out of a mixed batch
+typedef struct {
+    float challenges[VERIFIER_CHUNK * CHALLENGE_LENGTH];
+    AuthSecret secrets[VERIFIER_CHUNK];
+    AuthResponse expected[VERIFIER_CHUNK];
+    int lane[VERIFIER_CHUNK];
+    unsigned char done[VERIFIER_CHUNK];
+} ProfileGroup;
+
+// Precomputed (challenge, expected) pair. gen is the device's secret
+// generation it was computed under; stale entries are dropped on pop.
+typedef struct {
+    uint32_t gen;
+    uint32_t challenge_id;
+    float challenge[CHALLENGE_LENGTH];
+    AuthResponse expected;
+} RingEntry;
+
+// Single-producer (refill thread) single-consumer (issue) ring per device
+typedef struct {
+    atomic_uint head;        // consumer position
+    atomic_uint tail;        // producer position
+    atomic_int queued;       // in the refill queue
+} DeviceRing;
+
+typedef struct {
+    AuthResponse expected;
+    uint32_t expires;        // last second the challenge may be answered
+    int device;              // slot in the device table, -1 when free
+    int next;                // next pending of the device, or next free
+    int wheel_prev, wheel_next;
+} PendingChallenge;
+
+struct AuthVerifier {
+    DeviceSlot* devices;     // max_devices records
+    int* index;              // open addressing (linear probing) on the id hash, -1 = empty
+    uint32_t mask;
+    int n_devices;
+    int n_records;           // records used so far
+    int* free_records;       // records of evicted devices
+    int n_free;
+    int clock;               // store mode: next record considered for eviction
+    uint32_t next_gen;
+    int max_devices;
+
+    PendingChallenge* pending;
+    int max_pending;
+    int n_pending;
+    int free_head;
+
+    int wheel[AUTH_VERIFIER_WHEEL_SLOTS];
+    uint32_t next_tick;      // first second not yet expired through
+    int ticking;
+
+    int timeout;
+    int revision;
+    AuthPool* pool;
+    uint64_t rng;
+    AuthVerifierStats stats;
+
+    // Shared registry (auth_verifier_attach_store)
+    AuthStore* store;
+    int store_reader;
+
+    // Precompute rings (auth_verifier_start_refill)
+    int ring_depth;
+    DeviceRing* rings;
+    RingEntry* ring_entries;       // ring_depth per device
+    int* refill_queue;             // rings to top up, SPSC, max_devices + 1 slots
+    atomic_uint refill_head, refill_tail;
+    atomic_int refill_sleeping;
+    atomic_int refill_stop;
+    pthread_mutex_t refill_lock;
+    pthread_cond_t refill_wake;
+    pthread_t refill_thread;
+    int refilling;
+
+    // Batch scratch
+    float challenges[VERIFIER_CHUNK * CHALLENGE_LENGTH];
+    AuthSecret secrets[VERIFIER_CHUNK];
+    const AuthProfile* profiles[VERIFIER_CHUNK];
+    ProfileGroup group;
+    AuthResponse expected[VERIFIER_CHUNK];
+    AuthResponse received[VERIFIER_CHUNK];
+    int owner[VERIFIER_CHUNK];     // request index
+    AuthResponseI16 expected_i16[VERIFIER_CHUNK];
+    AuthResponseI16 received_i16[VERIFIER_CHUNK];
+    int owner_i16[VERIFIER_CHUNK];
+    int device[VERIFIER_CHUNK];
+    AuthResponse hit_expected[VERIFIER_CHUNK];   // issued from a ring
+    int hit_owner[VERIFIER_CHUNK];
+    int hit_device[VERIFIER_CHUNK];
+    const char* ids[VERIFIER_CHUNK];              // store lookups
+    AuthSecret store_secrets[VERIFIER_CHUNK];
+    const AuthProfile* store_profiles[VERIFIER_CHUNK];
+    unsigned char store_found[VERIFIER_CHUNK];
+};
+
+// ============================================================================
+// DEVICE TABLE
+// ============================================================================
+
+static uint64_t hash_id(const char* id) {
+    uint64_t h = 0xcbf29ce484222325ull;   // FNV-1a
+    for (; *id; id++) h = (h ^ (uint8_t)*id) * 0x100000001b3ull;
+    return h | 1;                         // never the empty marker
+}
+
+static void refill_request(AuthVerifier* v, int ring);
+
+static int find_device(const AuthVerifier* v, const char* id, uint64_t hash) {
+    for (uint32_t i = (uint32_t)hash & v->mask;; i = (i + 1) & v->mask) {
+        int r = v->index[i];
+        if (r < 0) return -1;
+        const DeviceSlot* d = &v->devices[r];
+        if (d->hash == hash && strcmp(d->id, id) == 0) return r;
+    }
+}
+
+int auth_verifier_register(AuthVerifier* v, const char* device_id, const AuthSecret* secret) {
+    return auth_verifier_register_profile(v, device_id, secret,
+                                          &auth_profile_presets[AUTH_PROFILE_DEFAULT]);
+}
+
+// The refill thread may be reading the secret: make gen odd around the
+// write so it retries, then give it a fresh value so entries under the
+// old secret - or a previous owner of the record - go stale
+static void set_secret(AuthVerifier* v, DeviceSlot* d, const AuthSecret* secret,
+                       const AuthProfile* profile) {
+    uint32_t gen = v->next_gen += 2;
+    atomic_store_explicit(&d->gen, gen - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    d->secret = *secret;
+    d->profile = profile;
+    atomic_store_explicit(&d->gen, gen, memory_order_release);
+    if (v->refilling) refill_request(v, d->ring);
+}
+
+int auth_verifier_register_profile(AuthVerifier* v, const char* device_id,
+                                   const AuthSecret* secret, const AuthProfile* profile) {
+    if (strlen(device_id) > AUTH_VERIFIER_MAX_ID || !auth_profile_valid(profile)) return 0;
+    uint64_t hash = hash_id(device_id);
+    int slot = find_device(v, device_id, hash);
+    if (slot < 0) {
+        if (v->n_devices == v->max_devices) return 0;
+        slot = v->n_free > 0 ? v->free_records[--v->n_free] : v->n_records++;
+        uint32_t i = (uint32_t)hash & v->mask;
+        while (v->index[i] >= 0) i = (i + 1) & v->mask;
+        v->index[i] = slot;
+        DeviceSlot* d = &v->devices[slot];
+        d->hash = hash;
+        strcpy(d->id, device_id);
+        d->head = d->tail = -1;
+        d->pending = 0;
+        d->quantized = 0;
+        d->ring = slot;
+        v->n_devices++;
+    }
+    set_secret(v, &v->devices[slot], secret, profile);
+    return 1;
+}
+
+int auth_verifier_allow_quantized(AuthVerifier* v, const char* device_id, int allow) {
+    int slot = find_device(v, device_id, hash_id(device_id));
+    if (slot < 0) return 0;
+    v->devices[slot].quantized = allow != 0;
+    return 1;
+}
+
+// Drop record r (nothing pending) by backward-shift deletion: later
+// entries of its probe run move up into the hole unless their home lies
+// between the hole and them, so no lookup chain is cut
+static void evict_device(AuthVerifier* v, int r) {
+    DeviceSlot* d = &v->devices[r];
+    uint32_t hole = (uint32_t)d->hash & v->mask;
+    while (v->index[hole] != r) hole = (hole + 1) & v->mask;
+    for (uint32_t j = (hole + 1) & v->mask; v->index[j] >= 0; j = (j + 1) & v->mask) {
+        uint32_t home = (uint32_t)v->devices[v->index[j]].hash & v->mask;
+        if (((j - home) & v->mask) >= ((j - hole) & v->mask)) {
+            v->index[hole] = v->index[j];
+            hole = j;
+        }
+    }
+    v->index[hole] = -1;
+    d->hash = 0;
+    v->free_records[v->n_free++] = r;
+    v->n_devices--;
+}
+
+// Store mode: the record tracking device_id under the store's secret and
+// profile (record r, or -1 if not tracked yet). With max_devices tracked,
+// the next idle device in clock order - nothing pending - is evicted.
+// Returns -1 if every tracked device has a challenge outstanding.
+static int track_device(AuthVerifier* v, const char* device_id, uint64_t hash, int r,
+                        const AuthSecret* secret, const AuthProfile* profile) {
+    if (r >= 0) {
+        DeviceSlot* d = &v->devices[r];
+        if (d->profile != profile || memcmp(&d->secret, secret, sizeof(AuthSecret)) != 0) {
+            set_secret(v, d, secret, profile);   // changed by a store reload
+        }
+        return r;
+    }
+    if (strlen(device_id) > AUTH_VERIFIER_MAX_ID) return -1;
+    if (v->n_devices == v->max_devices) {
+        int victim = -1;
+        for (int k = 0; k < v->n_records && victim < 0; k++) {
+            int c = v->clock;
+            v->clock = (v->clock + 1) % v->n_records;
+            if (v->devices[c].hash != 0 && v->devices[c].pending == 0) victim = c;
+        }
+        if (victim < 0) return -1;
+        evict_device(v, victim);
+        v->stats.evicted++;
+    }
+    auth_verifier_register_profile(v, device_id, secret, profile);
+    return find_device(v, device_id, hash);
+}
+
+int auth_verifier_attach_store(AuthVerifier* v, AuthStore* store) {
+    if (v->store) return 0;
+    int reader = auth_store_reader_join(store);
+    if (reader < 0) return 0;
+    v->store = store;
+    v->store_reader = reader;
+    return 1;
+}
+
+// Store mode: look up the secrets of requests [0, n) of a batch into the
+// store_* scratch arrays
+static void store_lookup(AuthVerifier* v, const char* const* ids, int n) {
+    auth_store_get_many(v->store, v->store_reader, ids, n, v->store_secrets, v->store_profiles,
+                        v->store_found);
+}
+
+// ============================================================================
+// PENDING CHALLENGES AND TIMER WHEEL
+// ============================================================================
+
+static void wheel_unlink(AuthVerifier* v, int p) {
+    PendingChallenge* c = &v->pending[p];
+    if (c->wheel_prev >= 0) v->pending[c->wheel_prev].wheel_next = c->wheel_next;
+    else v->wheel[c->expires % AUTH_VERIFIER_WHEEL_SLOTS] = c->wheel_next;
+    if (c->wheel_next >= 0) v->pending[c->wheel_next].wheel_prev = c->wheel_prev;
+}
+
+static int pending_alloc(AuthVerifier* v, int device, uint32_t expires) {
+    int p = v->free_head;
+    PendingChallenge* c = &v->pending[p];
+    v->free_head = c->next;
+    c->device = device;
+    c->expires = expires;
+    c->next = -1;
+
+    // Append to the device queue (its pending count was reserved by the caller)
+    DeviceSlot* d = &v->devices[device];
+    if (d->tail >= 0) v->pending[d->tail].next = p;
+    else d->head = p;
+    d->tail = p;
+
+    int slot = (int)(expires % AUTH_VERIFIER_WHEEL_SLOTS);
+    c->wheel_prev = -1;
+    c->wheel_next = v->wheel[slot];
+    if (c->wheel_next >= 0) v->pending[c->wheel_next].wheel_prev = p;
+    v->wheel[slot] = p;
+    v->n_pending++;
+    return p;
+}
+
+// Unlink from the device queue and the wheel, return to the free list
+static void pending_free(AuthVerifier* v, int p) {
+    PendingChallenge* c = &v->pending[p];
+    DeviceSlot* d = &v->devices[c->device];
+    int prev = -1;
+    for (int i = d->head; i != p; i = v->pending[i].next) prev = i;
+    if (prev >= 0) v->pending[prev].next = c->next;
+    else d->head = c->next;
+    if (d->tail == p) d->tail = prev;
+    d->pending--;
+
+    wheel_unlink(v, p);
+    c->device = -1;
+    c->next = v->free_head;
+    v->free_head = p;
+    v->n_pending--;
+}
+
+static void expire_slot(AuthVerifier* v, int slot, uint32_t now) {
+    int p = v->wheel[slot];
+    while (p >= 0) {
+        int next = v->pending[p].wheel_next;
+        if (v->pending[p].expires < now) {
+            pending_free(v, p);
+            v->stats.expired++;
+        }
+        p = next;
+    }
+}
+
+void auth_verifier_expire(AuthVerifier* v, uint32_t now) {
+    if (!v->ticking) {
+        v->ticking = 1;
+        v->next_tick = now;
+        return;
+    }
+    if (now - v->next_tick >= AUTH_VERIFIER_WHEEL_SLOTS && now > v->next_tick) {
+        for (int s = 0; s < AUTH_VERIFIER_WHEEL_SLOTS; s++) expire_slot(v, s, now);
+        v->next_tick = now;
+        return;
+    }
+    for (; v->next_tick < now; v->next_tick++) {
+        expire_slot(v, (int)(v->next_tick % AUTH_VERIFIER_WHEEL_SLOTS), now);
+    }
+}
+
+// ============================================================================
+// PRECOMPUTE RINGS
+// ============================================================================
+// Issue pops the oldest ready entry of the device's ring; when the ring
+// drops below full its device goes on the refill queue. The refill thread
+// runs at idle priority, so under load rings drain and issue falls back to
+// computing inline; between bursts they fill up again.
+
+static uint32_t ring_count(const DeviceRing* rg) {
+    return atomic_load_explicit(&rg->tail, memory_order_acquire) -
+           atomic_load_explicit(&rg->head, memory_order_acquire);
+}
+
+// Event loop side: queue the ring unless it is queued already
+static void refill_request(AuthVerifier* v, int ring) {
+    if (atomic_exchange_explicit(&v->rings[ring].queued, 1, memory_order_acq_rel)) return;
+    uint32_t tail = atomic_load_explicit(&v->refill_tail, memory_order_relaxed);
+    v->refill_queue[tail % (uint32_t)(v->max_devices + 1)] = ring;
+    atomic_store_explicit(&v->refill_tail, tail + 1, memory_order_release);
+    if (atomic_load_explicit(&v->refill_sleeping, memory_order_acquire)) {
+        pthread_mutex_lock(&v->refill_lock);
+        pthread_cond_signal(&v->refill_wake);
+        pthread_mutex_unlock(&v->refill_lock);
+    }
+}
+
+// Pop a ready entry computed under the device's current secret
+static const RingEntry* ring_pop(AuthVerifier* v, DeviceSlot* d) {
+    DeviceRing* rg = &v->rings[d->ring];
+    uint32_t head = atomic_load_explicit(&rg->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&rg->tail, memory_order_acquire);
+    uint32_t gen = atomic_load_explicit(&d->gen, memory_order_relaxed);
+    const RingEntry* found = NULL;
+    while (head != tail && !found) {
+        const RingEntry* e = &v->ring_entries[(size_t)d->ring * (size_t)v->ring_depth +
+                                              head % (uint32_t)v->ring_depth];
+        if (e->gen == gen) found = e;
+        else head++;
+    }
+    // Stale entries are released now, the found one after the caller copied it
+    atomic_store_explicit(&rg->head, head, memory_order_release);
+    return found;
+}
+
+static void ring_release(AuthVerifier* v, DeviceSlot* d) {
+    DeviceRing* rg = &v->rings[d->ring];
+    atomic_fetch_add_explicit(&rg->head, 1, memory_order_release);
+    refill_request(v, d->ring);
+}
+
+// Secret, profile and generation of ring, consistent with each other; 0
+// if the secret is being replaced right now
+static int read_secret(AuthVerifier* v, int ring, AuthSecret* secret,
+                       const AuthProfile** profile, uint32_t* gen) {
+    DeviceSlot* d = &v->devices[ring];
+    uint32_t g1 = atomic_load_explicit(&d->gen, memory_order_acquire);
+    memcpy(secret, &d->secret, sizeof(*secret));
+    memcpy(profile, &d->profile, sizeof(*profile));
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t g2 = atomic_load_explicit(&d->gen, memory_order_relaxed);
+    *gen = g1;
+    return g1 == g2 && !(g1 & 1);
+}
+
+// One engine call for m lanes of profile p (challenge stride CHALLENGE_LENGTH)
+static void compute_profile(AuthPool* pool, int revision, const float* challenges,
+                            const AuthSecret* secrets, const AuthProfile* p, int m,
+                            AuthResponse* expected) {
+    if (pool) {
+        auth_pool_compute_ex(pool, challenges, p->challenge_length, CHALLENGE_LENGTH, secrets,
+                             m, revision, p, expected);
+    } else {
+        auth_compute_response_batch_ex(challenges, p->challenge_length, CHALLENGE_LENGTH,
+                                       secrets, m, revision, p, expected);
+    }
+}
+
+// Expected responses for lanes [0, m): a batch of one profile goes
+// straight through, a mixed one is gathered profile by profile into g
+static void compute_expected(AuthPool* pool, int revision, const float* challenges,
+                             const AuthSecret* secrets, const AuthProfile* const* profiles,
+                             int m, AuthResponse* expected, ProfileGroup* g) {
+    int mixed = 0;
+    for (int j = 1; j < m && !mixed; j++) mixed = profiles[j] != profiles[0];
+    if (!mixed) {
+        compute_profile(pool, revision, challenges, secrets, profiles[0], m, expected);
+        return;
+    }
+
+    memset(g->done, 0, (size_t)m);
+    for (int first = 0; first < m; first++) {
+        if (g->done[first]) continue;
+        const AuthProfile* p = profiles[first];
+        int n = 0;
+        for (int j = first; j < m; j++) {
+            if (g->done[j] || profiles[j] != p) continue;
+            memcpy(&g->challenges[n * CHALLENGE_LENGTH], &challenges[j * CHALLENGE_LENGTH],
+                   sizeof(float) * (size_t)p->challenge_length);
+            g->secrets[n] = secrets[j];
+            g->lane[n++] = j;
+            g->done[j] = 1;
+        }
+        compute_profile(pool, revision, g->challenges, g->secrets, p, n, g->expected);
+        for (int k = 0; k < n; k++) expected[g->lane[k]] = g->expected[k];
+    }
+}
+
+static void* refill_main(void* arg) {
+    AuthVerifier* v = arg;
+#if defined(__linux__) && defined(SCHED_IDLE)
+    struct sched_param idle = {0};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle);
+#endif
+    float challenges[REFILL_LANES * CHALLENGE_LENGTH];
+    AuthSecret secrets[REFILL_LANES];
+    const AuthProfile* profiles[REFILL_LANES];
+    AuthResponse expected[REFILL_LANES];
+    ProfileGroup group;      // REFILL_LANES of VERIFIER_CHUNK used
+    int lane_ring[REFILL_LANES];
+    uint32_t lane_gen[REFILL_LANES], lane_id[REFILL_LANES];
+    uint64_t rng = v->rng ^ 0x5851f42d4c957f2dull;
+    int carry = -1;          // ring that did not fit in the last batch
+    uint32_t queue_size = (uint32_t)(v->max_devices + 1);
+
+    while (!atomic_load_explicit(&v->refill_stop, memory_order_acquire)) {
+        int m = 0;
+        while (m < REFILL_LANES) {
+            int ring = carry;
+            carry = -1;
+            if (ring < 0) {
+                uint32_t head = atomic_load_explicit(&v->refill_head, memory_order_relaxed);
+                if (head == atomic_load_explicit(&v->refill_tail, memory_order_acquire)) break;
+                ring = v->refill_queue[head % queue_size];
+                atomic_store_explicit(&v->refill_head, head + 1, memory_order_release);
+                // Cleared before counting, so a pop from here on queues it again
+                atomic_store_explicit(&v->rings[ring].queued, 0, memory_order_release);
+            }
+            AuthSecret secret;
+            const AuthProfile* profile;
+            uint32_t gen;
+            if (!read_secret(v, ring, &secret, &profile, &gen)) {
+                carry = ring;   // retry once the writer is done
+                break;
+            }
+            int need = v->ring_depth - (int)ring_count(&v->rings[ring]);
+            for (; need > 0 && m < REFILL_LANES; need--, m++) {
+                lane_id[m] = (uint32_t)auth_splitmix64(&rng);
+                auth_challenge_from_id(lane_id[m], &challenges[m * CHALLENGE_LENGTH],
+                                       CHALLENGE_LENGTH);
+                secrets[m] = secret;
+                profiles[m] = profile;
+                lane_ring[m] = ring;
+                lane_gen[m] = gen;
+            }
+            if (need > 0) carry = ring;
+        }
+
+        if (m == 0) {
+            // Idle: sleep until refill_request() or at most 100 ms
+            pthread_mutex_lock(&v->refill_lock);
+            atomic_store_explicit(&v->refill_sleeping, 1, memory_order_seq_cst);
+            if (carry < 0 && atomic_load(&v->refill_head) == atomic_load(&v->refill_tail) &&
+                !atomic_load(&v->refill_stop)) {
+                struct timespec until;
+                clock_gettime(CLOCK_REALTIME, &until);
+                until.tv_nsec += 100000000L;
+                if (until.tv_nsec >= 1000000000L) {
+                    until.tv_sec++;
+                    until.tv_nsec -= 1000000000L;
+                }
+                pthread_cond_timedwait(&v->refill_wake, &v->refill_lock, &until);
+            }
+            atomic_store_explicit(&v->refill_sleeping, 0, memory_order_relaxed);
+            pthread_mutex_unlock(&v->refill_lock);
+            continue;
+        }
+
+        compute_expected(NULL, v->revision, challenges, secrets, profiles, m, expected, &group);
+        for (int j = 0; j < m; j++) {
+            DeviceRing* rg = &v->rings[lane_ring[j]];
+            uint32_t tail = atomic_load_explicit(&rg->tail, memory_order_relaxed);
+            if (tail - atomic_load_explicit(&rg->head, memory_order_acquire) >=
+                (uint32_t)v->ring_depth) continue;   // filled by a duplicate request
+            RingEntry* e = &v->ring_entries[(size_t)lane_ring[j] * (size_t)v->ring_depth +
+                                            tail % (uint32_t)v->ring_depth];
+            e->gen = lane_gen[j];
+            e->challenge_id = lane_id[j];
+            memcpy(e->challenge, &challenges[j * CHALLENGE_LENGTH], sizeof(e->challenge));
+            e->expected = expected[j];
+            atomic_store_explicit(&rg->tail, tail + 1, memory_order_release);
+        }
+    }
+    return NULL;
+}
+
+int auth_verifier_start_refill(AuthVerifier* v, int ring_depth) {
+    if (v->refilling || ring_depth < 1) return 0;
+    size_t n = (size_t)v->max_devices;
+    v->rings = calloc(n, sizeof(DeviceRing));
+    v->ring_entries = calloc(n * (size_t)ring_depth, sizeof(RingEntry));
+    v->refill_queue = calloc(n + 1, sizeof(int));
+    if (!v->rings || !v->ring_entries || !v->refill_queue) goto fail;
+    v->ring_depth = ring_depth;
+    atomic_init(&v->refill_head, 0);
+    atomic_init(&v->refill_tail, 0);
+    atomic_init(&v->refill_sleeping, 0);
+    atomic_init(&v->refill_stop, 0);
+    pthread_mutex_init(&v->refill_lock, NULL);
+    pthread_cond_init(&v->refill_wake, NULL);
+    for (int ring = 0; ring < v->n_records; ring++) {
+        if (v->devices[ring].hash != 0) refill_request(v, ring);
+    }
+    auth_tables_ensure();   // before the thread reads the tables
+    if (pthread_create(&v->refill_thread, NULL, refill_main, v) != 0) {
+        pthread_mutex_destroy(&v->refill_lock);
+        pthread_cond_destroy(&v->refill_wake);
+        goto fail;
+    }
+    v->refilling = 1;
+    return 1;
+
+fail:
+    free(v->rings);
+    free(v->ring_entries);
+    free(v->refill_queue);
+    v->rings = NULL;
+    v->ring_entries = NULL;
+    v->refill_queue = NULL;
+    return 0;
+}
+
+void auth_verifier_stop_refill(AuthVerifier* v) {
+    if (!v->refilling) return;
+    atomic_store_explicit(&v->refill_stop, 1, memory_order_release);
+    pthread_mutex_lock(&v->refill_lock);
+    pthread_cond_signal(&v->refill_wake);
+    pthread_mutex_unlock(&v->refill_lock);
+    pthread_join(v->refill_thread, NULL);
+    pthread_mutex_destroy(&v->refill_lock);
+    pthread_cond_destroy(&v->refill_wake);
+    v->refilling = 0;
+    free(v->rings);
+    free(v->ring_entries);
+    free(v->refill_queue);
+    v->rings = NULL;
+    v->ring_entries = NULL;
+    v->refill_queue = NULL;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+AuthVerifier* auth_verifier_create(int max_devices, int max_pending, int timeout_sec,
+                                   int revision, AuthPool* pool, uint64_t rng_seed) {
+    if (max_devices < 1 || max_pending < 1) return NULL;
+    if (timeout_sec < 1 || timeout_sec >= AUTH_VERIFIER_WHEEL_SLOTS) return NULL;
+    if (revision < 1 || revision > 31 || auth_engine_negotiate(1u << revision) != revision) {
+        return NULL;
+    }
+
+    AuthVerifier* v = calloc(1, sizeof(AuthVerifier));
+    if (!v) return NULL;
+    uint32_t capacity = 2;
+    while (capacity < 2u * (uint32_t)max_devices) capacity <<= 1;   // load factor <= 1/2
+    v->devices = calloc((size_t)max_devices, sizeof(DeviceSlot));
+    v->index = malloc(capacity * sizeof(int));
+    v->free_records = malloc((size_t)max_devices * sizeof(int));
+    v->pending = calloc((size_t)max_pending, sizeof(PendingChallenge));
+    if (!v->devices || !v->index || !v->free_records || !v->pending) {
+        auth_verifier_destroy(v);
+        return NULL;
+    }
+    memset(v->index, 0xff, capacity * sizeof(int));   // all -1
+    v->mask = capacity - 1;
+    v->max_devices = max_devices;
+    v->max_pending = max_pending;
+    for (int p = 0; p < max_pending; p++) {
+        v->pending[p].device = -1;
+        v->pending[p].next = p + 1 < max_pending ? p + 1 : -1;
+    }
+    v->free_head = 0;
+    for (int s = 0; s < AUTH_VERIFIER_WHEEL_SLOTS; s++) v->wheel[s] = -1;
+    v->timeout = timeout_sec;
+    v->revision = revision;
+    v->pool = pool;
+    v->rng = rng_seed;
+    auth_tables_ensure();
+    return v;
+}
+
+void auth_verifier_destroy(AuthVerifier* v) {
+    if (!v) return;
+    auth_verifier_stop_refill(v);
+    if (v->store) auth_store_reader_leave(v->store, v->store_reader);
+    free(v->devices);
+    free(v->index);
+    free(v->free_records);
+    free(v->pending);
+    free(v);
+}
+
+// ============================================================================
+// ISSUE / CHECK
+// ============================================================================
+
+static uint32_t next_challenge_id(AuthVerifier* v) {
+    return (uint32_t)auth_splitmix64(&v->rng);
+}
+
+int auth_verifier_issue(AuthVerifier* v, AuthIssueRequest* requests, int count, uint32_t now) {
+    auth_verifier_expire(v, now);
+    int issued = 0;
+    for (int base = 0; base < count; base += VERIFIER_CHUNK) {
+        int n = count - base < VERIFIER_CHUNK ? count - base : VERIFIER_CHUNK;
+        int m = 0, hits = 0;
+        if (v->store) {
+            for (int i = 0; i < n; i++) v->ids[i] = requests[base + i].device_id;
+            store_lookup(v, v->ids, n);
+        }
+        for (int i = 0; i < n; i++) {
+            AuthIssueRequest* r = &requests[base + i];
+            uint64_t hash = hash_id(r->device_id);
+            int dev = find_device(v, r->device_id, hash);
+            if (v->store) {
+                if (!v->store_found[i]) {
+                    r->status = AUTH_VERIFY_UNKNOWN_DEVICE;
+                    continue;
+                }
+                dev = track_device(v, r->device_id, hash, dev, &v->store_secrets[i],
+                                   v->store_profiles[i]);
+                if (dev < 0) {
+                    r->status = AUTH_VERIFY_BUSY;
+                    continue;
+                }
+            }
+            if (dev < 0) {
+                r->status = AUTH_VERIFY_UNKNOWN_DEVICE;
+                continue;
+            }
+            DeviceSlot* d = &v->devices[dev];
+            if (d->pending >= AUTH_VERIFIER_MAX_PENDING ||
+                v->n_pending + m + hits >= v->max_pending) {
+                r->status = AUTH_VERIFY_BUSY;
+                continue;
+            }
+            d->pending++;   // reserved, so a device twice in one batch still hits the cap
+
+            // O(1) path: a pair the refill thread computed ahead of time
+            const RingEntry* e = v->refilling ? ring_pop(v, d) : NULL;
+            if (e) {
+                r->challenge_id = e->challenge_id;
+                memcpy(r->challenge, e->challenge, sizeof(r->challenge));
+                r->challenge_length = d->profile->challenge_length;
+                v->hit_expected[hits] = e->expected;
+                v->hit_owner[hits] = base + i;
+                v->hit_device[hits] = dev;
+                hits++;
+                ring_release(v, d);
+                continue;
+            }
+            if (v->refilling) {
+                v->stats.ring_misses++;
+                refill_request(v, d->ring);
+            }
+
+            r->challenge_id = next_challenge_id(v);
+            // Always CHALLENGE_LENGTH values; a shorter profile uses the prefix
+            auth_challenge_from_id(r->challenge_id, r->challenge, CHALLENGE_LENGTH);
+            r->challenge_length = d->profile->challenge_length;
+            memcpy(&v->challenges[m * CHALLENGE_LENGTH], r->challenge, sizeof(r->challenge));
+            v->secrets[m] = d->secret;
+            v->profiles[m] = d->profile;
+            v->owner[m] = base + i;
+            v->device[m] = dev;
+            m++;
+        }
+        if (m > 0) {
+            compute_expected(v->pool, v->revision, v->challenges, v->secrets, v->profiles, m,
+                             v->expected, &v->group);
+        }
+        // Queue in request order, merging ring hits with computed lanes, so
+        // a device's challenges are checked in the order they were sent
+        for (int j = 0, h = 0; j < m || h < hits;) {
+            int from_ring = j == m || (h < hits && v->hit_owner[h] < v->owner[j]);
+            int owner = from_ring ? v->hit_owner[h] : v->owner[j];
+            int dev = from_ring ? v->hit_device[h] : v->device[j];
+            int p = pending_alloc(v, dev, now + (uint32_t)v->timeout);
+            v->pending[p].expected = from_ring ? v->hit_expected[h++] : v->expected[j++];
+            requests[owner].status = AUTH_VERIFY_OK;
+        }
+        issued += m + hits;
+        v->stats.ring_hits += (uint64_t)hits;
+    }
+    v->stats.issued += (uint64_t)issued;
+    return issued;
+}
+
+// Statuses and stats for n screened requests; returns ok_count
+static int record_checks(AuthVerifier* v, AuthCheckRequest* requests, const int* owner, int n,
+                         int ok_count, const uint64_t* match) {
+    for (int j = 0; j < n; j++) {
+        int ok = (int)(match[j / 64] >> (j % 64)) & 1;
+        requests[owner[j]].status = ok ? AUTH_VERIFY_OK : AUTH_VERIFY_REJECTED;
+    }
+    v->stats.verified += (uint64_t)ok_count;
+    v->stats.rejected += (uint64_t)(n - ok_count);
+    return ok_count;
+}
+
+int auth_verifier_check(AuthVerifier* v, AuthCheckRequest* requests, int count, uint32_t now) {
+    auth_verifier_expire(v, now);
+    int accepted = 0;
+    uint64_t match[VERIFIER_CHUNK / 64];
+    for (int base = 0; base < count; base += VERIFIER_CHUNK) {
+        int n = count - base < VERIFIER_CHUNK ? count - base : VERIFIER_CHUNK;
+        int m = 0, mq = 0;
+        if (v->store) {
+            for (int i = 0; i < n; i++) v->ids[i] = requests[base + i].device_id;
+            store_lookup(v, v->ids, n);
+        }
+        for (int i = 0; i < n; i++) {
+            AuthCheckRequest* r = &requests[base + i];
+            int dev = find_device(v, r->device_id, hash_id(r->device_id));
+            if (v->store && !v->store_found[i]) {
+                r->status = AUTH_VERIFY_UNKNOWN_DEVICE;
+                continue;
+            }
+            if (dev < 0) {
+                // In the store but not tracked: never challenged, or evicted
+                r->status = v->store ? AUTH_VERIFY_NO_CHALLENGE : AUTH_VERIFY_UNKNOWN_DEVICE;
+                continue;
+            }
+            int p = v->devices[dev].head;
+            if (p < 0) {
+                r->status = AUTH_VERIFY_NO_CHALLENGE;
+                continue;
+            }
+            AuthResponse expected = v->pending[p].expected;
+            pending_free(v, p);   // one attempt per challenge
+            int quantized_ok = v->store ? (v->store_found[i] & AUTH_STORE_QUANTIZED) != 0
+                                        : v->devices[dev].quantized;
+            if (r->quantized && !quantized_ok) {
+                // The coarser check only for devices that opted in
+                r->status = AUTH_VERIFY_REJECTED;
+                v->stats.rejected++;
+                continue;
+            }
+            if (r->quantized) {
+                v->expected_i16[mq] = auth_response_to_i16(&expected);
+                v->received_i16[mq] = r->response_i16;
+                v->owner_i16[mq++] = base + i;
+                continue;
+            }
+            v->expected[m] = expected;
+            v->received[m] = r->response;
+
+            // Channels the client did not send compare equal
+            int channels = r->channels < 1 ? 1 : r->channels > 8 ? 8 : r->channels;
+            float* e = (float*)&v->expected[m];
+            float* got = (float*)&v->received[m];
+            for (int c = channels; c < 8; c++) e[c] = got[c] = 0.0f;
+            v->owner[m++] = base + i;
+        }
+        if (m > 0) {
+            int ok_count = auth_verify_batch(v->received, v->expected, 1, m,
+                                             AUTH_VERIFIER_TOLERANCE, match);
+            accepted += record_checks(v, requests, v->owner, m, ok_count, match);
+        }
+        if (mq > 0) {
+            int ok_count = auth_verify_batch_i16(v->received_i16, v->expected_i16, 1, mq,
+                                                 AUTH_I16_TOLERANCE, match);
+            accepted += record_checks(v, requests, v->owner_i16, mq, ok_count, match);
+        }
+    }
+    return accepted;
+}
+
+AuthVerifierStats auth_verifier_stats(const AuthVerifier* v) {
+    AuthVerifierStats s = v->stats;
+    s.devices = v->n_devices;
+    s.pending = v->n_pending;
+    s.ring_ready = 0;
+    for (int ring = 0; v->refilling && ring < v->n_records; ring++) {
+        s.ring_ready += (int)ring_count(&v->rings[ring]);
+    }
+    return s;
+}
+
+const char* auth_verify_status_name(AuthVerifyStatus status) {
+    switch (status) {
+    case AUTH_VERIFY_OK: return "AUTH_SUCCESS";
+    case AUTH_VERIFY_REJECTED: return "INVALID_RESPONSE";
+    case AUTH_VERIFY_UNKNOWN_DEVICE: return "UNKNOWN_DEVICE";
+    case AUTH_VERIFY_NO_CHALLENGE: return "UNKNOWN_CHALLENGE";
+    case AUTH_VERIFY_BUSY: return "TOO_MANY_PENDING";
+    }
+    return "?";
+}
@@ -0,0 +1,131 @@
+// auth_verifier.h
+// Verification core of the C authentication server
+//
+// The device registry and pending-challenge bookkeeping of the Python
+// AuthServer, without the sockets:
+//   - device records (secret, profile, pending queue) indexed by an
+//     open-addressing (linear probing) hash table
+//   - pending challenges in a fixed pool, queued per device oldest first
+//   - expiry on a one-second timer wheel (Challenge.is_expired)
+//   - expected responses for a whole batch of issued challenges in one
+//     batch-engine call (or spread over an AuthPool), and received
+//     responses screened with auth_verify_batch(), or quantized ones
+//     (AuthResponseI16) with auth_verify_batch_i16() against the expected
+//     response quantized the same way - only from devices allowed to
+//     send them, since that check is far looser
+//   - a profile per device (auth_compute_response_ex()): a batch with
+//     several profiles takes one engine call per profile
+//   - optionally, per-device rings of precomputed (challenge, expected)
+//     pairs kept full by an idle-priority thread, so issuing is an O(1)
+//     pop instead of an engine call
+//   - optionally, the registry in a shared AuthStore: the table then
+//     tracks only devices with recent challenges, and secrets are read
+//     from the store on every issue, so a store reload applies at once
+// Nothing is allocated after creation (or after starting the refill
+// thread). Not thread-safe: one verifier per event loop.
+
+#ifndef AUTH_VERIFIER_H
+#define AUTH_VERIFIER_H
+
+#include "physics_auth.h"
+#include "auth_pool.h"
+#include "auth_store.h"
+
+#define AUTH_VERIFIER_MAX_ID 63          // device id bytes
+#define AUTH_VERIFIER_MAX_PENDING 4      // outstanding challenges per device
+#define AUTH_VERIFIER_WHEEL_SLOTS 64     // timeout must stay below this many seconds
+#define AUTH_VERIFIER_TOLERANCE 1e-5f    // JSON responses carry 6 decimals
+
+typedef struct AuthVerifier AuthVerifier;
+
+typedef enum {
+    AUTH_VERIFY_OK = 0,
+    AUTH_VERIFY_REJECTED,         // wrong response; the challenge is used up
+    AUTH_VERIFY_UNKNOWN_DEVICE,
+    AUTH_VERIFY_NO_CHALLENGE,     // nothing pending: expired, replayed or never issued
+    AUTH_VERIFY_BUSY              // AUTH_VERIFIER_MAX_PENDING already outstanding
+} AuthVerifyStatus;
+
+typedef struct {
+    const char* device_id;
+    uint32_t challenge_id;             // out
+    float challenge[CHALLENGE_LENGTH]; // out
+    int challenge_length;              // out: entries in use, the device profile's
+    AuthVerifyStatus status;           // out
+} AuthIssueRequest;
+
+typedef struct {
+    const char* device_id;
+    AuthResponse response;
+    int channels;                      // leading channels sent: 4 (JSON) or 8 (binary)
+    int quantized;                     // response_i16 sent instead, all 8 channels
+    AuthResponseI16 response_i16;
+    AuthVerifyStatus status;           // out
+} AuthCheckRequest;
+
+typedef struct {
+    uint64_t issued;
+    uint64_t verified;
+    uint64_t rejected;
+    uint64_t expired;
+    uint64_t ring_hits;            // issued from a precompute ring
+    uint64_t ring_misses;          // ring empty, computed inline
+    uint64_t evicted;              // store mode: idle devices dropped to track new ones
+    int devices;
+    int pending;
+    int ring_ready;                // precomputed pairs waiting in the rings
+} AuthVerifierStats;
+
+// pool may be NULL (batch engine on the calling thread). rng_seed seeds
+// the challenge ids; take it from a system entropy source.
+AuthVerifier* auth_verifier_create(int max_devices, int max_pending, int timeout_sec,
+                                   int revision, AuthPool* pool, uint64_t rng_seed);
+void auth_verifier_destroy(AuthVerifier* v);
+
+// Add or replace a device; 0 if the id is too long or the table is full
+int auth_verifier_register(AuthVerifier* v, const char* device_id, const AuthSecret* secret);
+// The same with the device's profile (register() uses "default"). The
+// profile is referenced, not copied: it must outlive the verifier, as the
+// presets do. 0 also for an invalid profile.
+int auth_verifier_register_profile(AuthVerifier* v, const char* device_id,
+                                   const AuthSecret* secret, const AuthProfile* profile);
+
+// Accept quantized responses from a registered device (allow = 1), which
+// verifies them to within AUTH_I16_TOLERANCE steps - up to ~2e-3 on the
+// Lorenz channels instead of AUTH_VERIFIER_TOLERANCE. Any other device's
+// quantized response is rejected, whatever the request claims. New and
+// re-created records start disallowed. 0 if the device is unknown. In
+// store mode the store's AUTH_STORE_QUANTIZED flag decides instead.
+int auth_verifier_allow_quantized(AuthVerifier* v, const char* device_id, int allow);
+
+// Take the registry from store instead of auth_verifier_register(). A
+// device is tracked (pending queue, precompute ring) from its first
+// challenge; with max_devices tracked, a new one evicts an idle device
+// (clock order), or gets AUTH_VERIFY_BUSY if none is idle. A device
+// missing from the store is unknown even if tracked. The verifier joins
+// store as a reader (destroy leaves). 0 if no reader slot is free or a
+// store is attached already.
+int auth_verifier_attach_store(AuthVerifier* v, AuthStore* store);
+
+// Issue one challenge per request, at time now (seconds, monotonic).
+// Returns the number issued.
+int auth_verifier_issue(AuthVerifier* v, AuthIssueRequest* requests, int count, uint32_t now);
+
+// Check each response against its device's oldest pending challenge,
+// consuming it either way. Returns the number accepted.
+int auth_verifier_check(AuthVerifier* v, AuthCheckRequest* requests, int count, uint32_t now);
+
+// Start the background refill thread with ring_depth precomputed pairs
+// per device (max_devices x ring_depth x ~240 bytes). The rings of all
+// registered devices start filling at once; re-registering a device
+// discards its pairs. Returns 0 if already running or out of memory.
+int auth_verifier_start_refill(AuthVerifier* v, int ring_depth);
+void auth_verifier_stop_refill(AuthVerifier* v);   // also done by destroy
+
+// Drop challenges that expired by now (issue/check already do this)
+void auth_verifier_expire(AuthVerifier* v, uint32_t now);
+
+AuthVerifierStats auth_verifier_stats(const AuthVerifier* v);
+const char* auth_verify_status_name(AuthVerifyStatus status);
+
+#endif // AUTH_VERIFIER_H
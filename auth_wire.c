@@ -0,0 +1,147 @@
+// auth_wire.c
+// Compact binary challenge/response frames (see auth_wire.h)
+
+#include "auth_wire.h"
+#include <string.h>
+
+// ============================================================================
+// LITTLE-ENDIAN FIELDS
+// ============================================================================
+
+static void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void put_f32(uint8_t* p, float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static float get_f32(const uint8_t* p) {
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+                 ((uint32_t)p[3] << 24);
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+// ============================================================================
+// FRAMES
+// ============================================================================
+
+size_t auth_wire_encode_challenge(const float* challenge, int length, uint8_t* out, size_t cap) {
+    if (length < 0 || length > AUTH_WIRE_MAX_CHALLENGE) return 0;
+    size_t size = AUTH_WIRE_CHALLENGE_SIZE(length);
+    if (size > cap) return 0;
+    put_u16(out, (uint16_t)length);
+    for (int i = 0; i < length; i++) put_f32(out + 2 + 4 * i, challenge[i]);
+    return size;
+}
+
+int auth_wire_decode_challenge(const uint8_t* in, size_t size, float* out, int max_length) {
+    if (size < 2) return -1;
+    int length = get_u16(in);
+    if (length > max_length || size != AUTH_WIRE_CHALLENGE_SIZE(length)) return -1;
+    for (int i = 0; i < length; i++) out[i] = get_f32(in + 2 + 4 * i);
+    return length;
+}
+
+size_t auth_wire_encode_response(const AuthResponse* resp, const char* device_id, uint8_t* out,
+                                 size_t cap) {
+    size_t id_length = strlen(device_id);
+    if (id_length > AUTH_WIRE_MAX_DEVICE_ID) return 0;
+    size_t size = AUTH_WIRE_RESPONSE_SIZE(id_length);
+    if (size > cap) return 0;
+    const float* v = (const float*)resp;
+    for (int c = 0; c < 8; c++) put_f32(out + 4 * c, v[c]);
+    out[32] = (uint8_t)id_length;
+    memcpy(out + 33, device_id, id_length);
+    return size;
+}
+
+int auth_wire_decode_response(const uint8_t* in, size_t size, AuthResponse* resp,
+                              char* device_id, size_t id_cap) {
+    if (size < AUTH_WIRE_RESPONSE_SIZE(0)) return 0;
+    size_t id_length = in[32];
+    if (size != AUTH_WIRE_RESPONSE_SIZE(id_length) || id_length >= id_cap) return 0;
+    float* v = (float*)resp;
+    for (int c = 0; c < 8; c++) v[c] = get_f32(in + 4 * c);
+    memcpy(device_id, in + 33, id_length);
+    device_id[id_length] = '\0';
+    return 1;
+}
+
+size_t auth_wire_encode_response_i16(const AuthResponseI16* resp, const char* device_id,
+                                     uint8_t* out, size_t cap) {
+    size_t id_length = strlen(device_id);
+    if (id_length > AUTH_WIRE_MAX_DEVICE_ID) return 0;
+    size_t size = AUTH_WIRE_RESPONSE_I16_SIZE(id_length);
+    if (size > cap) return 0;
+    const int16_t* v = (const int16_t*)resp;
+    for (int c = 0; c < 8; c++) put_u16(out + 2 * c, (uint16_t)v[c]);
+    out[16] = (uint8_t)id_length;
+    memcpy(out + 17, device_id, id_length);
+    return size;
+}
+
+int auth_wire_decode_response_i16(const uint8_t* in, size_t size, AuthResponseI16* resp,
+                                  char* device_id, size_t id_cap) {
+    if (size < AUTH_WIRE_RESPONSE_I16_SIZE(0)) return 0;
+    size_t id_length = in[16];
+    if (size != AUTH_WIRE_RESPONSE_I16_SIZE(id_length) || id_length >= id_cap) return 0;
+    int16_t* v = (int16_t*)resp;
+    for (int c = 0; c < 8; c++) v[c] = (int16_t)get_u16(in + 2 * c);
+    memcpy(device_id, in + 17, id_length);
+    device_id[id_length] = '\0';
+    return 1;
+}
+
+// ============================================================================
+// INCREMENTAL DECODER
+// ============================================================================
+
+void auth_wire_reader_init(AuthWireReader* reader) {
+    reader->length = -1;
+    reader->received = 0;
+    reader->partial_len = 0;
+}
+
+int auth_wire_reader_feed(AuthWireReader* reader, const uint8_t* data, size_t size, float* out,
+                          int max_length) {
+    int completed = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (reader->length < 0) {
+            reader->partial[reader->partial_len++] = data[i++];
+            if (reader->partial_len == 2) {
+                reader->length = get_u16(reader->partial);
+                reader->partial_len = 0;
+                if (reader->length > max_length) return -1;
+            }
+            continue;
+        }
+        if (reader->received == reader->length) return -1;
+
+        // Whole floats straight from the buffer, split ones via partial
+        if (reader->partial_len == 0 && size - i >= 4) {
+            out[reader->received++] = get_f32(data + i);
+            i += 4;
+        } else {
+            reader->partial[reader->partial_len++] = data[i++];
+            if (reader->partial_len < 4) continue;
+            out[reader->received++] = get_f32(reader->partial);
+            reader->partial_len = 0;
+        }
+        completed++;
+    }
+    return completed;
+}
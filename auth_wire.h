@@ -0,0 +1,70 @@
+// auth_wire.h
+// Compact binary challenge/response frames
+//
+// The binary alternative to the JSON bodies, for constrained clients:
+//   challenge: u16 count, then count float32 perturbations
+//   response:  8 float32 (AuthResponse order), u8 id length, device id bytes
+//   quantized response: 8 int16 (AuthResponseI16), u8 id length, device id
+//              bytes - 17 bytes plus the id instead of 33, sent as
+//              AUTH_WIRE_CONTENT_TYPE_I16
+// All integers and floats are little-endian whatever the host. Floats are
+// sent as their bit patterns, so a response survives the trip bit-exact.
+// Nothing here allocates.
+
+#ifndef AUTH_WIRE_H
+#define AUTH_WIRE_H
+
+#include <stddef.h>
+#include "physics_auth.h"
+
+#define AUTH_WIRE_CONTENT_TYPE "application/x-physics-auth"
+#define AUTH_WIRE_CONTENT_TYPE_I16 "application/x-physics-auth-i16"   // starts like the other
+#define AUTH_WIRE_MAX_CHALLENGE 65535
+#define AUTH_WIRE_MAX_DEVICE_ID 255
+
+#define AUTH_WIRE_CHALLENGE_SIZE(length) (2 + 4 * (size_t)(length))
+#define AUTH_WIRE_RESPONSE_SIZE(id_length) (8 * 4 + 1 + (size_t)(id_length))
+#define AUTH_WIRE_RESPONSE_I16_SIZE(id_length) (8 * 2 + 1 + (size_t)(id_length))
+
+// Encoders return the frame size, or 0 if it does not fit in cap (or the
+// length / device id is out of range)
+size_t auth_wire_encode_challenge(const float* challenge, int length, uint8_t* out, size_t cap);
+size_t auth_wire_encode_response(const AuthResponse* resp, const char* device_id, uint8_t* out,
+                                 size_t cap);
+size_t auth_wire_encode_response_i16(const AuthResponseI16* resp, const char* device_id,
+                                     uint8_t* out, size_t cap);
+
+// Decode a complete frame. The challenge decoder returns the entry count,
+// or -1 if the frame is truncated, has trailing bytes or holds more than
+// max_length entries. The response decoders NUL-terminate device_id and
+// return 0 on the same errors or if the id does not fit in id_cap.
+int auth_wire_decode_challenge(const uint8_t* in, size_t size, float* out, int max_length);
+int auth_wire_decode_response(const uint8_t* in, size_t size, AuthResponse* resp,
+                              char* device_id, size_t id_cap);
+int auth_wire_decode_response_i16(const uint8_t* in, size_t size, AuthResponseI16* resp,
+                                  char* device_id, size_t id_cap);
+
+// Incremental challenge decoder for frames that arrive in pieces (a
+// network read callback). length is -1 until the count header is in.
+typedef struct {
+    int length;
+    int received;                  // entries decoded so far
+    uint8_t partial[4];            // bytes of a header or float split across reads
+    int partial_len;
+} AuthWireReader;
+
+void auth_wire_reader_init(AuthWireReader* reader);
+
+// Decode the next size bytes, appending completed entries to out (which
+// holds max_length entries in total, indexed by reader->received). Returns
+// the number of entries completed by this call, or -1 if the frame is
+// longer than max_length or continues past its last entry.
+int auth_wire_reader_feed(AuthWireReader* reader, const uint8_t* data, size_t size, float* out,
+                          int max_length);
+
+// Whole frame decoded
+static inline int auth_wire_reader_done(const AuthWireReader* reader) {
+    return reader->length >= 0 && reader->received == reader->length;
+}
+
+#endif // AUTH_WIRE_H
@@ -0,0 +1,163 @@
+// auth_bench.c
+// Latency and throughput of every engine variant
+//
+// Usage: auth_bench [-j out.json] [-n repetitions] [-c cpu]
+//   -j  also write the results as JSON (for tracking across releases)
+//   -n  timed samples per variant (default 2000)
+//   -c  CPU to pin to (default 0, -1 = no pinning)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "physics_auth.h"
+#include "bench_harness.h"
+
+#define BATCH_SECRETS 64
+#define VERIFY_PAIRS 1024
+#define MAX_RESULTS 32
+
+typedef struct {
+    float challenge[CHALLENGE_LENGTH];
+    AuthSecret secrets[BATCH_SECRETS];
+    AuthResponse responses[BATCH_SECRETS];
+    AuthResponse received[VERIFY_PAIRS];
+    AuthResponse expected[VERIFY_PAIRS];
+    int revision;
+    int next;            // rotates the secret so no call repeats the last one
+    volatile float sink;
+} BenchContext;
+
+static void run_single(void* p) {
+    BenchContext* ctx = p;
+    AuthResponse r;
+    auth_compute_response_rev(ctx->challenge, CHALLENGE_LENGTH,
+                              &ctx->secrets[ctx->next++ % BATCH_SECRETS], ctx->revision, &r);
+    ctx->sink += r.psi;
+}
+
+static void run_batch(void* p) {
+    BenchContext* ctx = p;
+    auth_compute_response_batch_rev(ctx->challenge, CHALLENGE_LENGTH, 0, ctx->secrets,
+                                    BATCH_SECRETS, ctx->revision, ctx->responses);
+    ctx->sink += ctx->responses[0].psi;
+}
+
+static void run_fixed(void* p) {
+    BenchContext* ctx = p;
+    AuthResponse r = auth_compute_response_fixed(ctx->challenge, CHALLENGE_LENGTH,
+                                                 &ctx->secrets[ctx->next++ % BATCH_SECRETS]);
+    ctx->sink += r.psi;
+}
+
+static void run_verify_batch(void* p) {
+    BenchContext* ctx = p;
+    ctx->sink += (float)auth_verify_batch(ctx->received, ctx->expected, 1, VERIFY_PAIRS,
+                                          0.0001f, NULL);
+}
+
+#if AUTH_INSTRUMENT
+// Where a step's cycles go, per revision (needs -DAUTH_INSTRUMENT=1)
+static void print_phases(BenchContext* ctx) {
+    printf("\nPer-phase cost of evolve_step\n");
+    for (int rev = AUTH_ENGINE_REV_1; rev <= AUTH_ENGINE_REV_LATEST; rev++) {
+        ctx->revision = rev;
+        auth_phase_stats_reset();
+        for (int i = 0; i < 200; i++) run_single(ctx);
+        AuthPhaseStats stats = auth_phase_stats();
+        uint64_t total = 0;
+        for (int p = 0; p < AUTH_PHASE_COUNT; p++) total += stats.cycles[p];
+        printf("  rev%d:", rev);
+        for (int p = 0; p < AUTH_PHASE_COUNT; p++) {
+            printf("  %s %.0f (%.0f%%)", auth_phase_name((AuthPhase)p),
+                   (double)stats.cycles[p] / (double)stats.steps,
+                   100.0 * (double)stats.cycles[p] / (double)total);
+        }
+        printf("  per step\n");
+    }
+}
+#endif
+
+int main(int argc, char** argv) {
+    const char* json_path = NULL;
+    BenchConfig cfg = {20, 2000, 0};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-j") == 0) json_path = argv[i + 1];
+        else if (strcmp(argv[i], "-n") == 0) cfg.repetitions = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-c") == 0) cfg.pin_cpu = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Usage: %s [-j out.json] [-n repetitions] [-c cpu]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    auth_init();
+    if (cfg.pin_cpu >= 0 && !bench_pin_cpu(cfg.pin_cpu)) cfg.pin_cpu = -1;
+
+    static BenchContext ctx;
+    auth_challenge_from_id(1, ctx.challenge, CHALLENGE_LENGTH);
+    for (int s = 0; s < BATCH_SECRETS; s++) {
+        ctx.secrets[s].k = 0.5f + 0.07f * (float)s;
+        ctx.secrets[s].gamma = 0.2f + 0.01f * (float)s;
+        ctx.secrets[s].seed = 12345u + 7919u * (uint32_t)s;
+    }
+    for (int n = 0; n < VERIFY_PAIRS; n++) {
+        ctx.expected[n] = auth_compute_response(ctx.challenge, CHALLENGE_LENGTH,
+                                                &ctx.secrets[n % BATCH_SECRETS]);
+        ctx.received[n] = ctx.expected[n];
+        if (n & 1) ctx.received[n].psi += 0.01f;
+    }
+
+    static BenchStats results[MAX_RESULTS];
+    static char names[MAX_RESULTS][48];
+    int count = 0;
+    AuthSimdBackend saved = auth_simd_active();
+    AuthSimdBackend backends[] = {AUTH_SIMD_SCALAR, AUTH_SIMD_SSE2, AUTH_SIMD_AVX2, AUTH_SIMD_NEON};
+
+    printf("PhysicsAuth benchmark (%d samples per variant, %s)\n", cfg.repetitions,
+           cfg.pin_cpu >= 0 ? "pinned" : "unpinned");
+    for (int rev = AUTH_ENGINE_REV_1; rev <= AUTH_ENGINE_REV_LATEST; rev++) {
+        ctx.revision = rev;
+        for (int b = 0; b < 4; b++) {
+            if (!auth_simd_select(backends[b])) continue;
+            snprintf(names[count], sizeof(names[count]), "rev%d/single/%s", rev,
+                     auth_simd_name(backends[b]));
+            results[count] = bench_run(names[count], run_single, &ctx, 1, &cfg);
+            bench_print(&results[count++]);
+        }
+        auth_simd_select(saved);
+
+        // A batch call is 64 responses; fewer samples keep the runtime flat
+        BenchConfig batch_cfg = cfg;
+        batch_cfg.repetitions = cfg.repetitions / 16 > 10 ? cfg.repetitions / 16 : 10;
+        snprintf(names[count], sizeof(names[count]), "rev%d/batch", rev);
+        results[count] = bench_run(names[count], run_batch, &ctx, BATCH_SECRETS, &batch_cfg);
+        bench_print(&results[count++]);
+    }
+
+    results[count] = bench_run("fixed/single", run_fixed, &ctx, 1, &cfg);
+    bench_print(&results[count++]);
+    results[count] = bench_run("verify_batch", run_verify_batch, &ctx, VERIFY_PAIRS, &cfg);
+    bench_print(&results[count++]);
+
+#if AUTH_INSTRUMENT
+    print_phases(&ctx);
+#endif
+
+    if (json_path) {
+        FILE* out = fopen(json_path, "w");
+        if (!out) {
+            perror(json_path);
+            return 1;
+        }
+        char meta[256];
+        snprintf(meta, sizeof(meta),
+                 "\"challenge_length\": %d, \"simd\": \"%s\", \"deterministic\": %d, "
+                 "\"constant_time\": %d, \"fixed_point\": %d, \"instrumented\": %d, \"pinned\": %d",
+                 CHALLENGE_LENGTH, auth_simd_name(saved), AUTH_DETERMINISTIC, AUTH_CONSTANT_TIME,
+                 AUTH_FIXED_POINT, AUTH_INSTRUMENT, cfg.pin_cpu >= 0);
+        bench_write_json(out, meta, results, count);
+        fclose(out);
+        printf("Wrote %s\n", json_path);
+    }
+    return 0;
+}
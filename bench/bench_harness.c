@@ -0,0 +1,163 @@
+// bench_harness.c
+// Shared timing harness (see bench_harness.h)
+
+#define _GNU_SOURCE
+#include "bench_harness.h"
+#include "../auth_util.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// ============================================================================
+// CLOCKS
+// ============================================================================
+
+uint64_t bench_now_ns(void) {
+    return auth_now_ns();
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+const char* const BENCH_CYCLE_UNIT = "cycles";
+uint64_t bench_cycles(void) {
+    return __rdtsc();
+}
+#elif defined(__aarch64__)
+const char* const BENCH_CYCLE_UNIT = "ticks";
+uint64_t bench_cycles(void) {
+    uint64_t v;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+}
+#elif defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+// DWT cycle counter; enabled on first use (32-bit, wraps after ~9 s at 480 MHz)
+const char* const BENCH_CYCLE_UNIT = "cycles";
+#define DEMCR (*(volatile uint32_t*)0xE000EDFCu)
+#define DWT_CTRL (*(volatile uint32_t*)0xE0001000u)
+#define DWT_CYCCNT (*(volatile uint32_t*)0xE0001004u)
+uint64_t bench_cycles(void) {
+    if (!(DWT_CTRL & 1u)) {
+        DEMCR |= 1u << 24;   // TRCENA
+        DWT_CYCCNT = 0;
+        DWT_CTRL |= 1u;      // CYCCNTENA
+    }
+    return DWT_CYCCNT;
+}
+#else
+const char* const BENCH_CYCLE_UNIT = "ns";
+uint64_t bench_cycles(void) {
+    return bench_now_ns();
+}
+#endif
+
+int bench_pin_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return 0;
+#endif
+}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static uint64_t percentile(const uint64_t* sorted, int n, double p) {
+    int rank = (int)(p * n + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+BenchStats bench_stats(const char* name, uint64_t* sample_ns, int samples, int ops_per_sample) {
+    BenchStats s;
+    memset(&s, 0, sizeof(s));
+    s.name = name;
+    s.samples = samples;
+    s.ops_per_sample = ops_per_sample;
+    if (samples < 1 || ops_per_sample < 1) return s;
+
+    qsort(sample_ns, (size_t)samples, sizeof(uint64_t), cmp_u64);
+    double total = 0.0;
+    for (int i = 0; i < samples; i++) total += (double)sample_ns[i];
+
+    double ops = (double)ops_per_sample;
+    s.min_ns = (double)sample_ns[0] / ops;
+    s.mean_ns = total / samples / ops;
+    s.p50_ns = (double)percentile(sample_ns, samples, 0.50) / ops;
+    s.p99_ns = (double)percentile(sample_ns, samples, 0.99) / ops;
+    s.p999_ns = (double)percentile(sample_ns, samples, 0.999) / ops;
+    s.max_ns = (double)sample_ns[samples - 1] / ops;
+    s.ops_per_sec = s.p50_ns > 0.0 ? 1e9 / s.p50_ns : 0.0;
+    return s;
+}
+
+BenchStats bench_run(const char* name, BenchFn fn, void* ctx, int ops_per_sample,
+                     const BenchConfig* cfg) {
+    BenchConfig defaults = BENCH_CONFIG_DEFAULT;
+    if (!cfg) cfg = &defaults;
+    if (cfg->pin_cpu >= 0) bench_pin_cpu(cfg->pin_cpu);
+
+    for (int i = 0; i < cfg->warmup; i++) fn(ctx);
+
+    int n = cfg->repetitions > 0 ? cfg->repetitions : 1;
+    uint64_t* samples = malloc(sizeof(uint64_t) * (size_t)n);
+    if (!samples) return bench_stats(name, NULL, 0, ops_per_sample);
+    for (int i = 0; i < n; i++) {
+        uint64_t start = bench_now_ns();
+        fn(ctx);
+        samples[i] = bench_now_ns() - start;
+    }
+    BenchStats s = bench_stats(name, samples, n, ops_per_sample);
+    free(samples);
+    return s;
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+// ns with a unit that keeps 3-4 significant digits
+static void format_ns(char* buf, size_t size, double ns) {
+    if (ns >= 1e6) snprintf(buf, size, "%.2fms", ns / 1e6);
+    else if (ns >= 1e3) snprintf(buf, size, "%.2fus", ns / 1e3);
+    else snprintf(buf, size, "%.1fns", ns);
+}
+
+void bench_print(const BenchStats* s) {
+    char p50[32], p99[32], p999[32];
+    format_ns(p50, sizeof(p50), s->p50_ns);
+    format_ns(p99, sizeof(p99), s->p99_ns);
+    format_ns(p999, sizeof(p999), s->p999_ns);
+    printf("  %-28s p50 %10s  p99 %10s  p999 %10s  %12.0f ops/s\n", s->name, p50, p99, p999,
+           s->ops_per_sec);
+}
+
+void bench_write_json(FILE* out, const char* meta_json, const BenchStats* stats, int count) {
+    fprintf(out, "{\n  \"meta\": {%s},\n  \"results\": [\n", meta_json ? meta_json : "");
+    for (int i = 0; i < count; i++) {
+        const BenchStats* s = &stats[i];
+        fprintf(out,
+                "    {\"name\": \"%s\", \"samples\": %d, \"ops_per_sample\": %d, "
+                "\"min_ns\": %.1f, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p99_ns\": %.1f, "
+                "\"p999_ns\": %.1f, \"max_ns\": %.1f, \"ops_per_sec\": %.1f}%s\n",
+                s->name, s->samples, s->ops_per_sample, s->min_ns, s->mean_ns, s->p50_ns,
+                s->p99_ns, s->p999_ns, s->max_ns, s->ops_per_sec, i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
@@ -0,0 +1,67 @@
+// bench_harness.h
+// Shared timing harness for the benchmark, test and validation programs
+//
+// One clock, one way of sampling: warm up, time each repetition on its own,
+// then report the distribution (p50/p99/p999) instead of a single mean, so
+// preemption and frequency changes show up as tail rather than as a shifted
+// average. Results can be emitted as JSON to track regressions across
+// releases.
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Monotonic wall clock in nanoseconds
+uint64_t bench_now_ns(void);
+
+// Cheapest cycle-like counter of the platform (TSC on x86, the generic
+// timer on AArch64, DWT CYCCNT on Cortex-M; nanoseconds elsewhere).
+// BENCH_CYCLE_UNIT names its unit.
+uint64_t bench_cycles(void);
+extern const char* const BENCH_CYCLE_UNIT;
+
+// Pin the calling thread to one CPU. Returns 0 where unsupported.
+int bench_pin_cpu(int cpu);
+
+typedef struct {
+    int warmup;          // untimed calls before sampling
+    int repetitions;     // timed samples
+    int pin_cpu;         // CPU to pin to, -1 = leave the scheduler alone
+} BenchConfig;
+
+#define BENCH_CONFIG_DEFAULT {10, 1000, -1}
+
+// Latency per operation in nanoseconds; one sample may cover several
+// operations (a batch call), which ops_per_sample divides out
+typedef struct {
+    const char* name;
+    int samples;
+    int ops_per_sample;
+    double min_ns;
+    double mean_ns;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+    double ops_per_sec;  // from the median
+} BenchStats;
+
+typedef void (*BenchFn)(void* ctx);
+
+// Time fn(ctx) cfg->repetitions times after cfg->warmup untimed calls
+BenchStats bench_run(const char* name, BenchFn fn, void* ctx, int ops_per_sample,
+                     const BenchConfig* cfg);
+
+// Summarize samples the caller timed itself (sorts the array in place)
+BenchStats bench_stats(const char* name, uint64_t* sample_ns, int samples, int ops_per_sample);
+
+// One aligned line: name, p50, p99, p999, throughput
+void bench_print(const BenchStats* stats);
+
+// {"meta": {...}, "results": [...]} with one object per BenchStats.
+// meta_json is spliced in verbatim (without braces), may be NULL.
+void bench_write_json(FILE* out, const char* meta_json, const BenchStats* stats, int count);
+
+#endif // BENCH_HARNESS_H
@@ -3,9 +3,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+#include <strings.h>
 #include <curl/curl.h>
 #include "physics_auth.h"
+#include "auth_telemetry.h"
+#include "auth_wire.h"
 
 #define SERVER_URL "http://localhost:5000"
 #define SECRET_FILE "/etc/physics_auth/secret.conf"
@@ -22,64 +24,389 @@ AuthSecret load_secret(const char* filepath) {
     return secret;
 }
 
-// Parse challenge from server response
-int parse_challenge(const char* json, float* challenge, int* length) {
-    // Simple JSON parsing (in production, use a proper JSON library)
-    const char* ptr = strstr(json, "\"perturbations\":[");
-    if (!ptr) return 0;
-    
-    ptr += 17; // Skip to array start
-    *length = 0;
-    
-    while (*ptr && *length < CHALLENGE_LENGTH) {
-        challenge[*length] = atof(ptr);
-        (*length)++;
-        
-        ptr = strchr(ptr, ',');
-        if (!ptr) break;
-        ptr++;
+// ===== STREAMING CHALLENGE PARSER =====
+// Challenge bodies are either binary frames (auth_wire.h), asked for with
+// an Accept header, or the JSON fallback
+// {"length":50,"perturbations":[1.2,0.8,...]}. Each perturbation is
+// evolved as soon as it is complete, so by the time the last byte arrives
+// almost all of the response is already computed. Keys, numbers and
+// floats may be split across network chunks; nothing is allocated.
+
+#define MAX_CHALLENGE 1024
+
+enum { STREAM_HEADER, STREAM_LENGTH, STREAM_ARRAY, STREAM_DONE, STREAM_ERROR };
+
+typedef struct {
+    AuthStream stream;
+    const AuthSecret* secret;
+    float values[MAX_CHALLENGE];   // kept for the non-streaming fallback
+    int count;
+    int declared;                  // "length" header, 0 if the server sent none
+    int state;
+    int binary;                    // server answered with AUTH_WIRE_CONTENT_TYPE
+    AuthWireReader wire;
+    char window[24];               // tail of the header text, to spot keys
+    int window_len;
+    char number[32];
+    int number_len;
+} ChallengeStream;
+
+static void challenge_stream_init(ChallengeStream* cs, const AuthSecret* secret) {
+    memset(cs, 0, sizeof(*cs));
+    cs->secret = secret;
+    cs->state = STREAM_HEADER;
+    auth_wire_reader_init(&cs->wire);
+}
+
+static int window_ends_with(const ChallengeStream* cs, const char* key) {
+    int n = (int)strlen(key);
+    return cs->window_len >= n && memcmp(cs->window + cs->window_len - n, key, (size_t)n) == 0;
+}
+
+static void header_char(ChallengeStream* cs, char c) {
+    if (cs->window_len == (int)sizeof(cs->window)) {
+        memmove(cs->window, cs->window + 1, sizeof(cs->window) - 1);
+        cs->window_len--;
     }
-    
+    cs->window[cs->window_len++] = c;
+
+    if (window_ends_with(cs, "\"length\":")) {
+        cs->state = STREAM_LENGTH;
+        cs->number_len = 0;
+    } else if (window_ends_with(cs, "\"perturbations\":[")) {
+        // Without a header the protocol length is CHALLENGE_LENGTH
+        int length = cs->declared > 0 ? cs->declared : CHALLENGE_LENGTH;
+        cs->state = auth_stream_begin(&cs->stream, cs->secret, length, AUTH_ENGINE_REV_1)
+                        ? STREAM_ARRAY : STREAM_ERROR;
+        cs->number_len = 0;
+    }
+}
+
+static void flush_number(ChallengeStream* cs) {
+    if (cs->number_len == 0) return;
+    cs->number[cs->number_len] = '\0';
+    cs->number_len = 0;
+    if (cs->count == MAX_CHALLENGE) {
+        cs->state = STREAM_ERROR;
+        return;
+    }
+    float value = strtof(cs->number, NULL);
+    cs->values[cs->count++] = value;
+    auth_stream_feed(&cs->stream, value);  // past the band: only the fallback sees it
+}
+
+static void challenge_stream_feed(ChallengeStream* cs, const char* data, size_t n) {
+    for (size_t i = 0; i < n && cs->state < STREAM_DONE; i++) {
+        char c = data[i];
+        int numeric = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+                      c == 'e' || c == 'E';
+        switch (cs->state) {
+        case STREAM_HEADER:
+            header_char(cs, c);
+            break;
+        case STREAM_LENGTH:
+            if (c >= '0' && c <= '9' && cs->number_len < (int)sizeof(cs->number) - 1) {
+                cs->number[cs->number_len++] = c;
+            } else if (c != ' ' || cs->number_len > 0) {
+                cs->number[cs->number_len] = '\0';
+                cs->declared = atoi(cs->number);
+                cs->state = STREAM_HEADER;
+                header_char(cs, c);
+            }
+            break;
+        case STREAM_ARRAY:
+            if (numeric) {
+                if (cs->number_len == (int)sizeof(cs->number) - 1) cs->state = STREAM_ERROR;
+                else cs->number[cs->number_len++] = c;
+            } else {
+                flush_number(cs);
+                if (c == ']' && cs->state == STREAM_ARRAY) cs->state = STREAM_DONE;
+            }
+            break;
+        }
+    }
+}
+
+static void challenge_stream_feed_binary(ChallengeStream* cs, const uint8_t* data, size_t n) {
+    if (cs->state == STREAM_ERROR) return;
+    int first = cs->wire.received;
+    int got = auth_wire_reader_feed(&cs->wire, data, n, cs->values, MAX_CHALLENGE);
+    if (got < 0) {
+        cs->state = STREAM_ERROR;
+        return;
+    }
+    // The count header comes first, so it is in before any entry
+    if (cs->state == STREAM_HEADER && cs->wire.length >= 0) {
+        cs->state = auth_stream_begin(&cs->stream, cs->secret, cs->wire.length, AUTH_ENGINE_REV_1)
+                        ? STREAM_ARRAY : STREAM_ERROR;
+    }
+    for (int i = first; i < first + got && cs->state == STREAM_ARRAY; i++) {
+        auth_stream_feed(&cs->stream, cs->values[i]);
+    }
+    cs->count = cs->wire.received;
+    if (cs->state == STREAM_ARRAY && auth_wire_reader_done(&cs->wire)) cs->state = STREAM_DONE;
+}
+
+// Response for the parsed challenge; 0 if the body was incomplete/invalid
+static int challenge_stream_finish(ChallengeStream* cs, AuthResponse* resp) {
+    if (cs->state != STREAM_DONE || cs->count == 0) return 0;
+#if AUTH_FIXED_POINT
+    // The fixed engine has no streaming path
+    *resp = auth_compute_response(cs->values, cs->count, cs->secret);
+    return 1;
+#else
+    if (auth_stream_finish(&cs->stream, resp)) return 1;
+    // Count outside the declared length's band: evolve again from scratch
+    *resp = auth_compute_response(cs->values, cs->count, cs->secret);
     return 1;
+#endif
+}
+
+static size_t challenge_write(char* data, size_t size, size_t nmemb, void* user) {
+    ChallengeStream* cs = user;
+    if (cs->binary) challenge_stream_feed_binary(cs, (const uint8_t*)data, size * nmemb);
+    else challenge_stream_feed(cs, data, size * nmemb);
+    return size * nmemb;
+}
+
+// Picks the parser from the Content-Type of the reply
+static size_t challenge_header(char* line, size_t size, size_t nitems, void* user) {
+    size_t n = size * nitems;
+    char buf[128];
+    if (n < sizeof(buf) && strncasecmp(line, "content-type:", 13) == 0) {
+        memcpy(buf, line, n);
+        buf[n] = '\0';
+        ((ChallengeStream*)user)->binary = strstr(buf, AUTH_WIRE_CONTENT_TYPE) != NULL;
+    }
+    return n;
 }
 
-// HTTP GET challenge
-char* get_challenge(const char* device_id) {
-    CURL* curl = curl_easy_init();
-    if (!curl) return NULL;
+// ===== CLIENT SESSION =====
+// One multi handle and two long-lived easy handles (challenge GET and
+// response POST) for the life of the process. libcurl keeps connections
+// alive between transfers and, over HTTP/2, multiplexes both on one
+// connection, so only the first authentication pays the TCP/TLS
+// handshake. Pipelined mode fetches the next challenge while the previous
+// response is still posting.
+
+// Wall-clock latency of each phase of an authentication
+typedef struct {
+    AuthHistogram fetch;           // challenge GET, first byte sent to last received
+    AuthHistogram compute;         // response work left after the last challenge byte
+    AuthHistogram post;            // response POST
+} ClientTelemetry;
+
+typedef struct {
+    CURLM* multi;
+    CURL* get;
+    CURL* post;
+    struct curl_slist* accept;
+    struct curl_slist* content_binary;
+    struct curl_slist* content_json;
+    struct curl_slist* content_i16;
+    const char* device_id;
+    int quantized;                 // post AuthResponseI16 frames whatever the challenge format
+    ClientTelemetry* telemetry;    // may be NULL
+    char body[AUTH_WIRE_RESPONSE_SIZE(AUTH_WIRE_MAX_DEVICE_ID) + 256];   // must outlive the POST
+} ClientSession;
+
+static void session_defaults(CURL* curl) {
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);   // wait to multiplex, not a new connection
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
+}
+
+int session_open(ClientSession* s, const char* device_id) {
+    memset(s, 0, sizeof(*s));
+    s->device_id = device_id;
+    s->multi = curl_multi_init();
+    s->get = curl_easy_init();
+    s->post = curl_easy_init();
+    if (!s->multi || !s->get || !s->post) return 0;
+    curl_multi_setopt(s->multi, CURLMOPT_PIPELINING, (long)CURLPIPE_MULTIPLEX);
     
     char url[256];
     snprintf(url, sizeof(url), "%s/challenge?device=%s", SERVER_URL, device_id);
+    s->accept = curl_slist_append(NULL, "Accept: " AUTH_WIRE_CONTENT_TYPE ", application/json;q=0.5");
+    s->content_binary = curl_slist_append(NULL, "Content-Type: " AUTH_WIRE_CONTENT_TYPE);
+    s->content_json = curl_slist_append(NULL, "Content-Type: application/json");
+    s->content_i16 = curl_slist_append(NULL, "Content-Type: " AUTH_WIRE_CONTENT_TYPE_I16);
     
-    // In production: implement proper response handling
-    // For now: placeholder
-    curl_easy_cleanup(curl);
+    session_defaults(s->get);
+    curl_easy_setopt(s->get, CURLOPT_URL, url);   // copied by libcurl
+    curl_easy_setopt(s->get, CURLOPT_HTTPHEADER, s->accept);
+    curl_easy_setopt(s->get, CURLOPT_HEADERFUNCTION, challenge_header);
+    curl_easy_setopt(s->get, CURLOPT_WRITEFUNCTION, challenge_write);
     
-    // Mock response
-    return strdup("{\"perturbations\":[1.2,0.8,2.1,...]}");
+    session_defaults(s->post);
+    curl_easy_setopt(s->post, CURLOPT_URL, SERVER_URL "/verify");
+    curl_easy_setopt(s->post, CURLOPT_POSTFIELDS, s->body);
+    return 1;
 }
 
-// HTTP POST response
-int send_response(const char* device_id, const AuthResponse* resp) {
-    CURL* curl = curl_easy_init();
-    if (!curl) return 0;
-    
-    char json[512];
-    snprintf(json, sizeof(json),
-             "{\"device_id\":\"%s\",\"psi\":%.6f,\"i\":%.6f,\"r\":%.6f,\"phi\":%.6f}",
-             device_id, resp->psi, resp->i_val, resp->r_val, resp->phi_avg);
+void session_close(ClientSession* s) {
+    if (s->get) curl_easy_cleanup(s->get);
+    if (s->post) curl_easy_cleanup(s->post);
+    if (s->multi) curl_multi_cleanup(s->multi);
+    curl_slist_free_all(s->accept);
+    curl_slist_free_all(s->content_binary);
+    curl_slist_free_all(s->content_json);
+    curl_slist_free_all(s->content_i16);
+}
+
+// Response body in the format the challenge came in, or quantized; 0 if
+// it does not fit
+static size_t session_encode(ClientSession* s, const AuthResponse* resp, int binary) {
+    if (s->quantized) {
+        AuthResponseI16 q = auth_response_to_i16(resp);
+        return auth_wire_encode_response_i16(&q, s->device_id, (uint8_t*)s->body,
+                                             sizeof(s->body));
+    }
+    if (binary) {
+        return auth_wire_encode_response(resp, s->device_id, (uint8_t*)s->body, sizeof(s->body));
+    }
+    int n = snprintf(s->body, sizeof(s->body),
+                     "{\"device_id\":\"%s\",\"psi\":%.6f,\"i\":%.6f,\"r\":%.6f,\"phi\":%.6f}",
+                     s->device_id, resp->psi, resp->i_val, resp->r_val, resp->phi_avg);
+    return n > 0 && (size_t)n < sizeof(s->body) ? (size_t)n : 0;
+}
+
+// Post resp (if not NULL) and fetch the next challenge into next (if not
+// NULL), concurrently when both are given. *posted is set when the server
+// accepted the response, *fetched when the challenge downloaded.
+int session_exchange(ClientSession* s, const AuthResponse* resp, int binary,
+                     ChallengeStream* next, int* posted, int* fetched) {
+    *posted = *fetched = 0;
+    if (resp) {
+        size_t size = session_encode(s, resp, binary);
+        if (size == 0) return 0;   // device id too long for either format
+        curl_easy_setopt(s->post, CURLOPT_POSTFIELDSIZE, (long)size);
+        curl_easy_setopt(s->post, CURLOPT_HTTPHEADER,
+                         s->quantized ? s->content_i16
+                                      : binary ? s->content_binary : s->content_json);
+        curl_multi_add_handle(s->multi, s->post);
+    }
+    if (next) {
+        curl_easy_setopt(s->get, CURLOPT_HEADERDATA, next);
+        curl_easy_setopt(s->get, CURLOPT_WRITEDATA, next);
+        curl_multi_add_handle(s->multi, s->get);
+    }
     
-    // In production: implement POST
-    curl_easy_cleanup(curl);
+    int running = 1;
+    while (running) {
+        if (curl_multi_perform(s->multi, &running) != CURLM_OK) break;
+        if (running) curl_multi_poll(s->multi, NULL, 0, 1000, NULL);
+    }
     
-    return 1; // Mock success
+    CURLMsg* msg;
+    int queued;
+    while ((msg = curl_multi_info_read(s->multi, &queued))) {
+        if (msg->msg != CURLMSG_DONE) continue;
+        if (msg->data.result != CURLE_OK) {
+            fprintf(stderr, "%s failed: %s\n", msg->easy_handle == s->post ? "POST" : "GET",
+                    curl_easy_strerror(msg->data.result));
+            continue;
+        }
+        long status = 0;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &status);
+        // libcurl times each transfer itself, so overlapping ones are apart
+        curl_off_t us = 0;
+        if (s->telemetry &&
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_TOTAL_TIME_T, &us) == CURLE_OK) {
+            auth_histogram_record(msg->easy_handle == s->post ? &s->telemetry->post
+                                                              : &s->telemetry->fetch,
+                                  (uint64_t)us * 1000u);
+        }
+        if (msg->easy_handle == s->post) *posted = status == 200;
+        else *fetched = status == 200;
+    }
+    if (resp) curl_multi_remove_handle(s->multi, s->post);
+    if (next) curl_multi_remove_handle(s->multi, s->get);
+    return 1;
+}
+
+static double now_ms(void) {
+    return (double)auth_telemetry_now_ns() / 1e6;
+}
+
+// ===== TELEMETRY EXPORT =====
+
+static void telemetry_init(ClientTelemetry* t) {
+    auth_histogram_init(&t->fetch, "auth_client_fetch_seconds", "Challenge GET latency");
+    auth_histogram_init(&t->compute, "auth_client_compute_seconds",
+                        "Response computation after the last challenge byte");
+    auth_histogram_init(&t->post, "auth_client_post_seconds", "Response POST latency");
+}
+
+// Prometheus text for node_exporter's textfile collector, replaced
+// atomically so a scrape never sees half a file
+static int telemetry_write_prometheus(const ClientTelemetry* t, const char* device_id,
+                                      const char* path) {
+    char labels[96], text[8192], tmp[512];
+    snprintf(labels, sizeof(labels), "device=\"%s\"", device_id);
+    const AuthHistogram* hs[] = {&t->fetch, &t->compute, &t->post};
+    size_t n = 0;
+    for (int i = 0; i < 3 && n < sizeof(text); i++) {
+        n += auth_histogram_prometheus(hs[i], labels, text + n, sizeof(text) - n);
+    }
+    if (n >= sizeof(text) || snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        return 0;
+    }
+    FILE* f = fopen(tmp, "w");
+    if (!f) return 0;
+    int ok = fwrite(text, 1, n, f) == n;
+    ok = fclose(f) == 0 && ok;
+    return ok && rename(tmp, path) == 0;
+}
+
+static int telemetry_send_statsd(const ClientTelemetry* t, const char* device_id,
+                                 const char* host_port) {
+    char prefix[96], payload[1400];
+    snprintf(prefix, sizeof(prefix), "%s.", device_id);
+    const AuthHistogram* hs[] = {&t->fetch, &t->compute, &t->post};
+    size_t n = 0;
+    for (int i = 0; i < 3 && n < sizeof(payload); i++) {
+        n += auth_histogram_statsd(hs[i], prefix, payload + n, sizeof(payload) - n);
+    }
+    return n < sizeof(payload) && auth_telemetry_statsd_send(host_port, payload, n);
+}
+
+static void telemetry_print(const AuthHistogram* h, const char* label) {
+    printf("  %-8s p50 %8.3f ms  p99 %8.3f ms  max %8.3f ms\n", label,
+           auth_histogram_quantile(h, 0.5) / 1e6, auth_histogram_quantile(h, 0.99) / 1e6,
+           auth_histogram_quantile(h, 1.0) / 1e6);
 }
 
+// Usage: auth_client [-n authentications] [-p] [-q] [-m metrics.prom] [-s statsd_host:port]
+//   -n  back-to-back authentications over one session (default 1)
+//   -p  pipeline: fetch the next challenge while the response posts
+//   -q  post quantized 16-bit responses (17 bytes plus the device id)
+//   -m  write fetch/compute/post latency histograms as Prometheus text
+//   -s  send them to a StatsD agent (one datagram at exit)
 int main(int argc, char** argv) {
+    int count = 1, pipelined = 0, quantized = 0;
+    const char* metrics_path = NULL;
+    const char* statsd = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) count = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0) pipelined = 1;
+        else if (strcmp(argv[i], "-q") == 0) quantized = 1;
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) metrics_path = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) statsd = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [-n authentications] [-p] [-q] [-m metrics.prom] "
+                            "[-s statsd_host:port]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (count < 1) count = 1;
+    
     printf("Physics Auth Client v1.0\n");
     
     // Initialize
     auth_init();
+    curl_global_init(CURL_GLOBAL_DEFAULT);
     
     // Load secret
     AuthSecret secret = load_secret(SECRET_FILE);
@@ -89,48 +416,92 @@ int main(int argc, char** argv) {
     // Device ID (from MAC address or config)
     const char* device_id = "rpi-001";
     
-    // Get challenge from server
-    printf("Requesting challenge...\n");
-    char* challenge_json = get_challenge(device_id);
-    
-    if (!challenge_json) {
-        fprintf(stderr, "Failed to get challenge\n");
+    static ClientSession session;
+    static ClientTelemetry telemetry;
+    telemetry_init(&telemetry);
+    if (!session_open(&session, device_id)) {
+        fprintf(stderr, "Failed to initialize libcurl\n");
         return 1;
     }
+    session.telemetry = &telemetry;
+    session.quantized = quantized;
     
-    // Parse challenge
-    float challenge[CHALLENGE_LENGTH];
-    int length;
-    if (!parse_challenge(challenge_json, challenge, &length)) {
-        fprintf(stderr, "Failed to parse challenge\n");
-        free(challenge_json);
+    // Get challenge from server - the response is computed while the
+    // challenge downloads; elapsed time is what remains after the last byte
+    printf("Requesting challenge...\n");
+    static ChallengeStream streams[2];
+    int cur = 0, posted, fetched, ignored, accepted = 0;
+    challenge_stream_init(&streams[0], &secret);
+    session_exchange(&session, NULL, 0, &streams[0], &ignored, &fetched);
+    if (!fetched) {
+        fprintf(stderr, "Failed to get challenge\n");
+        session_close(&session);
         return 1;
     }
-    free(challenge_json);
-    
-    printf("Received challenge with %d steps\n", length);
-    
-    // Compute response
-    printf("Computing response...\n");
-    clock_t start = clock();
-    
-    AuthResponse resp = auth_compute_response(challenge, length, &secret);
-    
-    clock_t end = clock();
-    double elapsed_ms = (double)(end - start) / CLOCKS_PER_SEC * 1000.0;
     
-    printf("Response computed in %.2fms\n", elapsed_ms);
-    printf("  Psi=%.6f, I=%.6f, R=%.6f, Phi_avg=%.6f\n",
-           resp.psi, resp.i_val, resp.r_val, resp.phi_avg);
-    
-    // Send to server
-    printf("Sending response...\n");
-    if (send_response(device_id, &resp)) {
-        printf("Authentication successful!\n");
+    double run_start = now_ms();
+    for (int n = 0; n < count; n++) {
+        ChallengeStream* cs = &streams[cur];
+        ChallengeStream* next = n + 1 < count ? &streams[cur ^ 1] : NULL;
+        
+        uint64_t start = auth_telemetry_now_ns();
+        AuthResponse resp;
+        if (!challenge_stream_finish(cs, &resp)) {
+            fprintf(stderr, "Failed to parse challenge\n");
+            break;
+        }
+        uint64_t compute_ns = auth_telemetry_now_ns() - start;
+        auth_histogram_record(&telemetry.compute, compute_ns);
+        double elapsed_ms = (double)compute_ns / 1e6;
         
-        // In production: trigger GPIO for door unlock
-        // system("gpio -g write 17 1");
+        if (count == 1) {
+            printf("Received %s challenge with %d steps\n", cs->binary ? "binary" : "JSON", cs->count);
+            printf("Response computed in %.2fms\n", elapsed_ms);
+            printf("  Psi=%.6f, I=%.6f, R=%.6f, Phi_avg=%.6f\n",
+                   resp.psi, resp.i_val, resp.r_val, resp.phi_avg);
+            printf("Sending response...\n");
+        }
         
+        // Send to server, and fetch the next challenge alongside or after it
+        if (next) challenge_stream_init(next, &secret);
+        if (pipelined) {
+            session_exchange(&session, &resp, cs->binary, next, &posted, &fetched);
+        } else {
+            session_exchange(&session, &resp, cs->binary, NULL, &posted, &fetched);
+            if (next) session_exchange(&session, NULL, 0, next, &ignored, &fetched);
+        }
+        
+        if (posted) {
+            accepted++;
+            // In production: trigger GPIO for door unlock
+            // system("gpio -g write 17 1");
+        }
+        if (next && !fetched) {
+            fprintf(stderr, "Failed to get challenge\n");
+            break;
+        }
+        cur ^= 1;
+    }
+    double run_ms = now_ms() - run_start;
+    session_close(&session);
+    curl_global_cleanup();
+    
+    if (count > 1) {
+        printf("%d/%d authentications accepted in %.1fms (%.0f/s, %s)\n", accepted, count, run_ms,
+               run_ms > 0.0 ? accepted * 1000.0 / run_ms : 0.0,
+               pipelined ? "pipelined" : "sequential");
+        telemetry_print(&telemetry.fetch, "fetch");
+        telemetry_print(&telemetry.compute, "compute");
+        telemetry_print(&telemetry.post, "post");
+    }
+    if (metrics_path && !telemetry_write_prometheus(&telemetry, device_id, metrics_path)) {
+        fprintf(stderr, "Cannot write %s\n", metrics_path);
+    }
+    if (statsd && !telemetry_send_statsd(&telemetry, device_id, statsd)) {
+        fprintf(stderr, "Cannot send metrics to %s\n", statsd);
+    }
+    if (accepted == count) {
+        printf("Authentication successful!\n");
         return 0;
     } else {
         fprintf(stderr, "Authentication failed\n");
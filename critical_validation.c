@@ -9,6 +9,8 @@
 #include <time.h>
 #include <stdint.h>
 #include "physics_auth.h"
+#include "bench/bench_harness.h"
+#include "auth_sweep.h"
 
 #define ANSI_GREEN "\x1b[32m"
 #define ANSI_RED "\x1b[31m"
@@ -42,15 +44,19 @@ void verdict_questionable(const char* caveat) {
     claims_questionable++;
 }
 
-// Get high-resolution time
-static inline uint64_t get_ns(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
-}
-
 // ==================== CLAIM TESTS ====================
 
+typedef struct {
+    const float* challenge;
+    const AuthSecret* secret;
+} ClaimContext;
+
+static void claim_compute(void* p) {
+    ClaimContext* ctx = p;
+    AuthResponse r = auth_compute_response(ctx->challenge, CHALLENGE_LENGTH, ctx->secret);
+    (void)r;
+}
+
 // CLAIM 1: "260× faster than RSA-2048"
 void test_claim_faster_than_rsa(void) {
     print_claim("260× faster than RSA-2048");
@@ -60,15 +66,10 @@ void test_claim_faster_than_rsa(void) {
     float challenge[CHALLENGE_LENGTH];
     for (int i = 0; i < CHALLENGE_LENGTH; i++) challenge[i] = 1.5f;
     
-    const int iterations = 10000;
-    uint64_t start = get_ns();
-    for (int i = 0; i < iterations; i++) {
-        AuthResponse r = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
-        (void)r;
-    }
-    uint64_t end = get_ns();
-    
-    double our_latency_ms = (double)(end - start) / iterations / 1000000.0;
+    ClaimContext ctx = {challenge, &secret};
+    BenchConfig cfg = {10, 10000, -1};
+    BenchStats stats = bench_run("auth_compute_response", claim_compute, &ctx, 1, &cfg);
+    double our_latency_ms = stats.p50_ns / 1e6;
     
     // RSA-2048 signature typically takes 50-100ms on similar hardware
     // Source: OpenSSL benchmarks on x86
@@ -76,7 +77,8 @@ void test_claim_faster_than_rsa(void) {
     
     double speedup = rsa_latency_ms / our_latency_ms;
     
-    printf("  PhysicsAuth latency: %.4fms\n", our_latency_ms);
+    printf("  PhysicsAuth latency: %.4fms (p50; p99 %.4fms)\n", our_latency_ms,
+           stats.p99_ns / 1e6);
     printf("  RSA-2048 typical:    %.1fms (OpenSSL benchmarks)\n", rsa_latency_ms);
     printf("  Calculated speedup:  %.0f×\n", speedup);
     
@@ -98,12 +100,12 @@ void test_claim_battery_life(void) {
     float challenge[CHALLENGE_LENGTH];
     for (int i = 0; i < CHALLENGE_LENGTH; i++) challenge[i] = 1.5f;
     
-    uint64_t start = get_ns();
+    uint64_t start = bench_now_ns();
     for (int i = 0; i < 1000; i++) {
         AuthResponse r = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
         (void)r;
     }
-    uint64_t elapsed_ns = get_ns() - start;
+    uint64_t elapsed_ns = bench_now_ns() - start;
     double auth_time_ms = elapsed_ns / 1000.0 / 1000000.0;
     
     // Assumptions (these are the weak points):
@@ -240,26 +242,21 @@ void test_claim_brute_force(void) {
     AuthResponse true_response = auth_compute_response(challenge, CHALLENGE_LENGTH, &true_secret);
     
     int attempts = 10000;
-    int successes = 0;
-    
-    srand(time(NULL));
-    for (int i = 0; i < attempts; i++) {
-        AuthSecret guess = {
-            .k = 1.0f + ((float)rand() / RAND_MAX) * 4.0f,
-            .gamma = 0.1f + ((float)rand() / RAND_MAX) * 2.0f,
-            .seed = rand()
-        };
-        
-        AuthResponse guess_response = auth_compute_response(challenge, CHALLENGE_LENGTH, &guess);
-        
-        if (fabsf(guess_response.psi - true_response.psi) < 0.000001f) {
-            successes++;
-        }
-    }
+    AuthSweepConfig sweep = {
+        .k_min = 1.0f, .k_max = 5.0f, .gamma_min = 0.1f, .gamma_max = 2.1f,
+        .seed_min = 0, .seed_max = RAND_MAX,   // rand()'s range: the attacker model of this check
+        .mode = AUTH_SWEEP_RANDOM,
+        .guesses = (uint64_t)attempts, .rng_seed = (uint64_t)time(NULL),
+        .threads = 0, .revision = AUTH_ENGINE_REV_1, .tolerance = 0.000001f, .channels = 1
+    };
+    AuthSweepResult res;
+    auth_sweep(&sweep, challenge, CHALLENGE_LENGTH, &true_response, NULL, 0, &res);
+    int successes = (int)res.matches;
     
     printf("  Attempts: %d\n", attempts);
     printf("  Successes: %d\n", successes);
     printf("  Success rate: %.4f%%\n", (float)successes / attempts * 100);
+    printf("  Guess rate: %.0f guesses/sec\n", res.guesses_per_sec);
     
     if (successes == 0) {
         verdict_pass("0 brute force successes confirmed");
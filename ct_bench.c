@@ -0,0 +1,130 @@
+// ct_bench.c
+// Per-call timing of auth_compute_response() across secrets
+//
+// Built twice by `make ct_bench`: once as the default engine and once with
+// -DAUTH_CONSTANT_TIME=1. For each secret it records the cycle count of
+// every call (interleaved round-robin, so frequency drift hits all secrets
+// alike) and takes the per-secret median. The spread of those medians
+// across secrets is what a remote timing attacker could observe; ideally it
+// sits at the measurement noise floor.
+//
+// Usage: ct_bench [-q] [baseline_ns]
+//   -q           print only the ns per response (for the baseline)
+//   baseline_ns  compare throughput against another build's -q output
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "physics_auth.h"
+#include "bench/bench_harness.h"
+
+#define N_SECRETS 64
+#define ROUNDS 201
+#define MAX_SLOWDOWN 0.10
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+    int quiet = argc > 1 && strcmp(argv[1], "-q") == 0;
+    double baseline_ns = (!quiet && argc > 1) ? atof(argv[1]) : 0.0;
+
+    auth_init();
+
+    // Secrets span the whole parameter range, including large k that makes
+    // the I/Psi wraps fire on most steps and small k where they never do
+    AuthSecret secrets[N_SECRETS];
+    uint32_t rng = 0x2545F491u;
+    for (int s = 0; s < N_SECRETS; s++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        secrets[s].k = 0.1f + 19.9f * (float)s / (N_SECRETS - 1);
+        secrets[s].gamma = 0.05f + (float)(rng % 1000) / 1000.0f;
+        secrets[s].seed = rng;
+    }
+
+    float challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id(1, challenge, CHALLENGE_LENGTH);
+
+    static uint64_t cycles[N_SECRETS][ROUNDS];
+    volatile float sink = 0.0f;
+
+    // Warm up caches, tables and the dispatch
+    for (int s = 0; s < N_SECRETS; s++) {
+        sink += auth_compute_response(challenge, CHALLENGE_LENGTH, &secrets[s]).psi;
+    }
+
+    // Throughput is the median round (one call per secret), which shrugs off
+    // preemption and frequency changes that a whole-run mean would absorb
+    static uint64_t round_ns[ROUNDS];
+    for (int r = 0; r < ROUNDS; r++) {
+        uint64_t start = bench_now_ns();
+        for (int s = 0; s < N_SECRETS; s++) {
+            uint64_t t0 = bench_cycles();
+            AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &secrets[s]);
+            uint64_t t1 = bench_cycles();
+            sink += resp.psi;
+            cycles[s][r] = t1 - t0;
+        }
+        round_ns[r] = bench_now_ns() - start;
+    }
+    double ns_per_response = bench_stats("round", round_ns, ROUNDS, N_SECRETS).p50_ns;
+    (void)sink;
+
+    if (quiet) {
+        printf("%.1f\n", ns_per_response);
+        return 0;
+    }
+
+    // Per-secret medians, then their spread across secrets
+    double medians[N_SECRETS], mean = 0.0;
+    double lo = INFINITY, hi = 0.0;
+    for (int s = 0; s < N_SECRETS; s++) {
+        qsort(cycles[s], ROUNDS, sizeof(uint64_t), cmp_u64);
+        medians[s] = (double)cycles[s][ROUNDS / 2];
+        mean += medians[s];
+        if (medians[s] < lo) lo = medians[s];
+        if (medians[s] > hi) hi = medians[s];
+    }
+    mean /= N_SECRETS;
+    double var = 0.0;
+    for (int s = 0; s < N_SECRETS; s++) var += (medians[s] - mean) * (medians[s] - mean);
+    double stddev = sqrt(var / (N_SECRETS - 1));
+
+    // Median absolute deviation within one secret = the noise floor
+    double noise = 0.0;
+    for (int s = 0; s < N_SECRETS; s++) {
+        uint64_t dev[ROUNDS];
+        for (int r = 0; r < ROUNDS; r++) {
+            double d = fabs((double)cycles[s][r] - medians[s]);
+            dev[r] = (uint64_t)d;
+        }
+        qsort(dev, ROUNDS, sizeof(uint64_t), cmp_u64);
+        noise += (double)dev[ROUNDS / 2];
+    }
+    noise /= N_SECRETS;
+
+    printf("\n%s engine (%s, %d secrets x %d calls)\n",
+           AUTH_CONSTANT_TIME ? "Constant-time" : "Default", BENCH_CYCLE_UNIT, N_SECRETS, ROUNDS);
+    printf("  median per call:        %.0f %s\n", mean, BENCH_CYCLE_UNIT);
+    printf("  stddev across secrets:  %.0f %s (%.3f%%)\n", stddev, BENCH_CYCLE_UNIT,
+           100.0 * stddev / mean);
+    printf("  spread across secrets:  %.0f %s (%.3f%%), min %.0f, max %.0f\n", hi - lo,
+           BENCH_CYCLE_UNIT, 100.0 * (hi - lo) / mean, lo, hi);
+    printf("  noise floor (mean MAD): %.0f %s (%.3f%%)\n", noise, BENCH_CYCLE_UNIT,
+           100.0 * noise / mean);
+    printf("  throughput:             %.1f ns/response\n", ns_per_response);
+
+    if (baseline_ns > 0.0) {
+        double slowdown = ns_per_response / baseline_ns - 1.0;
+        int ok = slowdown <= MAX_SLOWDOWN;
+        printf("  vs baseline %.1f ns:     %+.1f%% %s\n", baseline_ns, 100.0 * slowdown,
+               ok ? "\x1b[32m(within 10%)\x1b[0m" : "\x1b[31m(over 10%)\x1b[0m");
+        return ok ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,295 @@
+// fixed_crosscheck.c
+// Cross-check of the Q16.16 fixed-point engine against the float engine
+//
+// Whole responses cannot be compared: both engines are chaotic, and the
+// ~1e-5 quantization error grows past any tolerance within a few steps.
+// Instead this harness checks:
+// 1. the integer sin/cos/tanh primitives against libm / fast_tanh
+// 2. single evolution steps from identical random states (float REV_2)
+// 3. response statistics of the fixed engine (determinism, uniqueness,
+//    avalanche)
+// 4. per-response time of both engines on this host
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "physics_auth.h"
+#include "physics_auth_internal.h"
+#include "bench/bench_harness.h"
+
+#define ANSI_GREEN "\x1b[32m"
+#define ANSI_RED "\x1b[31m"
+#define ANSI_RESET "\x1b[0m"
+
+#define STEP_SAMPLES 20000
+#define STAT_SECRETS 500
+
+static int checks_passed = 0;
+static int checks_failed = 0;
+
+static void report(int ok, const char* name) {
+    printf("  %s %s\n", ok ? ANSI_GREEN "✓" ANSI_RESET : ANSI_RED "✗" ANSI_RESET, name);
+    if (ok) checks_passed++;
+    else checks_failed++;
+}
+
+static float uniform(uint32_t* rng, float lo, float hi) {
+    return lo + (hi - lo) * (float)(xorshift32(rng) & 0xFFFFFF) / 16777215.0f;
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// ============================================================================
+// 1. PRIMITIVES
+// ============================================================================
+
+static void check_primitives(void) {
+    printf("\n=== Primitives ===\n");
+
+    double sin_err = 0.0, cos_err = 0.0, tanh_err = 0.0;
+    for (auth_q16 x = -100 * AUTH_Q16_ONE; x <= 100 * AUTH_Q16_ONE; x += 37) {
+        double xd = (double)x / AUTH_Q16_ONE;
+        double es = fabs(auth_q16_to_float(auth_q16_sin(x)) - sin(xd));
+        double ec = fabs(auth_q16_to_float(auth_q16_cos(x)) - cos(xd));
+        if (es > sin_err) sin_err = es;
+        if (ec > cos_err) cos_err = ec;
+    }
+    for (auth_q16 x = -5 * AUTH_Q16_ONE; x <= 5 * AUTH_Q16_ONE; x += 7) {
+        double e = fabs(auth_q16_to_float(auth_q16_tanh(x)) -
+                        fast_tanh((float)x / AUTH_Q16_ONE));
+        if (e > tanh_err) tanh_err = e;
+    }
+
+    printf("  max |error|: sin %.2e, cos %.2e, tanh %.2e (1 LSB = %.2e)\n",
+           sin_err, cos_err, tanh_err, 1.0 / AUTH_Q16_ONE);
+    report(sin_err < 4.0 / AUTH_Q16_ONE && cos_err < 4.0 / AUTH_Q16_ONE, "sin/cos within 4 LSB");
+    report(tanh_err < 4.0 / AUTH_Q16_ONE, "tanh within 4 LSB");
+}
+
+// ============================================================================
+// 2. SINGLE STEPS
+// ============================================================================
+
+static void check_steps(void) {
+    printf("\n=== Single Steps (%d random states) ===\n", STEP_SAMPLES);
+
+    static float err[STEP_SAMPLES];
+    uint32_t rng = 0xC0FFEE;
+    int wrap_mismatch = 0;
+
+    for (int n = 0; n < STEP_SAMPLES; n++) {
+        AgentState f;
+        f.I = uniform(&rng, -5.0f, 5.0f);
+        f.R = uniform(&rng, -0.5f, 0.5f);
+        f.Psi = uniform(&rng, -5.0f, 5.0f);
+        for (int i = 0; i < PHI_SIZE; i++) f.Phi[i] = uniform(&rng, -3.0f, 3.0f);
+        f.Lx = uniform(&rng, -20.0f, 20.0f);
+        f.Ly = uniform(&rng, -20.0f, 20.0f);
+        f.Lz = uniform(&rng, -20.0f, 20.0f);
+        f.entropy = uniform(&rng, -1000.0f, 1000.0f);
+        float k = uniform(&rng, 1.0f, 4.0f);
+        float gamma = uniform(&rng, 0.3f, 1.0f);
+        float input = uniform(&rng, 0.0f, 3.0f);
+        uint32_t seed = xorshift32(&rng);
+
+        // Quantize first so both engines start from the same state
+        AgentStateQ16 q;
+        q.I = auth_q16_from_float(f.I);
+        q.R = auth_q16_from_float(f.R);
+        q.Psi = auth_q16_from_float(f.Psi);
+        q.phi_sum = 0;
+        for (int i = 0; i < PHI_SIZE; i++) {
+            q.Phi[i] = auth_q16_from_float(f.Phi[i]);
+            f.Phi[i] = auth_q16_to_float(q.Phi[i]);
+            q.phi_sum += q.Phi[i];
+        }
+        q.Lx = auth_q16_from_float(f.Lx);
+        q.Ly = auth_q16_from_float(f.Ly);
+        q.Lz = auth_q16_from_float(f.Lz);
+        q.entropy = auth_q16_from_float(f.entropy);
+        f.I = auth_q16_to_float(q.I);
+        f.R = auth_q16_to_float(q.R);
+        f.Psi = auth_q16_to_float(q.Psi);
+        f.Lx = auth_q16_to_float(q.Lx);
+        f.Ly = auth_q16_to_float(q.Ly);
+        f.Lz = auth_q16_to_float(q.Lz);
+        f.entropy = auth_q16_to_float(q.entropy);
+        f.phi_sum = auth_phi_sum(f.Phi);
+        auth_q16 qk = auth_q16_from_float(k), qgamma = auth_q16_from_float(gamma);
+        auth_q16 qinput = auth_q16_from_float(input);
+        k = auth_q16_to_float(qk);
+        gamma = auth_q16_to_float(qgamma);
+        input = auth_q16_to_float(qinput);
+
+        uint32_t seed_f = seed, seed_q = seed;
+        auth_evolve_step(&f, k, gamma, input, &seed_f, AUTH_ENGINE_REV_2);
+        auth_q16_evolve_step(&q, qk, qgamma, qinput, &seed_q);
+
+        // Worst field of this sample. A value that lands on different
+        // sides of a wrap boundary differs by about the wrap modulus.
+        float worst = 0.0f;
+        float d[7] = {
+            f.I - auth_q16_to_float(q.I), f.R - auth_q16_to_float(q.R),
+            f.Psi - auth_q16_to_float(q.Psi), f.Lx - auth_q16_to_float(q.Lx),
+            f.Ly - auth_q16_to_float(q.Ly), f.Lz - auth_q16_to_float(q.Lz),
+            f.phi_sum / PHI_SIZE - auth_q16_to_float(q.phi_sum / PHI_SIZE),
+        };
+        for (int j = 0; j < 7; j++) {
+            if (fabsf(d[j]) > worst) worst = fabsf(d[j]);
+        }
+        if (worst > 0.5f) wrap_mismatch++;
+        err[n] = worst;
+    }
+
+    qsort(err, STEP_SAMPLES, sizeof(float), compare_floats);
+    float p50 = err[STEP_SAMPLES / 2];
+    float p99 = err[STEP_SAMPLES * 99 / 100];
+    printf("  worst-field |error|: p50 %.2e, p99 %.2e\n", p50, p99);
+    printf("  wrap boundary disagreements: %d (%.3f%%)\n", wrap_mismatch,
+           100.0 * wrap_mismatch / STEP_SAMPLES);
+    report(p99 < 5e-4f, "p99 single-step error < 5e-4");
+    report(wrap_mismatch < STEP_SAMPLES / 100, "wrap disagreements < 1%");
+}
+
+// ============================================================================
+// 3. RESPONSE STATISTICS
+// ============================================================================
+
+static int responses_differ(const AuthResponseQ16* a, const AuthResponseQ16* b) {
+    return memcmp(a, b, sizeof(AuthResponseQ16)) != 0;
+}
+
+static void check_statistics(void) {
+    printf("\n=== Fixed-Point Response Statistics (%d secrets) ===\n", STAT_SECRETS);
+
+    auth_q16 challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id_q16(1700000000u, challenge, CHALLENGE_LENGTH);
+
+    static AuthResponseQ16 resp[STAT_SECRETS];
+    AuthSecretQ16 secrets[STAT_SECRETS];
+    uint32_t rng = 12345;
+    for (int n = 0; n < STAT_SECRETS; n++) {
+        AuthSecret s = {uniform(&rng, 2.0f, 3.0f), uniform(&rng, 0.5f, 1.0f), xorshift32(&rng)};
+        secrets[n] = auth_secret_to_q16(&s);
+        auth_compute_response_q16(challenge, CHALLENGE_LENGTH, &secrets[n], &resp[n]);
+    }
+
+    AuthResponseQ16 again;
+    auth_compute_response_q16(challenge, CHALLENGE_LENGTH, &secrets[0], &again);
+    report(!responses_differ(&again, &resp[0]), "deterministic");
+
+    int collisions = 0;
+    for (int a = 0; a < STAT_SECRETS; a++) {
+        for (int b = a + 1; b < STAT_SECRETS; b++) {
+            if (!responses_differ(&resp[a], &resp[b])) collisions++;
+        }
+    }
+    printf("  collisions: %d\n", collisions);
+    report(collisions == 0, "distinct secrets give distinct responses");
+
+    // Perturb one entry in the first half (late entries get too few steps
+    // to spread, in either engine) and count responses that move
+    float f_challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id(1700000000u, f_challenge, CHALLENGE_LENGTH);
+    int lsb_sizes[2] = {3, 16};   // 3 LSB ~ one step of the LCG challenge grid
+    int fixed_changed[2] = {0, 0}, float_changed[2] = {0, 0};
+    for (int p = 0; p < 2; p++) {
+        for (int n = 0; n < STAT_SECRETS; n++) {
+            int entry = n % (CHALLENGE_LENGTH / 2);
+            auth_q16 q_flipped[CHALLENGE_LENGTH];
+            memcpy(q_flipped, challenge, sizeof(q_flipped));
+            q_flipped[entry] += lsb_sizes[p];
+            AuthResponseQ16 r;
+            auth_compute_response_q16(q_flipped, CHALLENGE_LENGTH, &secrets[n], &r);
+            if (fabsf(auth_q16_to_float(r.psi - resp[n].psi)) > 1e-3f ||
+                fabsf(auth_q16_to_float(r.lorenz_x - resp[n].lorenz_x)) > 1e-3f) {
+                fixed_changed[p]++;
+            }
+
+            AuthSecret s = {auth_q16_to_float(secrets[n].k), auth_q16_to_float(secrets[n].gamma),
+                            secrets[n].seed};
+            float f_flipped[CHALLENGE_LENGTH];
+            memcpy(f_flipped, f_challenge, sizeof(f_flipped));
+            f_flipped[entry] += (float)lsb_sizes[p] / AUTH_Q16_ONE;
+            AuthResponse base, moved;
+            auth_compute_response_rev(f_challenge, CHALLENGE_LENGTH, &s, AUTH_ENGINE_REV_2, &base);
+            auth_compute_response_rev(f_flipped, CHALLENGE_LENGTH, &s, AUTH_ENGINE_REV_2, &moved);
+            if (fabsf(moved.psi - base.psi) > 1e-3f || fabsf(moved.lorenz_x - base.lorenz_x) > 1e-3f) {
+                float_changed[p]++;
+            }
+        }
+        printf("  avalanche, +%2d LSB: fixed %d/%d, float %d/%d responses moved > 1e-3\n",
+               lsb_sizes[p], fixed_changed[p], STAT_SECRETS, float_changed[p], STAT_SECRETS);
+    }
+    // Quantization absorbs input changes below ~16 LSB (2.4e-4); that is
+    // the fixed engine's challenge resolution
+    report(fixed_changed[1] > STAT_SECRETS * 9 / 10, "16-LSB challenge change avalanches");
+}
+
+// ============================================================================
+// 4. TIMING
+// ============================================================================
+
+typedef struct {
+    const float* challenge;
+    const auth_q16* q_challenge;
+    const AuthSecret* secret;
+    const AuthSecretQ16* q_secret;
+} TimingContext;
+
+static void time_float(void* p) {
+    TimingContext* ctx = p;
+    AuthResponse f;
+    auth_compute_response_rev(ctx->challenge, CHALLENGE_LENGTH, ctx->secret, AUTH_ENGINE_REV_2, &f);
+}
+
+static void time_fixed(void* p) {
+    TimingContext* ctx = p;
+    AuthResponseQ16 q;
+    auth_compute_response_q16(ctx->q_challenge, CHALLENGE_LENGTH, ctx->q_secret, &q);
+}
+
+static void check_timing(void) {
+    printf("\n=== Timing on this host ===\n");
+
+    AuthSecret secret = {2.5f, 0.8f, 12345};
+    AuthSecretQ16 q_secret = auth_secret_to_q16(&secret);
+    float challenge[CHALLENGE_LENGTH];
+    auth_q16 q_challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id(42u, challenge, CHALLENGE_LENGTH);
+    auth_challenge_from_id_q16(42u, q_challenge, CHALLENGE_LENGTH);
+
+    TimingContext ctx = {challenge, q_challenge, &secret, &q_secret};
+    BenchConfig cfg = {20, 2000, -1};
+    BenchStats f = bench_run("float REV_2", time_float, &ctx, 1, &cfg);
+    BenchStats q = bench_run("Q16.16", time_fixed, &ctx, 1, &cfg);
+
+    printf("  float REV_2: %.1f us/response, Q16.16: %.1f us/response (p50)\n",
+           f.p50_ns / 1000.0, q.p50_ns / 1000.0);
+    printf("  (host has an FPU; the fixed engine pays off on parts without one)\n");
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("Fixed-Point Engine Cross-Check\n");
+    printf("========================================\n");
+
+    auth_init();
+
+    check_primitives();
+    check_steps();
+    check_statistics();
+    check_timing();
+
+    printf("\n========================================\n");
+    printf("Results: %s%d passed%s, %s%d failed%s\n",
+           ANSI_GREEN, checks_passed, ANSI_RESET,
+           checks_failed > 0 ? ANSI_RED : "", checks_failed, ANSI_RESET);
+    printf("========================================\n");
+
+    return checks_failed > 0 ? 1 : 0;
+}
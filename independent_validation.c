@@ -9,6 +9,8 @@
 #include <time.h>
 #include <stdint.h>
 #include "physics_auth.h"
+#include "bench/bench_harness.h"
+#include "auth_sweep.h"
 
 #define GREEN "\x1b[32m"
 #define RED "\x1b[31m"
@@ -17,14 +19,18 @@
 #define BOLD "\x1b[1m"
 #define RESET "\x1b[0m"
 
-// High-resolution timer
-static inline uint64_t get_ns(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+// ============== TEST 1: SPEED ==============
+typedef struct {
+    const float* challenge;
+    const AuthSecret* secret;
+} SpeedContext;
+
+static void speed_compute(void* p) {
+    SpeedContext* ctx = p;
+    volatile AuthResponse r = auth_compute_response(ctx->challenge, CHALLENGE_LENGTH, ctx->secret);
+    (void)r;
 }
 
-// ============== TEST 1: SPEED ==============
 void test_speed(void) {
     printf("\n" BOLD CYAN "═══════════════════════════════════════════════════════════" RESET "\n");
     printf(BOLD "TEST 1: SPEED CLAIM (2000x faster than RSA-2048)" RESET "\n");
@@ -36,31 +42,22 @@ void test_speed(void) {
         challenge[i] = (float)(i % 10) * 0.3f;
     }
     
-    // Warm up
-    for (int i = 0; i < 100; i++) {
-        auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
-    }
-    
-    // Measure 100,000 iterations
+    // 100,000 timed iterations after 100 warm-up calls
     int iterations = 100000;
-    uint64_t start = get_ns();
-    
-    for (int i = 0; i < iterations; i++) {
-        volatile AuthResponse r = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
-        (void)r;
-    }
-    
-    uint64_t elapsed = get_ns() - start;
-    double latency_ms = (double)elapsed / iterations / 1000000.0;
-    double throughput = 1000.0 / latency_ms;
+    SpeedContext ctx = {challenge, &secret};
+    BenchConfig cfg = {100, iterations, -1};
+    BenchStats stats = bench_run("auth_compute_response", speed_compute, &ctx, 1, &cfg);
+    double latency_ms = stats.p50_ns / 1e6;
+    double throughput = stats.ops_per_sec;
     
     // RSA-2048 baseline: ~50ms on modern CPU (OpenSSL benchmark)
     double rsa_latency = 50.0;
     double speedup = rsa_latency / latency_ms;
     
     printf("  Iterations:        %d\n", iterations);
-    printf("  Total time:        %.2f seconds\n", (double)elapsed / 1e9);
-    printf("  Latency per auth:  " BOLD "%.4f ms" RESET "\n", latency_ms);
+    printf("  Total time:        %.2f seconds\n", stats.mean_ns * iterations / 1e9);
+    printf("  Latency per auth:  " BOLD "%.4f ms" RESET " (p50; p99 %.4f ms, p999 %.4f ms)\n",
+           latency_ms, stats.p99_ns / 1e6, stats.p999_ns / 1e6);
     printf("  Throughput:        " BOLD "%.0f auth/sec" RESET "\n", throughput);
     printf("  RSA-2048 baseline: 50.0 ms\n");
     printf("  Speedup vs RSA:    " BOLD "%.0fx" RESET "\n", speedup);
@@ -139,35 +136,36 @@ void test_brute_force(void) {
     
     AuthResponse target_resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &target);
     
-    // Attacker attempts
+    // Attacker attempts run through the parallel sweep engine: random
+    // guesses on the batch engine, screened on the first four channels
+    // (and on all eight)
     int attempts = 10000;
-    int successes = 0;
-    float tolerance = 0.0001f;  // Very tight match required
-    
-    srand(time(NULL));
-    for (int i = 0; i < attempts; i++) {
-        AuthSecret guess = {
-            .k = 0.5f + ((float)rand() / RAND_MAX) * 5.0f,
-            .gamma = 0.1f + ((float)rand() / RAND_MAX) * 2.5f,
-            .seed = rand()
-        };
-        
-        AuthResponse guess_resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &guess);
-        
-        if (fabs(guess_resp.psi - target_resp.psi) < tolerance &&
-            fabs(guess_resp.i_val - target_resp.i_val) < tolerance &&
-            fabs(guess_resp.r_val - target_resp.r_val) < tolerance &&
-            fabs(guess_resp.phi_avg - target_resp.phi_avg) < tolerance) {
-            successes++;
-            printf(RED "  WARNING: Match found at attempt %d!" RESET "\n", i);
-        }
+    AuthSweepConfig sweep = {
+        .k_min = 0.5f, .k_max = 5.5f, .gamma_min = 0.1f, .gamma_max = 2.6f,
+        .seed_min = 0, .seed_max = RAND_MAX,   // rand()'s range: the attacker model of this check
+        .mode = AUTH_SWEEP_RANDOM,
+        .guesses = (uint64_t)attempts, .rng_seed = (uint64_t)time(NULL),
+        .threads = 0, .revision = AUTH_ENGINE_REV_1,
+        .tolerance = 0.0001f,  // Very tight match required
+        .channels = 4
+    };
+    AuthSweepMatch found[8];
+    AuthSweepResult res;
+    auth_sweep(&sweep, challenge, CHALLENGE_LENGTH, &target_resp, found, 8, &res);
+    int successes = (int)res.matches;
+    int full_matches = (int)res.full_matches;
+    for (int j = 0; j < res.recorded; j++) {
+        printf(RED "  WARNING: Match found at attempt %llu!" RESET "\n",
+               (unsigned long long)found[j].index);
     }
     
     double success_rate = (double)successes / attempts * 100;
     
     printf("  Attempts:          %d\n", attempts);
     printf("  Successes:         %d\n", successes);
+    printf("  Full 8-ch matches: %d\n", full_matches);
     printf("  Success rate:      %.4f%%\n", success_rate);
+    printf("  Guess rate:        %.0f guesses/sec\n", res.guesses_per_sec);
     printf("  Target Ψ:          %.6f\n", target_resp.psi);
     
     if (successes == 0) {
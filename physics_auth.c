@@ -10,60 +10,74 @@
 // 6. Nonlinear entropy hash (destroys ML predictability)
 
 #include "physics_auth.h"
+#include "physics_auth_internal.h"
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
 
-// Physics constants
-#define U_E 86.4f
-#define I_CHAR 8.0f
-#define R_CHAR 8.0f
-#define ALPHA_PSI 3.0f
-#define BETA_PSI 0.5f
-
-// Agent state - now includes Lorenz variables
-typedef struct {
-    float I;
-    float R;
-    float Psi;
-    float Phi[PHI_SIZE];
-    // NEW: Lorenz attractor state
-    float Lx, Ly, Lz;
-    // NEW: Running entropy accumulator
-    float entropy;
-} AgentState;
+#if defined(__unix__) || defined(__APPLE__)
+#define AUTH_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-void auth_init(void) {
-    // Reserved for future hardware initialization
-}
-
-// xorshift32 PRNG
-static uint32_t xorshift32(uint32_t* state) {
-    uint32_t x = *state;
-    x ^= x << 13;
-    x ^= x >> 17;
-    x ^= x << 5;
-    *state = x;
-    return x;
-}
+// ===== ENGINE TABLES =====
+float auth_sin_half[PHI_SIZE];
+float auth_cos_half[PHI_SIZE];
+float auth_step_mod[AUTH_STEP_TABLE_SIZE];
+float auth_sin_half_portable[PHI_SIZE];
+float auth_cos_half_portable[PHI_SIZE];
+float auth_step_mod_portable[AUTH_STEP_TABLE_SIZE];
+#if AUTH_BARE_METAL
+int auth_tables_state = AUTH_TABLES_EMPTY;
+#else
+atomic_int auth_tables_state = AUTH_TABLES_EMPTY;
+#endif
 
-// Fast tanh approximation
-static inline float fast_tanh(float x) {
-    if (x < -3.0f) return -1.0f;
-    if (x > 3.0f) return 1.0f;
-    float x2 = x * x;
-    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+void auth_tables_init(void) {
+#if AUTH_BARE_METAL
+    if (auth_tables_state == AUTH_TABLES_READY) return;
+#else
+    // The first caller builds; any other spins until it has published
+    int state = AUTH_TABLES_EMPTY;
+    if (!atomic_compare_exchange_strong_explicit(&auth_tables_state, &state,
+                                                 AUTH_TABLES_BUILDING, memory_order_acquire,
+                                                 memory_order_acquire)) {
+        while (state != AUTH_TABLES_READY) {
+            state = atomic_load_explicit(&auth_tables_state, memory_order_acquire);
+        }
+        return;
+    }
+#endif
+    for (int i = 0; i < PHI_SIZE; i++) {
+        // Computed in double - these feed every REV_2 response
+        auth_sin_half[i] = (float)sin((double)i * 0.5);
+        auth_cos_half[i] = (float)cos((double)i * 0.5);
+        // REV_4 must not depend on the host libm at all
+        auth_sincosf((float)i * 0.5f, &auth_sin_half_portable[i], &auth_cos_half_portable[i]);
+    }
+    for (int step = 0; step < AUTH_STEP_TABLE_SIZE; step++) {
+        auth_step_mod[step] = 1.0f + 0.01f * sinf(step * 0.1f);
+        auth_step_mod_portable[step] = 1.0f + 0.01f * auth_sinf(step * 0.1f);
+    }
+    auth_q16_tables_init();
+#if AUTH_BARE_METAL
+    auth_tables_state = AUTH_TABLES_READY;
+#else
+    atomic_store_explicit(&auth_tables_state, AUTH_TABLES_READY, memory_order_release);
+#endif
 }
 
-// NEW: Nonlinear mixing function (breaks ML predictability)
-static inline float mix_nonlinear(float a, float b, float c) {
-    float x = sinf(a * 3.14159f) * cosf(b * 2.71828f);
-    float y = fast_tanh(c * x);
-    return x * y + sinf(a * b + c);
+void auth_init(void) {
+    // Select the Phi field kernel for this CPU
+    auth_simd_init();
+    auth_tables_init();
 }
 
 // Initialize agent state with seed - MODIFIED: affects Lorenz initial conditions
-static void init_agent_state(AgentState* agent, uint32_t seed) {
+void auth_agent_init_n(AgentState* agent, uint32_t seed, int phi_size) {
     uint32_t rng_state = seed;
     
     agent->I = 0.1f;
@@ -71,9 +85,10 @@ static void init_agent_state(AgentState* agent, uint32_t seed) {
     agent->Psi = 0.1f;
     
     // Initialize Phi field with seeded random values
-    for (int i = 0; i < PHI_SIZE; i++) {
+    for (int i = 0; i < phi_size; i++) {
         agent->Phi[i] = (float)(xorshift32(&rng_state) & 0xFFFF) / 65535.0f * 0.1f;
     }
+    for (int i = phi_size; i < PHI_SIZE; i++) agent->Phi[i] = 0.0f;
     
     // NEW: Initialize Lorenz attractor with seed-dependent starting point
     // Small differences here cause MASSIVE divergence due to chaos
@@ -82,34 +97,36 @@ static void init_agent_state(AgentState* agent, uint32_t seed) {
     agent->Lz = 1.0f + (float)(xorshift32(&rng_state) & 0xFFFF) / 65535.0f * 0.01f;
     
     agent->entropy = 0.0f;
+    agent->phi_sum = auth_phi_sum_n(agent->Phi, phi_size);
+}
+
+void auth_agent_init(AgentState* agent, uint32_t seed) {
+    auth_agent_init_n(agent, seed, PHI_SIZE);
 }
 
 // MODIFIED: V3 HARDENING - discrete chaotic maps + wrapping
-static void evolve_step(AgentState* agent, float k, float gamma, 
-                           float phi_input, uint32_t* seed_state, int step) {
+// Runs the first phi_size cells with timestep dt_value; inlined with
+// constants into evolve_step() and the profile kernels
+__attribute__((always_inline))
+static inline void evolve_step_n(AgentState* agent, float k, float gamma, float phi_input,
+                                 uint32_t* seed_state, int revision, int phi_size,
+                                 float dt_value) {
+    AUTH_PHASE_BEGIN();
+    AUTH_PHASE_STEP();
     
     // ===== STABILITY via WRAPPING (Modular Arithmetic for Floats) =====
     // This destroys linearity immediately.
     // Instead of clamp(-50, 50), we do fmod(x, 50).
     
     // ===== LORENZ ATTRACTOR (True Chaos) =====
-    float dt = 0.02f; 
-    
-    float dLx = LORENZ_SIGMA * (agent->Ly - agent->Lx);
-    float dLy = agent->Lx * (LORENZ_RHO - agent->Lz) - agent->Ly;
-    float dLz = agent->Lx * agent->Ly - LORENZ_BETA * agent->Lz;
-    
-    // Strong coupling
-    dLx += phi_input * 2.0f;
-    
-    agent->Lx += dLx * dt;
-    agent->Ly += dLy * dt;
-    agent->Lz += dLz * dt;
-    
+    // Strong coupling: the challenge drives dLx
+    auth_step_lorenz(&agent->Lx, &agent->Ly, &agent->Lz, phi_input);
+
     // WRAP Lorenz state (keeps it bounded but nonlinear)
-    if (fabsf(agent->Lx) > 20.0f) agent->Lx = fmodf(agent->Lx, 20.0f);
-    if (fabsf(agent->Ly) > 20.0f) agent->Ly = fmodf(agent->Ly, 20.0f);
-    if (fabsf(agent->Lz) > 20.0f) agent->Lz = fmodf(agent->Lz, 20.0f);
+    agent->Lx = auth_wrap(agent->Lx, 1.0f, 20.0f);
+    agent->Ly = auth_wrap(agent->Ly, 1.0f, 20.0f);
+    agent->Lz = auth_wrap(agent->Lz, 1.0f, 20.0f);
+    AUTH_PHASE_END(AUTH_PHASE_LORENZ);
     
     // ===== DISCRETE CHAOS INJECTION (Logistic Map) =====
     // x_{n+1} = r * x_n * (1 - x_n)
@@ -119,99 +136,479 @@ static void evolve_step(AgentState* agent, float k, float gamma,
     float x = 0.5f + 0.5f * fast_tanh(agent->Psi); // map to (0,1)
     float r = 3.9f + 0.09f * fast_tanh(agent->Lx * 0.1f); // r in [3.81, 3.99] (chaotic regime)
     
-    // Iterate map 3 times
-    for(int i=0; i<3; i++) x = r * x * (1.0f - x);
-    
-    // Inject back into Psi
-    float chaos_kick = (x - 0.5f) * 2.0f; // map back to (-1,1)
-    
+    // Iterate map 3 times, inject back into Psi
+    float chaos_kick = auth_step_chaos_kick(x, r);
+
     // ===== CONTINUOUS SEED INFLUENCE =====
-    float seed_noise = (float)(xorshift32(seed_state) & 0xFFFF) / 65535.0f * 0.1f; // Stronger noise
-    
+    float seed_noise = auth_step_seed_noise(seed_state); // Stronger noise
+    AUTH_PHASE_END(AUTH_PHASE_CHAOS);
+
     // ===== PHYSICS EVOLUTION =====
-    float phi_avg = 0.0f;
-    for (int i = 0; i < PHI_SIZE; i++) {
-        phi_avg += agent->Phi[i];
-    }
-    phi_avg /= PHI_SIZE;
-    
-    float dI = k * phi_avg + chaos_kick * 0.5f - (U_E / I_CHAR) * agent->I * 0.5f;
-    float dR = 0.1f * agent->I * agent->Psi - (2.0f * U_E / R_CHAR) * agent->R * 0.3f;
-    float dPsi = ALPHA_PSI * agent->I - BETA_PSI * agent->R - gamma * agent->Psi;
-    
-    // Update state
-    agent->I += dI * DT + seed_noise;
-    agent->R += dR * DT;
-    agent->Psi += dPsi * DT;
-    
+    // Running sum - the Phi kernel re-sums the field while updating it
+    float phi_avg = agent->phi_sum / phi_size;
+    auth_step_state(&agent->I, &agent->R, &agent->Psi, k, gamma, phi_avg, chaos_kick,
+                    seed_noise, dt_value);
+
     // WRAP Main State (Key to nonlinearity)
-    if (fabsf(agent->I) > 5.0f) agent->I = fmodf(agent->I * 1.5f, 5.0f);
-    if (fabsf(agent->Psi) > 5.0f) agent->Psi = fmodf(agent->Psi * 1.5f, 5.0f);
+    agent->I = auth_wrap(agent->I, 1.5f, 5.0f);
+    agent->Psi = auth_wrap(agent->Psi, 1.5f, 5.0f);
+    AUTH_PHASE_END(AUTH_PHASE_STATE);
     
     // ===== PHI FIELD EVOLUTION =====
-    for (int i = 0; i < PHI_SIZE; i++) {
-        // Highly nonlinear position factor using sin(Lx * i)
-        float position_factor = sinf((float)i * 0.5f + agent->Lx);
-        float source = fast_tanh(agent->Psi * 0.5f - agent->Phi[i]);
-        agent->Phi[i] += (source * 0.2f + phi_input * 0.1f * position_factor) * DT;
-        
-        // Wrap field
-        if (fabsf(agent->Phi[i]) > 3.0f) agent->Phi[i] = fmodf(agent->Phi[i], 3.0f);
+    // Highly nonlinear position factor using sin(Lx * i); the field update
+    // itself runs in the dispatched SIMD kernel
+    float position_factor[PHI_SIZE];
+    if (revision >= AUTH_ENGINE_REV_2) {
+        // Only Lx changes between steps: one sin/cos pair instead of PHI_SIZE
+        // sines
+        float sin_lx, cos_lx;
+        auth_sincos_lx(agent->Lx, revision, &sin_lx, &cos_lx);
+        const float* sin_half = auth_sin_half_table(revision);
+        const float* cos_half = auth_cos_half_table(revision);
+        for (int i = 0; i < phi_size; i++) {
+            position_factor[i] = sin_half[i] * cos_lx + cos_half[i] * sin_lx;
+        }
+    } else {
+        for (int i = 0; i < phi_size; i++) {
+            position_factor[i] = sinf((float)i * 0.5f + agent->Lx);
+        }
+    }
+    if (phi_size == PHI_SIZE && dt_value == DT) {
+        agent->phi_sum = auth_phi_update(agent->Phi, position_factor,
+                                         agent->Psi * 0.5f, phi_input * 0.1f);
+    } else {
+        agent->phi_sum = auth_phi_update_n(agent->Phi, position_factor, agent->Psi * 0.5f,
+                                           phi_input * 0.1f, phi_size, dt_value);
     }
+    AUTH_PHASE_END(AUTH_PHASE_PHI);
     
     // ===== ENTROPY ACCUMULATION =====
-    agent->entropy += mix_nonlinear(agent->Psi, agent->Lx, phi_input);
-    agent->entropy = fmodf(agent->entropy, 1000.0f);
+    agent->entropy += auth_mix(agent->Psi, agent->Lx, phi_input, revision);
+    agent->entropy = auth_wrap_entropy(agent->entropy);
+    AUTH_PHASE_END(AUTH_PHASE_ENTROPY);
 }
 
-// Compute authentication response - HARDENED VERSION
-AuthResponse auth_compute_response(const float* challenge, int length, const AuthSecret* secret) {
-    AgentState agent;
-    uint32_t seed_state = secret->seed;  // Mutable copy for continuous use
-    
-    // Initialize with secret
-    init_agent_state(&agent, secret->seed);
-    
-    // ===== EXTENDED EVOLUTION: 200 steps =====
-    int steps_per_challenge = EVOLUTION_STEPS / length;
-    if (steps_per_challenge < 1) steps_per_challenge = 1;
-    
-    int total_step = 0;
-    for (int t = 0; t < length; t++) {
-        for (int s = 0; s < steps_per_challenge; s++) {
-            // Challenge value is mixed with step-dependent variation
-            float modified_challenge = challenge[t] * (1.0f + 0.01f * sinf(total_step * 0.1f));
-            evolve_step(&agent, secret->k, secret->gamma, modified_challenge, &seed_state, total_step);
-            total_step++;
-        }
-    }
-    
+static void evolve_step(AgentState* agent, float k, float gamma, 
+                           float phi_input, uint32_t* seed_state, int step, int revision) {
+    evolve_step_n(agent, k, gamma, phi_input, seed_state, revision, PHI_SIZE, DT);
+}
+
+void auth_evolve_step(AgentState* agent, float k, float gamma, float phi_input,
+                      uint32_t* seed_state, int revision) {
+    evolve_step(agent, k, gamma, phi_input, seed_state, 0, revision);
+}
+
+// Compute the 8 response channels from a fully evolved agent
+AuthResponse auth_agent_response_n(const AgentState* agent, float k, int phi_size,
+                                   int revision) {
     // ===== COMPUTE RESPONSE (8 channels) =====
-    float phi_avg = 0.0f;
-    for (int i = 0; i < PHI_SIZE; i++) {
-        phi_avg += agent.Phi[i];
-    }
-    phi_avg /= PHI_SIZE;
+    float phi_avg = agent->phi_sum / phi_size;
     
     // Compute entropy hash (nonlinear combination of all state)
-    float entropy_hash = mix_nonlinear(agent.Psi, agent.I, agent.R);
-    entropy_hash += mix_nonlinear(agent.Lx, agent.Ly, agent.Lz);
-    entropy_hash += mix_nonlinear(phi_avg, agent.entropy, secret->k);
+    float entropy_hash = auth_mix(agent->Psi, agent->I, agent->R, revision);
+    entropy_hash += auth_mix(agent->Lx, agent->Ly, agent->Lz, revision);
+    entropy_hash += auth_mix(phi_avg, agent->entropy, k, revision);
     entropy_hash = fast_tanh(entropy_hash);
     
     AuthResponse resp;
-    resp.psi = agent.Psi;
-    resp.i_val = agent.I;
-    resp.r_val = agent.R;
+    resp.psi = agent->Psi;
+    resp.i_val = agent->I;
+    resp.r_val = agent->R;
     resp.phi_avg = phi_avg;
-    resp.lorenz_x = agent.Lx;
-    resp.lorenz_y = agent.Ly;
-    resp.lorenz_z = agent.Lz;
-    resp.entropy_hash = entropy_hash + agent.entropy * 0.001f;
+    resp.lorenz_x = agent->Lx;
+    resp.lorenz_y = agent->Ly;
+    resp.lorenz_z = agent->Lz;
+    resp.entropy_hash = entropy_hash + agent->entropy * 0.001f;
     
     return resp;
 }
 
+AuthResponse auth_agent_response(const AgentState* agent, float k) {
+    return auth_agent_response_n(agent, k, PHI_SIZE, AUTH_ENGINE_REV_1);
+}
+
+// ===== INSTRUMENTATION =====
+
+#if AUTH_INSTRUMENT
+AUTH_THREAD_LOCAL AuthPhaseStats auth_phase_counters;
+#endif
+
+AuthPhaseStats auth_phase_stats(void) {
+#if AUTH_INSTRUMENT
+    return auth_phase_counters;
+#else
+    AuthPhaseStats none;
+    memset(&none, 0, sizeof(none));
+    return none;
+#endif
+}
+
+void auth_phase_stats_reset(void) {
+#if AUTH_INSTRUMENT
+    memset(&auth_phase_counters, 0, sizeof(auth_phase_counters));
+#endif
+}
+
+const char* auth_phase_name(AuthPhase phase) {
+    static const char* const names[AUTH_PHASE_COUNT] = {
+        "lorenz", "chaos", "state", "phi", "entropy"
+    };
+    return (unsigned)phase < AUTH_PHASE_COUNT ? names[phase] : "unknown";
+}
+
+// ===== EXTENDED EVOLUTION: 200 steps =====
+static int steps_per_challenge(int length, int total_steps) {
+#if AUTH_CONSTANT_TIME
+    // Count instead of divide - divider latency depends on the operands
+    int steps = 0;
+    for (int s = 1; s <= total_steps; s++) steps += (s * length <= total_steps);
+    return steps + (steps == 0);
+#else
+    int steps_per_challenge = total_steps / length;
+    if (steps_per_challenge < 1) steps_per_challenge = 1;
+    return steps_per_challenge;
+#endif
+}
+
+int auth_steps_per_challenge(int length) {
+    return steps_per_challenge(length, EVOLUTION_STEPS);
+}
+
+// ===== STEP SCHEDULES =====
+
+static int schedule_total(int length, int total_steps) {
+    return length > total_steps ? length : total_steps;
+}
+
+int auth_schedule_uniform_steps_n(int revision, int length, int total_steps) {
+    if (length < 1) return 0;
+    if (revision < AUTH_ENGINE_REV_3) return steps_per_challenge(length, total_steps);
+    int total = schedule_total(length, total_steps);
+    return total % length == 0 ? total / length : 0;
+}
+
+int auth_schedule_steps_n(int revision, int length, int entries, int total_steps) {
+    int uniform = auth_schedule_uniform_steps_n(revision, length, total_steps);
+    if (uniform > 0) return entries * uniform;
+    return (int)((int64_t)entries * schedule_total(length, total_steps) / length);
+}
+
+int auth_schedule_uniform_steps(int revision, int length) {
+    return auth_schedule_uniform_steps_n(revision, length, EVOLUTION_STEPS);
+}
+
+int auth_schedule_steps(int revision, int length, int entries) {
+    return auth_schedule_steps_n(revision, length, entries, EVOLUTION_STEPS);
+}
+
+int auth_checkpoint_begin(AuthCheckpoint* cp, const AuthSecret* secret, int total_length,
+                          int revision) {
+    if (!auth_revision_supported(revision)) return 0;
+    auth_tables_ensure();
+    
+    // Initialize with secret
+    auth_agent_init(&cp->agent, secret->seed);
+    cp->seed_state = secret->seed;  // Mutable copy for continuous use
+    cp->revision = revision;
+    cp->steps_per_challenge = auth_schedule_uniform_steps(revision, total_length);
+    cp->total_length = total_length;
+    cp->consumed = 0;
+    return 1;
+}
+
+// Uniform schedule. Inlined with a constant steps (the CHALLENGE_LENGTH
+// path) the loop bounds and step factors fold at compile time.
+static inline void advance_uniform(AgentState* agent, uint32_t* seed_state,
+                                   const AuthSecret* secret, const float* entries, int n,
+                                   int first_entry, int steps, int revision) {
+    int total_step = first_entry * steps;
+    for (int t = 0; t < n; t++) {
+        for (int s = 0; s < steps; s++) {
+            // Challenge value is mixed with step-dependent variation
+            float modified_challenge = entries[t] * auth_step_factor(total_step, revision);
+            evolve_step(agent, secret->k, secret->gamma, modified_challenge,
+                        seed_state, total_step, revision);
+            total_step++;
+        }
+    }
+}
+
+void auth_checkpoint_advance(AuthCheckpoint* cp, const AuthSecret* secret,
+                             const float* entries, int n) {
+    if (cp->steps_per_challenge > 0) {
+        advance_uniform(&cp->agent, &cp->seed_state, secret, entries, n, cp->consumed,
+                        cp->steps_per_challenge, cp->revision);
+    } else {
+        int total_step = auth_schedule_steps(cp->revision, cp->total_length, cp->consumed);
+        for (int t = 0; t < n; t++) {
+            int end = auth_schedule_steps(cp->revision, cp->total_length, cp->consumed + t + 1);
+            for (; total_step < end; total_step++) {
+                float modified_challenge = entries[t] * auth_step_factor(total_step, cp->revision);
+                evolve_step(&cp->agent, secret->k, secret->gamma, modified_challenge,
+                            &cp->seed_state, total_step, cp->revision);
+            }
+        }
+    }
+    cp->consumed += n;
+}
+
+AuthResponse auth_checkpoint_response(const AuthCheckpoint* cp, const AuthSecret* secret) {
+    return auth_agent_response_n(&cp->agent, secret->k, PHI_SIZE, cp->revision);
+}
+
+int auth_stream_begin(AuthStream* stream, const AuthSecret* secret, int declared_length,
+                      int revision) {
+    if (declared_length < 1) return 0;
+    if (!auth_checkpoint_begin(&stream->cp, secret, declared_length, revision)) return 0;
+    stream->secret = *secret;
+    stream->declared_length = declared_length;
+    return 1;
+}
+
+// A challenge of length runs the schedule the stream was started with
+static int stream_schedule_matches(const AuthStream* stream, int length) {
+    if (length == stream->declared_length) return 1;
+    int uniform = stream->cp.steps_per_challenge;
+    return uniform > 0 && auth_schedule_uniform_steps(stream->cp.revision, length) == uniform;
+}
+
+int auth_stream_feed(AuthStream* stream, float value) {
+    // Past the band's last length no finish() can succeed
+    if (!stream_schedule_matches(stream, stream->cp.consumed + 1) &&
+        stream->cp.consumed >= stream->declared_length) {
+        return 0;
+    }
+    auth_checkpoint_advance(&stream->cp, &stream->secret, &value, 1);
+    return 1;
+}
+
+int auth_stream_finish(const AuthStream* stream, AuthResponse* out) {
+    int fed = stream->cp.consumed;
+    if (fed < 1 || !stream_schedule_matches(stream, fed)) return 0;
+    *out = auth_checkpoint_response(&stream->cp, &stream->secret);
+    return 1;
+}
+
+static AuthResponse compute_response(const float* challenge, int length,
+                                     const AuthSecret* secret, int revision) {
+    AuthCheckpoint cp;
+    auth_checkpoint_begin(&cp, secret, length, revision);
+#if EVOLUTION_STEPS % CHALLENGE_LENGTH == 0
+    // Standard length: the same uniform schedule under every revision,
+    // with constant trip counts
+    if (length == CHALLENGE_LENGTH) {
+        advance_uniform(&cp.agent, &cp.seed_state, secret, challenge, CHALLENGE_LENGTH, 0,
+                        EVOLUTION_STEPS / CHALLENGE_LENGTH, revision);
+        return auth_checkpoint_response(&cp, secret);
+    }
+#endif
+    auth_checkpoint_advance(&cp, secret, challenge, length);
+    return auth_checkpoint_response(&cp, secret);
+}
+
+// Compute authentication response - HARDENED VERSION
+AuthResponse auth_compute_response(const float* challenge, int length, const AuthSecret* secret) {
+#if AUTH_FIXED_POINT
+    return auth_compute_response_fixed(challenge, length, secret);
+#else
+    return compute_response(challenge, length, secret, AUTH_ENGINE_REV_1);
+#endif
+}
+
+// ===== ENGINE REVISIONS =====
+
+uint32_t auth_engine_revisions(void) {
+    return (1u << AUTH_ENGINE_REV_1) | (1u << AUTH_ENGINE_REV_2) | (1u << AUTH_ENGINE_REV_3) |
+           (1u << AUTH_ENGINE_REV_4);
+}
+
+int auth_revision_supported(int revision) {
+    return revision > 0 && revision < 32 && (auth_engine_revisions() & (1u << revision));
+}
+
+int auth_engine_negotiate(uint32_t peer_revisions) {
+    uint32_t common = auth_engine_revisions() & peer_revisions;
+    for (int rev = AUTH_ENGINE_REV_LATEST; rev > 0; rev--) {
+        if (common & (1u << rev)) return rev;
+    }
+    return 0;
+}
+
+int auth_compute_response_rev(const float* challenge, int length, const AuthSecret* secret,
+                              int revision, AuthResponse* out) {
+    if (!auth_revision_supported(revision)) return 0;
+    *out = compute_response(challenge, length, secret, revision);
+    return 1;
+}
+
+// ===== PROFILES =====
+// At its challenge length every preset runs constant trip counts end to end
+
+const AuthProfile auth_profile_presets[AUTH_PROFILE_PRESETS] = {
+    [AUTH_PROFILE_LOW_POWER] = {"low-power", AUTH_LOW_POWER_PHI, AUTH_LOW_POWER_STEPS,
+                                AUTH_LOW_POWER_DT, AUTH_LOW_POWER_LENGTH},
+    [AUTH_PROFILE_DEFAULT] = {"default", PHI_SIZE, EVOLUTION_STEPS, DT, CHALLENGE_LENGTH},
+    [AUTH_PROFILE_HARDENED] = {"hardened", PHI_SIZE, AUTH_HARDENED_STEPS, AUTH_HARDENED_DT,
+                               CHALLENGE_LENGTH},
+};
+
+const AuthProfile* auth_profile_find(const char* name) {
+    for (int i = 0; i < AUTH_PROFILE_PRESETS; i++) {
+        if (strcmp(auth_profile_presets[i].name, name) == 0) return &auth_profile_presets[i];
+    }
+    return NULL;
+}
+
+int auth_profile_valid(const AuthProfile* profile) {
+    return profile && profile->phi_size >= 1 && profile->phi_size <= PHI_SIZE &&
+           profile->evolution_steps >= 1 && profile->evolution_steps <= AUTH_PROFILE_MAX_STEPS &&
+           profile->dt > 0.0f && profile->dt < 1.0f && profile->challenge_length >= 1 &&
+           profile->challenge_length <= CHALLENGE_LENGTH;
+}
+
+int auth_profile_preset_id(const AuthProfile* profile) {
+    for (int i = 0; i < AUTH_PROFILE_PRESETS; i++) {
+        const AuthProfile* p = &auth_profile_presets[i];
+        if (profile->phi_size == p->phi_size && profile->evolution_steps == p->evolution_steps &&
+            profile->dt == p->dt) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Whole response under a profile; uniform > 0 is a known uniform schedule
+__attribute__((always_inline))
+static inline AuthResponse profile_response(const float* challenge, int length,
+                                            const AuthSecret* secret, int revision,
+                                            int phi_size, int total_steps, float dt_value,
+                                            int uniform) {
+    AgentState agent;
+    uint32_t seed_state = secret->seed;
+    auth_agent_init_n(&agent, secret->seed, phi_size);
+    int step = 0;
+    for (int t = 0; t < length; t++) {
+        int end = uniform > 0 ? step + uniform
+                              : auth_schedule_steps_n(revision, length, t + 1, total_steps);
+        for (; step < end; step++) {
+            float modified_challenge = challenge[t] * auth_step_factor(step, revision);
+            evolve_step_n(&agent, secret->k, secret->gamma, modified_challenge, &seed_state,
+                          revision, phi_size, dt_value);
+        }
+    }
+    return auth_agent_response_n(&agent, secret->k, phi_size, revision);
+}
+
+static AuthResponse response_low_power(const float* challenge, int length,
+                                       const AuthSecret* secret, int revision) {
+    if (length == AUTH_LOW_POWER_LENGTH) {
+        return profile_response(challenge, AUTH_LOW_POWER_LENGTH, secret, revision,
+                                AUTH_LOW_POWER_PHI, AUTH_LOW_POWER_STEPS, AUTH_LOW_POWER_DT,
+                                AUTH_LOW_POWER_STEPS / AUTH_LOW_POWER_LENGTH);
+    }
+    return profile_response(challenge, length, secret, revision, AUTH_LOW_POWER_PHI,
+                            AUTH_LOW_POWER_STEPS, AUTH_LOW_POWER_DT,
+                            auth_schedule_uniform_steps_n(revision, length, AUTH_LOW_POWER_STEPS));
+}
+
+static AuthResponse response_hardened(const float* challenge, int length,
+                                      const AuthSecret* secret, int revision) {
+    if (length == CHALLENGE_LENGTH) {
+        return profile_response(challenge, CHALLENGE_LENGTH, secret, revision, PHI_SIZE,
+                                AUTH_HARDENED_STEPS, AUTH_HARDENED_DT,
+                                AUTH_HARDENED_STEPS / CHALLENGE_LENGTH);
+    }
+    return profile_response(challenge, length, secret, revision, PHI_SIZE, AUTH_HARDENED_STEPS,
+                            AUTH_HARDENED_DT,
+                            auth_schedule_uniform_steps_n(revision, length, AUTH_HARDENED_STEPS));
+}
+
+static AuthResponse response_generic(const float* challenge, int length,
+                                     const AuthSecret* secret, int revision,
+                                     const AuthProfile* profile) {
+    return profile_response(challenge, length, secret, revision, profile->phi_size,
+                            profile->evolution_steps, profile->dt,
+                            auth_schedule_uniform_steps_n(revision, length,
+                                                          profile->evolution_steps));
+}
+
+int auth_compute_response_ex(const float* challenge, int length, const AuthSecret* secret,
+                             int revision, const AuthProfile* profile, AuthResponse* out) {
+    if (!auth_revision_supported(revision) || !auth_profile_valid(profile) || length < 1) return 0;
+    auth_tables_ensure();
+    switch (auth_profile_preset_id(profile)) {
+    case AUTH_PROFILE_LOW_POWER:
+        *out = response_low_power(challenge, length, secret, revision);
+        break;
+    case AUTH_PROFILE_DEFAULT:
+        *out = compute_response(challenge, length, secret, revision);
+        break;
+    case AUTH_PROFILE_HARDENED:
+        *out = response_hardened(challenge, length, secret, revision);
+        break;
+    default:
+        *out = response_generic(challenge, length, secret, revision, profile);
+        break;
+    }
+    return 1;
+}
+
+// ===== SLICED COMPUTATION =====
+
+int auth_slice_begin(AuthSlice* slice, const AuthSecret* secret, int length, int revision,
+                     const AuthProfile* profile) {
+    if (!profile) profile = &auth_profile_presets[AUTH_PROFILE_DEFAULT];
+    if (!auth_revision_supported(revision) || !auth_profile_valid(profile) || length < 1) return 0;
+    auth_tables_ensure();
+    auth_agent_init_n(&slice->agent, secret->seed, profile->phi_size);
+    slice->seed_state = secret->seed;
+    slice->secret = *secret;
+    slice->revision = revision;
+    slice->phi_size = profile->phi_size;
+    slice->dt = profile->dt;
+    slice->length = length;
+    slice->total_steps = profile->evolution_steps;
+    slice->schedule_steps = auth_schedule_steps_n(revision, length, length, slice->total_steps);
+    slice->step = 0;
+    slice->entry = 0;
+    slice->entry_end = auth_schedule_steps_n(revision, length, 1, slice->total_steps);
+    return 1;
+}
+
+int auth_slice_run(AuthSlice* slice, const float* challenge, int received, int max_steps) {
+    if (received > slice->length) received = slice->length;
+    int run = 0;
+    while (run < max_steps && slice->entry < received) {
+        float value = challenge[slice->entry];
+        int end = slice->entry_end;
+        if (end - slice->step > max_steps - run) end = slice->step + (max_steps - run);
+        run += end - slice->step;
+        for (; slice->step < end; slice->step++) {
+            float modified_challenge = value * auth_step_factor(slice->step, slice->revision);
+            evolve_step_n(&slice->agent, slice->secret.k, slice->secret.gamma,
+                          modified_challenge, &slice->seed_state, slice->revision,
+                          slice->phi_size, slice->dt);
+        }
+        if (slice->step == slice->entry_end) {
+            slice->entry++;
+            slice->entry_end = auth_schedule_steps_n(slice->revision, slice->length,
+                                                     slice->entry + 1, slice->total_steps);
+        }
+    }
+    return run;
+}
+
+int auth_slice_remaining(const AuthSlice* slice) {
+    return slice->schedule_steps - slice->step;
+}
+
+int auth_slice_finish(const AuthSlice* slice, AuthResponse* out) {
+    if (slice->step < slice->schedule_steps) return 0;
+    *out = auth_agent_response_n(&slice->agent, slice->secret.k, slice->phi_size,
+                                 slice->revision);
+    return 1;
+}
+
 // Verify response - ALL 8 CHANNELS must match
 int auth_verify(const AuthResponse* received, const AuthResponse* expected, float tolerance) {
     return (fabsf(received->psi - expected->psi) < tolerance) &&
@@ -223,3 +620,138 @@ int auth_verify(const AuthResponse* received, const AuthResponse* expected, floa
            (fabsf(received->lorenz_z - expected->lorenz_z) < tolerance) &&
            (fabsf(received->entropy_hash - expected->entropy_hash) < tolerance);
 }
+
+// ===== QUANTIZED RESPONSES =====
+
+const int auth_i16_shift[8] = {12, 12, 14, 13, 10, 10, 10, 14};
+
+static int16_t quantize_channel(float x, int shift) {
+    float v = x * (float)(1 << shift);   // exact: a power of two
+    if (v != v) return AUTH_I16_INVALID;
+    if (v > 32767.0f) v = 32767.0f;
+    if (v < -32767.0f) v = -32767.0f;
+    // Adding and removing 1.5 * 2^23 rounds to the nearest integer (ties
+    // to even) without libm, the same on every IEEE target
+    v = (v + 12582912.0f) - 12582912.0f;
+    return (int16_t)v;
+}
+
+AuthResponseI16 auth_response_to_i16(const AuthResponse* resp) {
+    AuthResponseI16 q;
+    const float* v = (const float*)resp;
+    int16_t* out = (int16_t*)&q;
+    for (int c = 0; c < 8; c++) out[c] = quantize_channel(v[c], auth_i16_shift[c]);
+    return q;
+}
+
+AuthResponse auth_response_from_i16(const AuthResponseI16* q) {
+    AuthResponse resp;
+    const int16_t* in = (const int16_t*)q;
+    float* out = (float*)&resp;
+    for (int c = 0; c < 8; c++) {
+        out[c] = in[c] == AUTH_I16_INVALID ? NAN
+                                           : (float)in[c] / (float)(1 << auth_i16_shift[c]);
+    }
+    return resp;
+}
+
+int auth_verify_i16(const AuthResponseI16* received, const AuthResponseI16* expected,
+                    int tolerance) {
+    const int16_t* r = (const int16_t*)received;
+    const int16_t* e = (const int16_t*)expected;
+    for (int c = 0; c < 8; c++) {
+        if (r[c] == AUTH_I16_INVALID || e[c] == AUTH_I16_INVALID) return 0;
+        int d = (int)r[c] - (int)e[c];
+        if (d > tolerance || d < -tolerance) return 0;
+    }
+    return 1;
+}
+
+// ===== OFFLINE MODE =====
+
+void auth_challenge_from_id(uint32_t challenge_id, float* challenge, int length) {
+    uint32_t seed = challenge_id;
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345; // LCG
+        challenge[i] = ((float)(seed & 0xFFFF) / 65535.0f) * 3.0f;
+    }
+}
+
+void auth_table_header_init(AuthTableHeader* header, int revision, int challenge_length,
+                            uint32_t secret_count, uint32_t first_challenge_id,
+                            uint64_t challenge_count) {
+    memset(header, 0, sizeof(AuthTableHeader));
+    memcpy(header->magic, AUTH_TABLE_MAGIC, sizeof(header->magic));
+    header->version = AUTH_TABLE_VERSION;
+    header->byte_order = AUTH_TABLE_BYTE_ORDER;
+    header->revision = (uint32_t)revision;
+    header->challenge_length = (uint32_t)challenge_length;
+    header->secret_count = secret_count;
+    header->first_challenge_id = first_challenge_id;
+    header->challenge_count = challenge_count;
+}
+
+int auth_table_attach(AuthResponseTable* table, const void* base, uint64_t size) {
+    memset(table, 0, sizeof(AuthResponseTable));
+    if (size < sizeof(AuthTableHeader)) return 0;
+    
+    const AuthTableHeader* header = base;
+    if (memcmp(header->magic, AUTH_TABLE_MAGIC, sizeof(header->magic)) != 0) return 0;
+    if (header->version != AUTH_TABLE_VERSION) return 0;
+    if (header->byte_order != AUTH_TABLE_BYTE_ORDER) return 0;
+    if (!auth_revision_supported((int)header->revision)) return 0;
+    
+    // Ids are 32-bit; checked so count * secrets * 32 cannot overflow
+    if (header->challenge_count > (1ull << 32)) return 0;
+    uint64_t entries = header->challenge_count * header->secret_count;
+    if (entries > (size - sizeof(AuthTableHeader)) / sizeof(AuthResponse)) return 0;
+    
+    table->header = header;
+    table->responses = (const AuthResponse*)((const char*)base + sizeof(AuthTableHeader));
+    table->base = base;
+    table->size = size;
+    return 1;
+}
+
+int auth_table_open(AuthResponseTable* table, const char* path) {
+#ifdef AUTH_HAVE_MMAP
+    memset(table, 0, sizeof(AuthResponseTable));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (base == MAP_FAILED) return 0;
+    
+    if (!auth_table_attach(table, base, (uint64_t)st.st_size)) {
+        munmap(base, (size_t)st.st_size);
+        return 0;
+    }
+    table->mapped = 1;
+    return 1;
+#else
+    (void)path;
+    memset(table, 0, sizeof(AuthResponseTable));
+    return 0;
+#endif
+}
+
+void auth_table_close(AuthResponseTable* table) {
+#ifdef AUTH_HAVE_MMAP
+    if (table->mapped) munmap((void*)table->base, (size_t)table->size);
+#endif
+    memset(table, 0, sizeof(AuthResponseTable));
+}
+
+const AuthResponse* auth_table_lookup(const AuthResponseTable* table, uint32_t challenge_id,
+                                      uint32_t secret_index) {
+    const AuthTableHeader* header = table->header;
+    if (!header) return NULL;
+    uint64_t row = (uint32_t)(challenge_id - header->first_challenge_id);
+    if (row >= header->challenge_count || secret_index >= header->secret_count) return NULL;
+    return &table->responses[row * header->secret_count + secret_index];
+}
@@ -12,11 +12,44 @@
 #define DT 0.05f              // Smaller timestep for more iterations
 #define CHALLENGE_LENGTH 50
 #define EVOLUTION_STEPS 200      // 4x more steps than v1
+#define AUTH_BATCH_LANES 8       // Agents evolved in lockstep by the batch engine
+
+// Determinism mode (see physics_auth_simd.c). 1 = phi_avg is a sequential
+// sum, identical to every deployed client. 0 = fixed 8-lane vector
+// reduction; faster, but client and server must BOTH be built with 0.
+#ifndef AUTH_DETERMINISTIC
+#define AUTH_DETERMINISTIC 1
+#endif
+
+// Fixed-point build (physics_auth_fixed.c). 1 = auth_compute_response()
+// runs the Q16.16 integer engine, for FPU-less MCUs. Its responses are
+// NOT interoperable with the float engine - the verifier must compute
+// expected values with auth_compute_response_fixed() as well. Device-only:
+// every other entry point stays on the float engine, and the server side
+// (auth_pool.c, auth_verifier.c) refuses to build with it.
+#ifndef AUTH_FIXED_POINT
+#define AUTH_FIXED_POINT 0
+#endif
+
+// Constant-time build. 1 = evolve_step runs without secret-dependent
+// branches (selects instead of ifs, exact branch-free fmod, no integer
+// divide). Responses are bit-identical to the default build.
+#ifndef AUTH_CONSTANT_TIME
+#define AUTH_CONSTANT_TIME 0
+#endif
+
+// Instrumented build. 1 = evolve_step accumulates per-phase cycle counts
+// into per-thread counters (auth_phase_stats()). 0 = the hooks compile
+// to nothing.
+#ifndef AUTH_INSTRUMENT
+#define AUTH_INSTRUMENT 0
+#endif
 
 // Lorenz attractor parameters (for chaos)
 #define LORENZ_SIGMA 10.0f
 #define LORENZ_RHO 28.0f
 #define LORENZ_BETA 2.666667f
+#define LORENZ_DT 0.02f            // Lorenz integration step, independent of DT
 
 // Secret key structure (unchanged)
 typedef struct {
@@ -38,9 +71,338 @@ typedef struct {
     float entropy_hash;    // Nonlinear hash of all state
 } AuthResponse;
 
+// Agent state - now includes Lorenz variables (public for checkpoints)
+typedef struct {
+    float I;
+    float R;
+    float Psi;
+    float Phi[PHI_SIZE];
+    // NEW: Lorenz attractor state
+    float Lx, Ly, Lz;
+    // NEW: Running entropy accumulator
+    float entropy;
+    // Running sum of Phi, refreshed by the Phi kernel on every step
+    float phi_sum;
+} AgentState;
+
+// Engine revisions. A revision pins the exact float semantics of the
+// response; client and server must agree on one before authenticating.
+// Optimizations that keep results bit-identical stay within a revision.
+#define AUTH_ENGINE_REV_1 1      // v3 hardened engine (reference)
+#define AUTH_ENGINE_REV_2 2      // Phi position factors via angle-addition tables
+#define AUTH_ENGINE_REV_3 3      // REV_2 plus an explicit step schedule (auth_schedule_steps)
+#define AUTH_ENGINE_REV_4 4      // REV_3 with libm-free sin/cos (auth_math.h), same bits everywhere
+#define AUTH_ENGINE_REV_LATEST AUTH_ENGINE_REV_4
+
 // Core API
 void auth_init(void);
 AuthResponse auth_compute_response(const float* challenge, int length, const AuthSecret* secret);
 int auth_verify(const AuthResponse* received, const AuthResponse* expected, float tolerance);
 
+// Batch verification - bit n of match_mask ((count + 63) / 64 words, may be
+// NULL) is set when auth_verify(&received[n], &expected[n * expected_stride])
+// holds. Pass expected_stride = 0 to screen all responses against one
+// expected value. Uses the active SIMD backend; returns the match count.
+int auth_verify_batch(const AuthResponse* received, const AuthResponse* expected,
+                      int expected_stride, int count, float tolerance, uint64_t* match_mask);
+
+// Quantized responses - every channel as a 16-bit fixed-point value, 16
+// bytes instead of 32, for narrow uplinks (LoRa, BLE). Channel c is kept
+// in steps of 2^-auth_i16_shift[c], chosen from the channel's range:
+//   psi, i_val     |x| <= 5    shift 12, step 2.4e-4
+//   r_val          |x| < 0.4   shift 14, step 6.1e-5
+//   phi_avg        |x| <= 3    shift 13, step 1.2e-4
+//   lorenz_x/y/z   |x| <= 20   shift 10, step 9.8e-4
+//   entropy_hash   |x| < 2     shift 14, step 6.1e-5
+// Values round to nearest (ties to even) and saturate at +/-32767; NaN
+// becomes AUTH_I16_INVALID, which never verifies. Two floats closer than
+// the smallest step quantize at most one step apart, so verifying at
+// AUTH_I16_TOLERANCE accepts whatever auth_verify() accepts at
+// AUTH_VERIFIER_TOLERANCE - and also differences up to two steps, ~2e-3
+// on the Lorenz channels. That is a weaker check: the verifier applies it
+// only to devices that opted in (auth_verifier_allow_quantized(),
+// AUTH_STORE_QUANTIZED), never because a request says it is quantized.
+typedef struct {
+    int16_t psi;
+    int16_t i_val;
+    int16_t r_val;
+    int16_t phi_avg;
+    int16_t lorenz_x;
+    int16_t lorenz_y;
+    int16_t lorenz_z;
+    int16_t entropy_hash;
+} AuthResponseI16;
+
+#define AUTH_I16_INVALID INT16_MIN
+#define AUTH_I16_TOLERANCE 1            // steps
+
+extern const int auth_i16_shift[8];     // AuthResponse channel order
+
+AuthResponseI16 auth_response_to_i16(const AuthResponse* resp);
+AuthResponse auth_response_from_i16(const AuthResponseI16* q);   // AUTH_I16_INVALID -> NaN
+// |received - expected| <= tolerance steps on every channel, as integers
+int auth_verify_i16(const AuthResponseI16* received, const AuthResponseI16* expected,
+                    int tolerance);
+// auth_verify_batch() for quantized responses, on packed 16-bit lanes
+int auth_verify_batch_i16(const AuthResponseI16* received, const AuthResponseI16* expected,
+                          int expected_stride, int count, int tolerance, uint64_t* match_mask);
+
+// Revision negotiation - masks have bit r set when revision r is supported
+uint32_t auth_engine_revisions(void);
+int auth_engine_negotiate(uint32_t peer_revisions);   // highest common revision, 0 if none
+
+// Compute a response with an explicit revision; returns 0 if unsupported.
+// auth_compute_response() is AUTH_ENGINE_REV_1.
+int auth_compute_response_rev(const float* challenge, int length, const AuthSecret* secret,
+                              int revision, AuthResponse* out);
+
+// Step schedules - how many evolution steps each challenge entry gets.
+// REV_1/2: EVOLUTION_STEPS / length per entry (at least 1), so lengths
+// that do not divide EVOLUTION_STEPS silently run fewer steps in total.
+// REV_3: max(EVOLUTION_STEPS, length) steps in total, entry t running
+// steps [t * total / length, (t + 1) * total / length): the remainder is
+// spread evenly, and cost depends on length only beyond EVOLUTION_STEPS.
+// Where the REV_3 schedule is uniform (lengths dividing EVOLUTION_STEPS,
+// or at least EVOLUTION_STEPS) it is the REV_2 schedule.
+int auth_schedule_steps(int revision, int length, int entries);   // steps for entries [0, entries)
+int auth_schedule_uniform_steps(int revision, int length);        // per entry, 0 if not uniform
+
+// Profiles - the engine dimensions chosen at runtime, so one binary serves
+// battery-powered locks and high-security doors. A profile changes the
+// response: device and verifier must agree on it like on the revision.
+// "default" is the compile-time configuration above, bit-identical to
+// auth_compute_response_rev(). Each preset runs its own specialized
+// kernel; any other valid profile runs a generic one.
+typedef struct {
+    const char* name;
+    int phi_size;             // Phi cells in use, 1..PHI_SIZE
+    int evolution_steps;      // schedule total, 1..AUTH_PROFILE_MAX_STEPS
+    float dt;                 // state and field timestep
+    int challenge_length;     // entries per issued challenge, 1..CHALLENGE_LENGTH
+} AuthProfile;
+
+#define AUTH_PROFILE_MAX_STEPS 1000
+
+typedef enum {
+    AUTH_PROFILE_LOW_POWER = 0,   // ~1/10 the work: battery-powered locks
+    AUTH_PROFILE_DEFAULT,         // PHI_SIZE, EVOLUTION_STEPS, DT, CHALLENGE_LENGTH
+    AUTH_PROFILE_HARDENED,        // 3x the steps at half the timestep
+    AUTH_PROFILE_PRESETS
+} AuthProfileId;
+
+extern const AuthProfile auth_profile_presets[AUTH_PROFILE_PRESETS];
+
+const AuthProfile* auth_profile_find(const char* name);   // preset by name, NULL if unknown
+int auth_profile_valid(const AuthProfile* profile);
+
+// auth_compute_response_rev() under profile; the schedule spreads
+// profile->evolution_steps over length. Returns 0 if the revision is
+// unsupported or the profile invalid.
+int auth_compute_response_ex(const float* challenge, int length, const AuthSecret* secret,
+                             int revision, const AuthProfile* profile, AuthResponse* out);
+
+// Checkpoints - engine state after the first `consumed` challenge entries.
+// The steps per entry depend on the TOTAL challenge length, so a
+// checkpoint only resumes challenges of the same revision and schedule
+// (e.g. every length in 41..50 uses 4 steps per entry under REV_1/2; a
+// non-uniform REV_3 schedule only matches its own length).
+typedef struct {
+    AgentState agent;
+    uint32_t seed_state;
+    int revision;
+    int steps_per_challenge;  // uniform schedule, or 0 (scheduled per entry)
+    int total_length;         // the schedule's length when steps_per_challenge is 0
+    int consumed;             // challenge entries evolved so far
+} AuthCheckpoint;
+
+// Start a checkpoint for a challenge of total_length; 0 if revision unsupported
+int auth_checkpoint_begin(AuthCheckpoint* cp, const AuthSecret* secret, int total_length,
+                          int revision);
+// Evolve the next n entries (challenge[cp->consumed .. cp->consumed + n))
+void auth_checkpoint_advance(AuthCheckpoint* cp, const AuthSecret* secret,
+                             const float* entries, int n);
+AuthResponse auth_checkpoint_response(const AuthCheckpoint* cp, const AuthSecret* secret);
+int auth_steps_per_challenge(int length);
+
+// Streaming - evolve each challenge entry as soon as it is parsed, so
+// compute overlaps with receiving the challenge. The schedule depends on
+// the total length, so it is fixed by a length declared up front (a
+// length header, or CHALLENGE_LENGTH). finish() accepts any count with
+// the same schedule as the declared length (41..50 for 50 under REV_1/2,
+// only 50 under REV_3) and the response is then bit-identical to
+// auth_compute_response_rev() over the values fed; otherwise it returns 0
+// and the caller recomputes from its own copy of the values.
+typedef struct {
+    AuthCheckpoint cp;
+    AuthSecret secret;
+    int declared_length;
+} AuthStream;
+
+int auth_stream_begin(AuthStream* stream, const AuthSecret* secret, int declared_length,
+                      int revision);   // 0 if revision unsupported or length < 1
+// 0 (value ignored) once a longer challenge could no longer match the band
+int auth_stream_feed(AuthStream* stream, float value);
+int auth_stream_finish(const AuthStream* stream, AuthResponse* out);
+
+// Sliced computation - auth_compute_response_ex() split into resumable
+// slices of at most max_steps engine steps, for firmware that interleaves
+// compute with radio RX and sleeps between slices. The whole state is the
+// struct (no heap, no globals), so it can stay in retention SRAM through
+// stop modes. Entries may still be arriving: a slice never evolves past
+// the entries received so far.
+typedef struct {
+    AgentState agent;
+    uint32_t seed_state;
+    AuthSecret secret;
+    int revision;
+    int phi_size;
+    float dt;
+    int length;             // challenge entries
+    int total_steps;        // the profile's evolution_steps
+    int schedule_steps;     // steps the schedule runs over length entries
+    int step;               // steps run so far
+    int entry;              // challenge entry of the next step
+    int entry_end;          // first step of the entry after it
+} AuthSlice;
+
+// profile NULL is the default. 0 if the revision is unsupported, the
+// profile invalid or length < 1.
+int auth_slice_begin(AuthSlice* slice, const AuthSecret* secret, int length, int revision,
+                     const AuthProfile* profile);
+// Run at most max_steps steps over challenge[0 .. received). Returns the
+// steps run: 0 once done, or while waiting for entry slice->entry.
+int auth_slice_run(AuthSlice* slice, const float* challenge, int received, int max_steps);
+int auth_slice_remaining(const AuthSlice* slice);   // steps left, 0 when done
+// 0 until every step ran; the response is then bit-identical to
+// auth_compute_response_ex() over the same values
+int auth_slice_finish(const AuthSlice* slice, AuthResponse* out);
+
+// Offline challenges - the RTC LCG from the smart lock guide, seeded by
+// a challenge id (e.g. a timestamp). Entries are in [0, 3].
+void auth_challenge_from_id(uint32_t challenge_id, float* challenge, int length);
+
+// Precomputed response table (offline mode). On-disk layout: a 64-byte
+// header, then challenge_count rows of secret_count AuthResponses in host
+// byte order; row r holds the responses to challenge id first_challenge_id + r.
+#define AUTH_TABLE_MAGIC "PAUTHTBL"
+#define AUTH_TABLE_VERSION 1
+#define AUTH_TABLE_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;          // AUTH_TABLE_BYTE_ORDER as written
+    uint32_t revision;
+    uint32_t challenge_length;
+    uint32_t secret_count;
+    uint32_t first_challenge_id;
+    uint64_t challenge_count;
+    uint8_t reserved[24];
+} AuthTableHeader;
+
+// Read-only view of a table; lookups point straight into the mapping
+typedef struct {
+    const AuthTableHeader* header;
+    const AuthResponse* responses;
+    const void* base;
+    uint64_t size;
+    int mapped;                   // 1 if auth_table_open() owns an mmap
+} AuthResponseTable;
+
+void auth_table_header_init(AuthTableHeader* header, int revision, int challenge_length,
+                            uint32_t secret_count, uint32_t first_challenge_id,
+                            uint64_t challenge_count);
+// Validate a table already in memory (flash, or mapped by the caller); 0 if invalid
+int auth_table_attach(AuthResponseTable* table, const void* base, uint64_t size);
+// mmap a table file (POSIX builds only); 0 on failure
+int auth_table_open(AuthResponseTable* table, const char* path);
+void auth_table_close(AuthResponseTable* table);
+// NULL if the challenge id or secret index is outside the table
+const AuthResponse* auth_table_lookup(const AuthResponseTable* table, uint32_t challenge_id,
+                                      uint32_t secret_index);
+
+// Fixed-point engine - Q16.16 throughout: integer tanh, polynomial sin/cos,
+// integer wraps. Challenge entries saturate at +/-AUTH_Q16_INPUT_LIMIT.
+typedef int32_t auth_q16;
+#define AUTH_Q16_ONE 65536
+#define AUTH_Q16_INPUT_LIMIT 1024
+
+typedef struct {
+    auth_q16 k;
+    auth_q16 gamma;
+    uint32_t seed;
+} AuthSecretQ16;
+
+typedef struct {
+    auth_q16 psi;
+    auth_q16 i_val;
+    auth_q16 r_val;
+    auth_q16 phi_avg;
+    auth_q16 lorenz_x;
+    auth_q16 lorenz_y;
+    auth_q16 lorenz_z;
+    auth_q16 entropy_hash;
+} AuthResponseQ16;
+
+auth_q16 auth_q16_from_float(float x);   // saturating, NaN -> 0
+float auth_q16_to_float(auth_q16 x);
+AuthSecretQ16 auth_secret_to_q16(const AuthSecret* secret);
+AuthResponse auth_response_from_q16(const AuthResponseQ16* q);
+// auth_challenge_from_id() in Q16 without touching the FPU
+void auth_challenge_from_id_q16(uint32_t challenge_id, auth_q16* challenge, int length);
+void auth_compute_response_q16(const auth_q16* challenge, int length, const AuthSecretQ16* secret,
+                               AuthResponseQ16* out);
+// Float wrapper (what auth_compute_response() runs when AUTH_FIXED_POINT=1)
+AuthResponse auth_compute_response_fixed(const float* challenge, int length,
+                                         const AuthSecret* secret);
+
+// Per-phase cycle counters of evolve_step (AUTH_INSTRUMENT=1 builds; all
+// zero otherwise). Units are TSC cycles on x86, DWT CYCCNT cycles on
+// Cortex-M, generic-timer ticks on AArch64, ns elsewhere.
+typedef enum {
+    AUTH_PHASE_LORENZ = 0,   // Lorenz attractor update + wraps
+    AUTH_PHASE_CHAOS,        // logistic map kick + seed noise
+    AUTH_PHASE_STATE,        // I/R/Psi update + wraps
+    AUTH_PHASE_PHI,          // position factors + Phi field kernel
+    AUTH_PHASE_ENTROPY,      // entropy mixing
+    AUTH_PHASE_COUNT
+} AuthPhase;
+
+typedef struct {
+    uint64_t cycles[AUTH_PHASE_COUNT];
+    uint64_t steps;          // evolve_step calls counted
+} AuthPhaseStats;
+
+AuthPhaseStats auth_phase_stats(void);      // calling thread's counters
+void auth_phase_stats_reset(void);
+const char* auth_phase_name(AuthPhase phase);
+
+// SIMD backends for the Phi field kernel. auth_init() selects the widest
+// one the CPU supports; all backends produce bit-identical responses.
+typedef enum {
+    AUTH_SIMD_SCALAR = 0,
+    AUTH_SIMD_SSE2,
+    AUTH_SIMD_AVX2,
+    AUTH_SIMD_NEON
+} AuthSimdBackend;
+
+int auth_simd_select(AuthSimdBackend backend);   // 0 if unsupported on this CPU
+AuthSimdBackend auth_simd_active(void);
+const char* auth_simd_name(AuthSimdBackend backend);
+
+// Batch API - responses[n] is bit-identical to
+// auth_compute_response(challenges + n * challenge_stride, length, &secrets[n]).
+// Pass challenge_stride = 0 to broadcast a single challenge to every secret.
+void auth_compute_response_batch(const float* challenges, int length, int challenge_stride,
+                                 const AuthSecret* secrets, int count, AuthResponse* responses);
+// 0 if the revision is unsupported, length < 1 or count < 0
+int auth_compute_response_batch_rev(const float* challenges, int length, int challenge_stride,
+                                    const AuthSecret* secrets, int count, int revision,
+                                    AuthResponse* responses);
+// Under profile, bit-identical to auth_compute_response_ex(); 0 also if
+// the profile is invalid
+int auth_compute_response_batch_ex(const float* challenges, int length, int challenge_stride,
+                                   const AuthSecret* secrets, int count, int revision,
+                                   const AuthProfile* profile, AuthResponse* responses);
+
 #endif // PHYSICS_AUTH_V2_H
@@ -0,0 +1,396 @@
+// physics_auth_batch.c
+// Batched response engine - evolves AUTH_BATCH_LANES agents in lockstep
+//
+// The verifier precomputes expected responses for many registered devices
+// per challenge window. Instead of one scalar AgentState per secret, the
+// lanes are stored structure-of-arrays so every update in evolve_step runs
+// across lanes with unit stride (and auto-vectorizes at -O3).
+//
+// Each lane performs exactly the same float operations, in the same order,
+// as evolve_step() in physics_auth.c, so results are bit-identical to
+// auth_compute_response() and existing auth_verify() callers keep working.
+
+#include "physics_auth.h"
+#include "physics_auth_internal.h"
+#include <math.h>
+#include <string.h>
+
+#define L AUTH_BATCH_LANES
+
+// One value per lane. GCC/Clang vector extensions lower these to AVX,
+// SSE or NEON registers; each operator is a plain IEEE lane-wise op.
+typedef float lanes_f __attribute__((vector_size(sizeof(float) * L)));
+typedef int32_t lanes_i __attribute__((vector_size(sizeof(float) * L)));
+
+// mask ? a : b, lane by lane
+#define lanes_select(mask, a, b) \
+    ((lanes_f)(((lanes_i)(a) & (mask)) | ((lanes_i)(b) & ~(mask))))
+
+// Unaligned access - lane arrays on the stack are only float-aligned
+typedef float lanes_fu __attribute__((vector_size(sizeof(float) * L), aligned(sizeof(float))));
+#define lanes_load(p)     ((lanes_f)*(const lanes_fu*)(p))
+#define lanes_store(p, v) (*(lanes_fu*)(p) = (v))
+
+// Structure-of-arrays agent state: one column per lane
+typedef struct {
+    float I[L];
+    float R[L];
+    float Psi[L];
+    float Phi[PHI_SIZE][L];
+    float Lx[L], Ly[L], Lz[L];
+    float entropy[L];
+    float phi_sum[L];
+    uint32_t seed_state[L];
+    float k[L];
+    float gamma[L];
+} __attribute__((aligned(64))) AgentStateBatch;
+
+// Branch-free form of fast_tanh() - same result for every input,
+// written as selects so the lane loops stay vectorizable. Constant-time
+// builds clamp with bit selects, as fast_tanh() does, rather than trust
+// the compiler to turn ternaries into blends.
+static inline float lane_tanh(float x) {
+#if AUTH_CONSTANT_TIME
+    x = auth_ct_select(x < -3.0f, -3.0f, x);
+    x = auth_ct_select(x > 3.0f, 3.0f, x);
+    float x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+#else
+    float x2 = x * x;
+    float t = x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    t = (x < -3.0f) ? -1.0f : t;
+    t = (x > 3.0f) ? 1.0f : t;
+    return t;
+#endif
+}
+
+// Load lanes [0, n) from scalar agents; unused lanes replicate lane 0
+static void batch_load(AgentStateBatch* b, const AuthSecret* secrets, int n, int phi_size) {
+    for (int l = 0; l < L; l++) {
+        const AuthSecret* s = &secrets[l < n ? l : 0];
+        AgentState a;
+        auth_agent_init_n(&a, s->seed, phi_size);
+
+        b->I[l] = a.I;
+        b->R[l] = a.R;
+        b->Psi[l] = a.Psi;
+        for (int i = 0; i < phi_size; i++) b->Phi[i][l] = a.Phi[i];
+        b->Lx[l] = a.Lx;
+        b->Ly[l] = a.Ly;
+        b->Lz[l] = a.Lz;
+        b->entropy[l] = a.entropy;
+        b->phi_sum[l] = a.phi_sum;
+        b->seed_state[l] = s->seed;
+        b->k[l] = s->k;
+        b->gamma[l] = s->gamma;
+    }
+}
+
+static void batch_extract(const AgentStateBatch* b, int l, AgentState* a, int phi_size) {
+    a->I = b->I[l];
+    a->R = b->R[l];
+    a->Psi = b->Psi[l];
+    for (int i = 0; i < phi_size; i++) a->Phi[i] = b->Phi[i][l];
+    a->Lx = b->Lx[l];
+    a->Ly = b->Ly[l];
+    a->Lz = b->Lz[l];
+    a->entropy = b->entropy[l];
+    a->phi_sum = b->phi_sum[l];
+}
+
+// Lane-parallel evolve_step_n - see physics_auth.c for the commented scalar
+// form; the scalar stages are the shared auth_step_* of physics_auth_internal.h
+__attribute__((always_inline))
+static inline void evolve_step_batch(AgentStateBatch* restrict b,
+                                     const float* restrict phi_input, int revision,
+                                     int phi_size, float dt_value) {
+    float chaos_kick[L];
+    float seed_noise[L];
+    float phi_avg[L];
+
+    // ===== LORENZ ATTRACTOR =====
+    for (int l = 0; l < L; l++) auth_step_lorenz(&b->Lx[l], &b->Ly[l], &b->Lz[l], phi_input[l]);
+
+    // Wraps are rare - keep the fmodf calls out of the arithmetic loops
+    for (int l = 0; l < L; l++) {
+        b->Lx[l] = auth_wrap(b->Lx[l], 1.0f, 20.0f);
+        b->Ly[l] = auth_wrap(b->Ly[l], 1.0f, 20.0f);
+        b->Lz[l] = auth_wrap(b->Lz[l], 1.0f, 20.0f);
+    }
+
+    // ===== DISCRETE CHAOS INJECTION (Logistic Map) =====
+    for (int l = 0; l < L; l++) {
+        float x = 0.5f + 0.5f * lane_tanh(b->Psi[l]);
+        float r = 3.9f + 0.09f * lane_tanh(b->Lx[l] * 0.1f);
+        chaos_kick[l] = auth_step_chaos_kick(x, r);
+    }
+
+    // ===== CONTINUOUS SEED INFLUENCE =====
+    for (int l = 0; l < L; l++) seed_noise[l] = auth_step_seed_noise(&b->seed_state[l]);
+
+    // ===== PHYSICS EVOLUTION =====
+    for (int l = 0; l < L; l++) phi_avg[l] = b->phi_sum[l] / phi_size;
+
+    for (int l = 0; l < L; l++) {
+        auth_step_state(&b->I[l], &b->R[l], &b->Psi[l], b->k[l], b->gamma[l], phi_avg[l],
+                        chaos_kick[l], seed_noise[l], dt_value);
+    }
+
+    for (int l = 0; l < L; l++) {
+        b->I[l] = auth_wrap(b->I[l], 1.5f, 5.0f);
+        b->Psi[l] = auth_wrap(b->Psi[l], 1.5f, 5.0f);
+    }
+
+    // ===== PHI FIELD EVOLUTION =====
+    float sin_lx[L] = {0}, cos_lx[L] = {0};
+    if (revision >= AUTH_ENGINE_REV_2) {
+        if (revision >= AUTH_ENGINE_REV_4) {
+            // The in-range form is branch-free and vectorizes; the general
+            // one gives the same bits
+            int in_range = 1;
+            for (int l = 0; l < L; l++) in_range &= fabsf(b->Lx[l]) <= AUTH_MATH_REDUCE_MAX;
+            if (in_range) {
+                for (int l = 0; l < L; l++) {
+                    auth_sincosf_reduced(b->Lx[l], &sin_lx[l], &cos_lx[l]);
+                }
+            } else {
+                for (int l = 0; l < L; l++) auth_sincosf(b->Lx[l], &sin_lx[l], &cos_lx[l]);
+            }
+        } else {
+            for (int l = 0; l < L; l++) {
+                sin_lx[l] = sinf(b->Lx[l]);
+                cos_lx[l] = cosf(b->Lx[l]);
+            }
+        }
+    }
+    const float* sin_half = auth_sin_half_table(revision);
+    const float* cos_half = auth_cos_half_table(revision);
+
+    const lanes_i sign = (lanes_i){0} + (int32_t)0x80000000;
+    const lanes_i abs_mask = ~sign;
+    lanes_f psi_half = lanes_load(b->Psi) * 0.5f;
+    lanes_f drive = lanes_load(phi_input) * 0.1f;
+    lanes_f vsin_lx = lanes_load(sin_lx), vcos_lx = lanes_load(cos_lx);
+#if AUTH_DETERMINISTIC
+    lanes_f sum = (lanes_f){0};
+#else
+    lanes_f part[8] = {{0}};
+#endif
+
+    for (int i = 0; i < phi_size; i++) {
+        float* phi = b->Phi[i];
+        lanes_f pf;
+
+        if (revision >= AUTH_ENGINE_REV_2) {
+            pf = sin_half[i] * vcos_lx + cos_half[i] * vsin_lx;
+        } else {
+            float position_factor[L];
+            for (int l = 0; l < L; l++) {
+                position_factor[l] = sinf((float)i * 0.5f + b->Lx[l]);
+            }
+            pf = lanes_load(position_factor);
+        }
+
+        // fast_tanh(Psi * 0.5 - Phi) with selects for the saturation branches
+        lanes_f p = lanes_load(phi);
+        lanes_f x = psi_half - p;
+        lanes_f x2 = x * x;
+        lanes_f t = x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        t = lanes_select(x < -3.0f, (lanes_f){0} - 1.0f, t);
+        t = lanes_select(x > 3.0f, (lanes_f){0} + 1.0f, t);
+
+        p = p + (t * 0.2f + drive * pf) * dt_value;
+
+        // Wrap as in physics_auth_simd.c: x - 3*sign(x) is exact for
+        // 3 < |x| < 6
+        lanes_f a = (lanes_f)((lanes_i)p & abs_mask);
+#if AUTH_CONSTANT_TIME
+        // Far lanes clamp to just below 6 first, like auth_ct_fmod(p, 3, 0),
+        // so every lane runs the same instructions
+        lanes_i far = a >= 6.0f;
+        lanes_f near = lanes_select(far, (lanes_f){0} + auth_ct_below(6.0f), a);
+        lanes_f w = (lanes_f)(((lanes_i)p & sign) | (lanes_i)(near - 3.0f));
+        lanes_f out = lanes_select(a > 3.0f, w, p);
+#else
+        // Anything further out takes fmodf afterwards
+        lanes_f w = p - (lanes_f)(((lanes_i)p & sign) | (lanes_i)((lanes_f){0} + 3.0f));
+        lanes_f out = lanes_select(a > 3.0f, w, p);
+        lanes_i far = a >= 6.0f;
+        int any_far = 0;
+        for (int l = 0; l < L; l++) any_far |= far[l];
+        if (any_far) {
+            for (int l = 0; l < L; l++) {
+                if (far[l]) out[l] = fmodf(p[l], 3.0f);
+            }
+        }
+#endif
+        lanes_store(phi, out);
+
+        // Running sum in the same order as auth_phi_sum()
+#if AUTH_DETERMINISTIC
+        sum += out;
+#else
+        part[i & 7] += out;
+#endif
+    }
+#if AUTH_DETERMINISTIC
+    lanes_store(b->phi_sum, sum);
+#else
+    lanes_store(b->phi_sum, ((part[0] + part[4]) + (part[2] + part[6])) +
+                            ((part[1] + part[5]) + (part[3] + part[7])));
+#endif
+
+    // ===== ENTROPY ACCUMULATION =====
+    if (revision >= AUTH_ENGINE_REV_4) {
+        int in_range = 1;
+        for (int l = 0; l < L; l++) {
+            in_range &= auth_mix_in_range(b->Psi[l], b->Lx[l], phi_input[l]);
+        }
+        if (in_range) {
+            for (int l = 0; l < L; l++) {
+                b->entropy[l] += mix_nonlinear_portable_reduced(b->Psi[l], b->Lx[l],
+                                                                phi_input[l]);
+            }
+        } else {
+            for (int l = 0; l < L; l++) {
+                b->entropy[l] += mix_nonlinear_portable(b->Psi[l], b->Lx[l], phi_input[l]);
+            }
+        }
+    } else {
+        for (int l = 0; l < L; l++) {
+            b->entropy[l] += mix_nonlinear(b->Psi[l], b->Lx[l], phi_input[l]);
+        }
+    }
+    for (int l = 0; l < L; l++) b->entropy[l] = auth_wrap_entropy(b->entropy[l]);
+}
+
+// Evaluate up to L secrets in lockstep under a profile's dimensions;
+// steps_per_challenge > 0 is a known uniform schedule. Instantiated with
+// constants per preset below.
+__attribute__((always_inline))
+static inline void compute_lanes_n(const float* challenges, int length, int challenge_stride,
+                                   const AuthSecret* secrets, int n, int revision,
+                                   AuthResponse* responses, int phi_size, int total_steps,
+                                   float dt_value, int steps_per_challenge) {
+    AgentStateBatch b;
+    const float* lane_challenge[L];
+    float phi_input[L];
+
+    batch_load(&b, secrets, n, phi_size);
+    for (int l = 0; l < L; l++) {
+        lane_challenge[l] = challenges + (size_t)(l < n ? l : 0) * challenge_stride;
+    }
+
+    int total_step = 0;
+    for (int t = 0; t < length; t++) {
+        int end = steps_per_challenge > 0
+                      ? total_step + steps_per_challenge
+                      : auth_schedule_steps_n(revision, length, t + 1, total_steps);
+        for (; total_step < end; total_step++) {
+            float step_mod = auth_step_factor(total_step, revision);
+            for (int l = 0; l < L; l++) phi_input[l] = lane_challenge[l][t] * step_mod;
+            evolve_step_batch(&b, phi_input, revision, phi_size, dt_value);
+        }
+    }
+
+    for (int l = 0; l < n; l++) {
+        AgentState a;
+        batch_extract(&b, l, &a, phi_size);
+        responses[l] = auth_agent_response_n(&a, b.k[l], phi_size, revision);
+    }
+}
+
+// Compile-time engine (the default profile)
+static void compute_lanes(const float* challenges, int length, int challenge_stride,
+                          const AuthSecret* secrets, int n, int revision,
+                          AuthResponse* responses) {
+    int steps_per_challenge = auth_schedule_uniform_steps(revision, length);
+#if EVOLUTION_STEPS % CHALLENGE_LENGTH == 0
+    // Standard length: constant trip counts under every revision
+    if (length == CHALLENGE_LENGTH) {
+        compute_lanes_n(challenges, CHALLENGE_LENGTH, challenge_stride, secrets, n, revision,
+                        responses, PHI_SIZE, EVOLUTION_STEPS, DT,
+                        EVOLUTION_STEPS / CHALLENGE_LENGTH);
+        return;
+    }
+#endif
+    compute_lanes_n(challenges, length, challenge_stride, secrets, n, revision, responses,
+                    PHI_SIZE, EVOLUTION_STEPS, DT, steps_per_challenge);
+}
+
+// Presets - the same dimensions as their scalar kernels in physics_auth.c
+static void compute_lanes_preset(const float* challenges, int length, int challenge_stride,
+                                 const AuthSecret* secrets, int n, int revision,
+                                 const AuthProfile* profile, int preset,
+                                 AuthResponse* responses) {
+    int uniform = auth_schedule_uniform_steps_n(revision, length, profile->evolution_steps);
+    switch (preset) {
+    case AUTH_PROFILE_DEFAULT:
+        compute_lanes(challenges, length, challenge_stride, secrets, n, revision, responses);
+        break;
+    case AUTH_PROFILE_LOW_POWER:
+        if (length == AUTH_LOW_POWER_LENGTH) {
+            compute_lanes_n(challenges, AUTH_LOW_POWER_LENGTH, challenge_stride, secrets, n,
+                            revision, responses, AUTH_LOW_POWER_PHI, AUTH_LOW_POWER_STEPS,
+                            AUTH_LOW_POWER_DT, AUTH_LOW_POWER_STEPS / AUTH_LOW_POWER_LENGTH);
+        } else {
+            compute_lanes_n(challenges, length, challenge_stride, secrets, n, revision,
+                            responses, AUTH_LOW_POWER_PHI, AUTH_LOW_POWER_STEPS,
+                            AUTH_LOW_POWER_DT, uniform);
+        }
+        break;
+    case AUTH_PROFILE_HARDENED:
+        if (length == CHALLENGE_LENGTH) {
+            compute_lanes_n(challenges, CHALLENGE_LENGTH, challenge_stride, secrets, n, revision,
+                            responses, PHI_SIZE, AUTH_HARDENED_STEPS, AUTH_HARDENED_DT,
+                            AUTH_HARDENED_STEPS / CHALLENGE_LENGTH);
+        } else {
+            compute_lanes_n(challenges, length, challenge_stride, secrets, n, revision,
+                            responses, PHI_SIZE, AUTH_HARDENED_STEPS, AUTH_HARDENED_DT, uniform);
+        }
+        break;
+    default:
+        compute_lanes_n(challenges, length, challenge_stride, secrets, n, revision, responses,
+                        profile->phi_size, profile->evolution_steps, profile->dt, uniform);
+        break;
+    }
+}
+
+int auth_compute_response_batch_rev(const float* challenges, int length, int challenge_stride,
+                                    const AuthSecret* secrets, int count, int revision,
+                                    AuthResponse* responses) {
+    if (!auth_revision_supported(revision) || length < 1 || count < 0) return 0;
+    auth_tables_ensure();
+
+    for (int base = 0; base < count; base += L) {
+        int n = count - base < L ? count - base : L;
+        compute_lanes(challenges + (size_t)base * challenge_stride, length, challenge_stride,
+                      secrets + base, n, revision, responses + base);
+    }
+    return 1;
+}
+
+int auth_compute_response_batch_ex(const float* challenges, int length, int challenge_stride,
+                                   const AuthSecret* secrets, int count, int revision,
+                                   const AuthProfile* profile, AuthResponse* responses) {
+    if (!auth_revision_supported(revision) || !auth_profile_valid(profile) || length < 1 ||
+        count < 0) {
+        return 0;
+    }
+    auth_tables_ensure();
+
+    int preset = auth_profile_preset_id(profile);
+    for (int base = 0; base < count; base += L) {
+        int n = count - base < L ? count - base : L;
+        compute_lanes_preset(challenges + (size_t)base * challenge_stride, length,
+                             challenge_stride, secrets + base, n, revision, profile, preset,
+                             responses + base);
+    }
+    return 1;
+}
+
+void auth_compute_response_batch(const float* challenges, int length, int challenge_stride,
+                                 const AuthSecret* secrets, int count, AuthResponse* responses) {
+    auth_compute_response_batch_rev(challenges, length, challenge_stride, secrets, count,
+                                    AUTH_ENGINE_REV_1, responses);
+}
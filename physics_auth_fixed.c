@@ -0,0 +1,335 @@
+// physics_auth_fixed.c
+// Q16.16 fixed-point engine for FPU-less and low-power MCUs (Cortex-M0/M4)
+//
+// Same dynamics as the float engine, evaluated in integers only:
+// - products are 32x32->64 bit and shifted back to Q16.16
+// - fast_tanh keeps its rational form, divided in 32-bit pieces (no
+//   __aeabi_ldivmod on Cortex-M)
+// - sin/cos are a degree-11 odd polynomial in Q2.30 after exact range
+//   reduction with 2*pi in Q32, accurate to ~1 LSB
+// - fmodf(x, m) becomes x % m (C remainder has fmodf's sign convention)
+// - position factors use the REV_2 angle-addition form, so each step needs
+//   one sin/cos pair instead of PHI_SIZE sines
+//
+// The chaotic dynamics amplify the ~1e-5 quantization error, so responses
+// differ from the float engine after a few steps. fixed_crosscheck.c checks
+// the primitives and single steps against the float reference instead.
+
+#include "physics_auth.h"
+#include "physics_auth_internal.h"
+#include <stddef.h>
+
+typedef int64_t q64;
+
+// Constant conversion - folded at compile time, no FPU needed at run time
+#define Q16(x) ((auth_q16)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+#define Q30(x) ((q64)((x) * 1073741824.0 + 0.5))
+
+// Constant multipliers in Q8.24 (|k| < 128) - Q16 would put a relative
+// error of up to 4e-4 on small constants such as dt
+#define K24(x) ((q64)((x) * 16777216.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+#define Q16_INPUT_LIMIT (AUTH_Q16_INPUT_LIMIT * AUTH_Q16_ONE)
+
+// 2*pi and friends in Q32 for range reduction
+#define TWO_PI_Q32 26986075409LL
+#define PI_Q32 13493037705LL
+#define HALF_PI_Q32 6746518852LL
+#define INV_TWO_PI_Q32 683565276LL
+
+static inline auth_q16 qmul(auth_q16 a, auth_q16 b) {
+    return (auth_q16)(((q64)a * b) >> 16);
+}
+
+static inline auth_q16 kmul(auth_q16 a, q64 k) {
+    return (auth_q16)(((q64)a * k) >> 24);
+}
+
+static inline auth_q16 q16_abs(auth_q16 x) {
+    return x < 0 ? -x : x;
+}
+
+static inline q64 mul30(q64 a, q64 b) {
+    return (a * b) >> 30;
+}
+
+// ===== PRIMITIVES =====
+
+// sin of r in Q32, |r| <= pi (plus rounding slack)
+static auth_q16 sin_reduced(q64 r) {
+    // Fold into [-pi/2, pi/2]: sin(x) = sin(pi - x)
+    if (r > HALF_PI_Q32) r = PI_Q32 - r;
+    else if (r < -HALF_PI_Q32) r = -PI_Q32 - r;
+
+    q64 x = r >> 2;               // Q30
+    q64 x2 = mul30(x, x);
+    q64 t = Q30(1.0) - mul30(x2, Q30(1.0 / 110.0));
+    t = Q30(1.0) - mul30(mul30(x2, Q30(1.0 / 72.0)), t);
+    t = Q30(1.0) - mul30(mul30(x2, Q30(1.0 / 42.0)), t);
+    t = Q30(1.0) - mul30(mul30(x2, Q30(1.0 / 20.0)), t);
+    t = Q30(1.0) - mul30(mul30(x2, Q30(1.0 / 6.0)), t);
+    q64 s = mul30(x, t);
+    return (auth_q16)((s + (1 << 13)) >> 14);
+}
+
+// x mod 2*pi into [-pi, pi], in Q32
+static q64 reduce_angle(auth_q16 x) {
+    q64 k = ((q64)x * INV_TWO_PI_Q32 + (1LL << 47)) >> 48;
+    return ((q64)x << 16) - k * TWO_PI_Q32;
+}
+
+auth_q16 auth_q16_sin(auth_q16 x) {
+    return sin_reduced(reduce_angle(x));
+}
+
+auth_q16 auth_q16_cos(auth_q16 x) {
+    q64 r = reduce_angle(x) + HALF_PI_Q32;
+    if (r > PI_Q32) r -= TWO_PI_Q32;
+    return sin_reduced(r);
+}
+
+// (num << 16) / den, truncated, for |num| <= den < 2^23: the integer bit
+// by compare, then two 8-bit digits of long division, each a 32-bit divide
+static inline auth_q16 q16_div_unit(auth_q16 num, auth_q16 den) {
+    uint32_t n = (uint32_t)q16_abs(num), d = (uint32_t)den;
+    uint32_t q = 0;
+    if (n >= d) {
+        n -= d;
+        q = 1;
+    }
+    n <<= 8;
+    q = (q << 8) | (n / d);
+    n = (n % d) << 8;
+    q = (q << 8) | (n / d);
+    return num < 0 ? -(auth_q16)q : (auth_q16)q;
+}
+
+auth_q16 auth_q16_tanh(auth_q16 x) {
+    if (x < -Q16(3.0)) return -AUTH_Q16_ONE;
+    if (x > Q16(3.0)) return AUTH_Q16_ONE;
+    auth_q16 x2 = qmul(x, x);
+    auth_q16 num = qmul(x, Q16(27.0) + x2);   // |num| <= den: |x(27 + x^2)| <= 27 + 9x^2 on [-3, 3]
+    auth_q16 den = Q16(27.0) + 9 * x2;         // < Q16(109)
+    return q16_div_unit(num, den);
+}
+
+static auth_q16 q16_mix_nonlinear(auth_q16 a, auth_q16 b, auth_q16 c) {
+    auth_q16 x = qmul(auth_q16_sin(kmul(a, K24(3.14159))), auth_q16_cos(kmul(b, K24(2.71828))));
+    auth_q16 y = auth_q16_tanh(qmul(c, x));
+    return qmul(x, y) + auth_q16_sin(qmul(a, b) + c);
+}
+
+// (x & 0xFFFF) / 65535 * scale without a divide by a variable
+static inline auth_q16 q16_unit_noise(uint32_t x, auth_q16 scale) {
+    return (auth_q16)(((x & 0xFFFF) * (uint32_t)scale) / 65535u);
+}
+
+// ===== ENGINE =====
+
+// sin(i * 0.5) and cos(i * 0.5) with the integer sine; filled by
+// auth_tables_init() together with the float tables
+static auth_q16 q16_sin_half[PHI_SIZE];
+static auth_q16 q16_cos_half[PHI_SIZE];
+
+void auth_q16_tables_init(void) {
+    for (int i = 0; i < PHI_SIZE; i++) {
+        q16_sin_half[i] = auth_q16_sin(i * (AUTH_Q16_ONE / 2));
+        q16_cos_half[i] = auth_q16_cos(i * (AUTH_Q16_ONE / 2));
+    }
+}
+
+void auth_q16_agent_init(AgentStateQ16* agent, uint32_t seed) {
+    uint32_t rng_state = seed;
+
+    agent->I = Q16(0.1);
+    agent->R = Q16(0.1);
+    agent->Psi = Q16(0.1);
+
+    agent->phi_sum = 0;
+    for (int i = 0; i < PHI_SIZE; i++) {
+        agent->Phi[i] = q16_unit_noise(xorshift32(&rng_state), Q16(0.1));
+        agent->phi_sum += agent->Phi[i];
+    }
+
+    agent->Lx = AUTH_Q16_ONE + q16_unit_noise(xorshift32(&rng_state), Q16(0.01));
+    agent->Ly = AUTH_Q16_ONE + q16_unit_noise(xorshift32(&rng_state), Q16(0.01));
+    agent->Lz = AUTH_Q16_ONE + q16_unit_noise(xorshift32(&rng_state), Q16(0.01));
+
+    agent->entropy = 0;
+}
+
+void auth_q16_evolve_step(AgentStateQ16* agent, auth_q16 k, auth_q16 gamma,
+                          auth_q16 phi_input, uint32_t* seed_state) {
+    // ===== LORENZ ATTRACTOR =====
+    auth_q16 dLx = 10 * (agent->Ly - agent->Lx);
+    auth_q16 dLy = qmul(agent->Lx, Q16(LORENZ_RHO) - agent->Lz) - agent->Ly;
+    auth_q16 dLz = qmul(agent->Lx, agent->Ly) - kmul(agent->Lz, K24(LORENZ_BETA));
+
+    dLx += phi_input * 2;
+
+    agent->Lx += kmul(dLx, K24(LORENZ_DT));
+    agent->Ly += kmul(dLy, K24(LORENZ_DT));
+    agent->Lz += kmul(dLz, K24(LORENZ_DT));
+
+    if (q16_abs(agent->Lx) > Q16(20.0)) agent->Lx %= Q16(20.0);
+    if (q16_abs(agent->Ly) > Q16(20.0)) agent->Ly %= Q16(20.0);
+    if (q16_abs(agent->Lz) > Q16(20.0)) agent->Lz %= Q16(20.0);
+
+    // ===== DISCRETE CHAOS INJECTION (Logistic Map) =====
+    auth_q16 x = Q16(0.5) + kmul(auth_q16_tanh(agent->Psi), K24(0.5));
+    auth_q16 r = Q16(3.9) + kmul(auth_q16_tanh(kmul(agent->Lx, K24(0.1))), K24(0.09));
+    for (int i = 0; i < 3; i++) x = qmul(qmul(r, x), AUTH_Q16_ONE - x);
+    auth_q16 chaos_kick = (x - Q16(0.5)) * 2;
+
+    // ===== CONTINUOUS SEED INFLUENCE =====
+    auth_q16 seed_noise = q16_unit_noise(xorshift32(seed_state), Q16(0.1));
+
+    // ===== PHYSICS EVOLUTION =====
+    auth_q16 phi_avg = agent->phi_sum / PHI_SIZE;
+
+    auth_q16 dI = qmul(k, phi_avg) + kmul(chaos_kick, K24(0.5)) -
+                  kmul(agent->I, K24(U_E / I_CHAR * 0.5));
+    auth_q16 dR = qmul(kmul(agent->I, K24(0.1)), agent->Psi) -
+                  kmul(agent->R, K24(2.0 * U_E / R_CHAR * 0.3));
+    auth_q16 dPsi = kmul(agent->I, K24(ALPHA_PSI)) - kmul(agent->R, K24(BETA_PSI)) -
+                    qmul(gamma, agent->Psi);
+
+    agent->I += kmul(dI, K24(DT)) + seed_noise;
+    agent->R += kmul(dR, K24(DT));
+    agent->Psi += kmul(dPsi, K24(DT));
+
+    if (q16_abs(agent->I) > Q16(5.0)) agent->I = kmul(agent->I, K24(1.5)) % Q16(5.0);
+    if (q16_abs(agent->Psi) > Q16(5.0)) agent->Psi = kmul(agent->Psi, K24(1.5)) % Q16(5.0);
+
+    // ===== PHI FIELD EVOLUTION =====
+    auth_q16 sin_lx = auth_q16_sin(agent->Lx);
+    auth_q16 cos_lx = auth_q16_cos(agent->Lx);
+    auth_q16 psi_half = agent->Psi / 2;
+    auth_q16 drive = kmul(phi_input, K24(0.1));
+    auth_q16 sum = 0;
+    for (int i = 0; i < PHI_SIZE; i++) {
+        auth_q16 pf = qmul(q16_sin_half[i], cos_lx) + qmul(q16_cos_half[i], sin_lx);
+        auth_q16 phi = agent->Phi[i];
+        auth_q16 source = auth_q16_tanh(psi_half - phi);
+        phi += kmul(kmul(source, K24(0.2)) + qmul(drive, pf), K24(DT));
+        if (q16_abs(phi) > Q16(3.0)) phi %= Q16(3.0);
+        agent->Phi[i] = phi;
+        sum += phi;
+    }
+    agent->phi_sum = sum;
+
+    // ===== ENTROPY ACCUMULATION =====
+    agent->entropy += q16_mix_nonlinear(agent->Psi, agent->Lx, phi_input);
+    agent->entropy %= Q16(1000.0);
+}
+
+AuthResponseQ16 auth_q16_agent_response(const AgentStateQ16* agent, auth_q16 k) {
+    auth_q16 phi_avg = agent->phi_sum / PHI_SIZE;
+
+    auth_q16 entropy_hash = q16_mix_nonlinear(agent->Psi, agent->I, agent->R);
+    entropy_hash += q16_mix_nonlinear(agent->Lx, agent->Ly, agent->Lz);
+    entropy_hash += q16_mix_nonlinear(phi_avg, agent->entropy, k);
+    entropy_hash = auth_q16_tanh(entropy_hash);
+
+    AuthResponseQ16 resp;
+    resp.psi = agent->Psi;
+    resp.i_val = agent->I;
+    resp.r_val = agent->R;
+    resp.phi_avg = phi_avg;
+    resp.lorenz_x = agent->Lx;
+    resp.lorenz_y = agent->Ly;
+    resp.lorenz_z = agent->Lz;
+    resp.entropy_hash = entropy_hash + kmul(agent->entropy, K24(0.001));
+    return resp;
+}
+
+// Either q_challenge (Q16) or f_challenge (float, converted per entry so
+// any length runs in constant stack) is set
+static void compute_response_q16(const auth_q16* q_challenge, const float* f_challenge,
+                                 int length, const AuthSecretQ16* secret, AuthResponseQ16* out) {
+    auth_tables_ensure();
+
+    AgentStateQ16 agent;
+    uint32_t seed_state = secret->seed;
+    auth_q16_agent_init(&agent, secret->seed);
+
+    // step * 0.1 in Q16, truncated, kept as step / 10 and step % 10 so no
+    // step needs a divide: whole radians plus one of ten fractions
+    static const auth_q16 tenths[10] = {0, 6553, 13107, 19660, 26214,
+                                        32768, 39321, 45875, 52428, 58982};
+    int steps_per_challenge = auth_steps_per_challenge(length);
+    uint32_t step_whole = 0;   // wraps like the Q16 angle it feeds
+    int step_tenth = 0;
+    for (int t = 0; t < length; t++) {
+        auth_q16 entry = q_challenge ? q_challenge[t] : auth_q16_from_float(f_challenge[t]);
+        if (entry > Q16_INPUT_LIMIT) entry = Q16_INPUT_LIMIT;
+        if (entry < -Q16_INPUT_LIMIT) entry = -Q16_INPUT_LIMIT;
+        for (int s = 0; s < steps_per_challenge; s++) {
+            // 1 + 0.01 * sin(step * 0.1)
+            auth_q16 angle = (auth_q16)(step_whole + (uint32_t)tenths[step_tenth]);
+            auth_q16 step_mod = AUTH_Q16_ONE + kmul(auth_q16_sin(angle), K24(0.01));
+            auth_q16_evolve_step(&agent, secret->k, secret->gamma, qmul(entry, step_mod),
+                                 &seed_state);
+            if (++step_tenth == 10) {
+                step_tenth = 0;
+                step_whole += AUTH_Q16_ONE;
+            }
+        }
+    }
+
+    *out = auth_q16_agent_response(&agent, secret->k);
+}
+
+void auth_compute_response_q16(const auth_q16* challenge, int length, const AuthSecretQ16* secret,
+                               AuthResponseQ16* out) {
+    compute_response_q16(challenge, NULL, length, secret, out);
+}
+
+// ===== CONVERSIONS =====
+
+auth_q16 auth_q16_from_float(float x) {
+    if (x != x) return 0;
+    if (x >= 32767.0f) return INT32_MAX;
+    if (x <= -32768.0f) return INT32_MIN;
+    return (auth_q16)(x * 65536.0f + (x >= 0.0f ? 0.5f : -0.5f));
+}
+
+float auth_q16_to_float(auth_q16 x) {
+    return (float)x / 65536.0f;
+}
+
+AuthSecretQ16 auth_secret_to_q16(const AuthSecret* secret) {
+    AuthSecretQ16 q = {auth_q16_from_float(secret->k), auth_q16_from_float(secret->gamma),
+                       secret->seed};
+    return q;
+}
+
+AuthResponse auth_response_from_q16(const AuthResponseQ16* q) {
+    AuthResponse resp;
+    resp.psi = auth_q16_to_float(q->psi);
+    resp.i_val = auth_q16_to_float(q->i_val);
+    resp.r_val = auth_q16_to_float(q->r_val);
+    resp.phi_avg = auth_q16_to_float(q->phi_avg);
+    resp.lorenz_x = auth_q16_to_float(q->lorenz_x);
+    resp.lorenz_y = auth_q16_to_float(q->lorenz_y);
+    resp.lorenz_z = auth_q16_to_float(q->lorenz_z);
+    resp.entropy_hash = auth_q16_to_float(q->entropy_hash);
+    return resp;
+}
+
+void auth_challenge_from_id_q16(uint32_t challenge_id, auth_q16* challenge, int length) {
+    uint32_t seed = challenge_id;
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345; // LCG
+        // (seed & 0xFFFF) / 65535 * 3, rounded to Q16
+        challenge[i] = (auth_q16)(((uint64_t)(seed & 0xFFFF) * 3 * 65536 + 32767) / 65535);
+    }
+}
+
+AuthResponse auth_compute_response_fixed(const float* challenge, int length,
+                                         const AuthSecret* secret) {
+    AuthSecretQ16 q_secret = auth_secret_to_q16(secret);
+    AuthResponseQ16 q_resp;
+    compute_response_q16(NULL, challenge, length, &q_secret, &q_resp);
+    return auth_response_from_q16(&q_resp);
+}
@@ -0,0 +1,381 @@
+// physics_auth_internal.h
+// Engine internals shared between the scalar engine and its variants
+// (batch, SIMD, ...). Not part of the public API - include physics_auth.h.
+
+#ifndef PHYSICS_AUTH_INTERNAL_H
+#define PHYSICS_AUTH_INTERNAL_H
+
+#include "physics_auth.h"
+#include "auth_math.h"
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+// Bare-metal builds have one thread, often no TLS runtime, and on
+// Cortex-M0 no atomic read-modify-write
+#if defined(__arm__) && !defined(__linux__)
+#define AUTH_BARE_METAL 1
+#else
+#define AUTH_BARE_METAL 0
+#include <stdatomic.h>
+#endif
+
+// Physics constants
+#define U_E 86.4f
+#define I_CHAR 8.0f
+#define R_CHAR 8.0f
+#define ALPHA_PSI 3.0f
+#define BETA_PSI 0.5f
+
+// xorshift32 PRNG
+static inline uint32_t xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// ===== CONSTANT-TIME HELPERS =====
+
+// cond ? a : b on the bit patterns, so the compiler cannot emit a branch
+static inline float auth_ct_select(int cond, float a, float b) {
+    uint32_t ua, ub, mask = (uint32_t)0 - (uint32_t)(cond != 0);
+    memcpy(&ua, &a, sizeof(ua));
+    memcpy(&ub, &b, sizeof(ub));
+    uint32_t r = (ua & mask) | (ub & ~mask);
+    float out;
+    memcpy(&out, &r, sizeof(out));
+    return out;
+}
+
+// The largest float below x > 0 (a constant when x is)
+static inline float auth_ct_below(float x) {
+    uint32_t u;
+    memcpy(&u, &x, sizeof(u));
+    u--;
+    memcpy(&x, &u, sizeof(x));
+    return x;
+}
+
+// fmodf(x, m) for |x| < m * 2^(bits + 1), as binary long division: each
+// step subtracts m * 2^j when it fits (scaled by the 0/1 compare result,
+// which stays in FP registers and beats a bit select). Since
+// m * 2^j <= r < m * 2^(j+1) the subtraction is exact (Sterbenz), so the
+// result equals fmodf bit for bit. Larger magnitudes (only reachable from
+// extreme challenge values or k, or inf) are clamped to just below the
+// bound first - a select, so every input runs the same instructions - and
+// so differ from fmodf; NaN stays NaN.
+static inline float auth_ct_fmod(float x, float m, int bits) {
+    float limit = m * (float)(2u << bits);
+    float r = fabsf(x);
+    r = auth_ct_select(r >= limit, auth_ct_below(limit), r);
+    for (int j = bits; j >= 0; j--) {
+        float t = m * (float)(1u << j);
+        r -= t * (float)(r >= t);
+    }
+    return copysignf(r, x);
+}
+
+#define AUTH_CT_WRAP_BITS 2     // exact for |x| < 8 m; engine states stay under 2 m
+
+// The engine's wrap: if (fabsf(x) > m) x = fmodf(x * scale, m)
+static inline float auth_wrap(float x, float scale, float m) {
+#if AUTH_CONSTANT_TIME
+    return auth_ct_select(fabsf(x) > m, auth_ct_fmod(x * scale, m, AUTH_CT_WRAP_BITS), x);
+#else
+    if (fabsf(x) > m) return fmodf(x * scale, m);
+    return x;
+#endif
+}
+
+// Entropy stays below 1000 + 2 in magnitude, so one step of the long
+// division is exact
+static inline float auth_wrap_entropy(float e) {
+#if AUTH_CONSTANT_TIME
+    return auth_ct_fmod(e, 1000.0f, 0);
+#else
+    return fmodf(e, 1000.0f);
+#endif
+}
+
+// Fast tanh approximation
+static inline float fast_tanh(float x) {
+#if AUTH_CONSTANT_TIME
+    // Clamping gives exactly +/-1.0f at +/-3 (3 * 36 / 108), same as the branches
+    x = auth_ct_select(x < -3.0f, -3.0f, x);
+    x = auth_ct_select(x > 3.0f, 3.0f, x);
+#else
+    if (x < -3.0f) return -1.0f;
+    if (x > 3.0f) return 1.0f;
+#endif
+    float x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+// NEW: Nonlinear mixing function (breaks ML predictability)
+static inline float mix_nonlinear(float a, float b, float c) {
+    float x = sinf(a * 3.14159f) * cosf(b * 2.71828f);
+    float y = fast_tanh(c * x);
+    return x * y + sinf(a * b + c);
+}
+
+// REV_4 form: the same mix with the libm-free sin/cos of auth_math.h
+static inline float mix_nonlinear_portable(float a, float b, float c) {
+    float x = auth_sinf(a * 3.14159f) * auth_cosf(b * 2.71828f);
+    float y = fast_tanh(c * x);
+    return x * y + auth_sinf(a * b + c);
+}
+
+// Argument check and straight-line form for lane loops: equal to
+// mix_nonlinear_portable whenever auth_mix_in_range holds
+static inline int auth_mix_in_range(float a, float b, float c) {
+    return fabsf(a * 3.14159f) <= AUTH_MATH_REDUCE_MAX &&
+           fabsf(b * 2.71828f) <= AUTH_MATH_REDUCE_MAX &&
+           fabsf(a * b + c) <= AUTH_MATH_REDUCE_MAX;
+}
+
+static inline float mix_nonlinear_portable_reduced(float a, float b, float c) {
+    float x = auth_sinf_reduced(a * 3.14159f) * auth_cosf_reduced(b * 2.71828f);
+    float y = fast_tanh(c * x);
+    return x * y + auth_sinf_reduced(a * b + c);
+}
+
+static inline float auth_mix(float a, float b, float c, int revision) {
+    if (revision >= AUTH_ENGINE_REV_4) return mix_nonlinear_portable(a, b, c);
+    return mix_nonlinear(a, b, c);
+}
+
+// ===== STEP STAGES =====
+// The per-agent arithmetic of evolve_step_n (physics_auth.c), shared with
+// the lane loops of the batch engine so every engine runs the same
+// operations in the same order. Wraps stay with the callers: the batch
+// engine keeps them out of its arithmetic loops.
+
+// Lorenz attractor, driven through x by the challenge, one LORENZ_DT step
+static inline void auth_step_lorenz(float* lx, float* ly, float* lz, float phi_input) {
+    float dLx = LORENZ_SIGMA * (*ly - *lx);
+    float dLy = *lx * (LORENZ_RHO - *lz) - *ly;
+    float dLz = *lx * *ly - LORENZ_BETA * *lz;
+    dLx += phi_input * 2.0f;
+    *lx += dLx * LORENZ_DT;
+    *ly += dLy * LORENZ_DT;
+    *lz += dLz * LORENZ_DT;
+}
+
+// Three logistic map iterations from x in (0, 1) at rate r, mapped back
+// to (-1, 1)
+static inline float auth_step_chaos_kick(float x, float r) {
+    for (int i = 0; i < 3; i++) x = r * x * (1.0f - x);
+    return (x - 0.5f) * 2.0f;
+}
+
+static inline float auth_step_seed_noise(uint32_t* seed_state) {
+    return (float)(xorshift32(seed_state) & 0xFFFF) / 65535.0f * 0.1f;
+}
+
+// I, R and Psi over one step of dt
+static inline void auth_step_state(float* i, float* r, float* psi, float k, float gamma,
+                                   float phi_avg, float chaos_kick, float seed_noise,
+                                   float dt) {
+    float dI = k * phi_avg + chaos_kick * 0.5f - (U_E / I_CHAR) * *i * 0.5f;
+    float dR = 0.1f * *i * *psi - (2.0f * U_E / R_CHAR) * *r * 0.3f;
+    float dPsi = ALPHA_PSI * *i - BETA_PSI * *r - gamma * *psi;
+    *i += dI * dt + seed_noise;
+    *r += dR * dt;
+    *psi += dPsi * dt;
+}
+
+// Phi field kernel (physics_auth_simd.c). position_factor[i] is
+// sinf(i * 0.5f + Lx), psi_half is Psi * 0.5f and drive is phi_input * 0.1f.
+// Returns the sum of the updated field (same order as auth_phi_sum).
+typedef float (*AuthPhiUpdateFn)(float* phi, const float* position_factor,
+                                 float psi_half, float drive);
+extern AuthPhiUpdateFn auth_phi_update;
+float auth_phi_sum(const float* phi);
+
+// The same kernel over the first n cells with timestep dt, for profiles;
+// bit-identical to auth_phi_update at n = PHI_SIZE, dt = DT
+typedef float (*AuthPhiUpdateNFn)(float* phi, const float* position_factor,
+                                  float psi_half, float drive, int n, float dt);
+extern AuthPhiUpdateNFn auth_phi_update_n;
+float auth_phi_sum_n(const float* phi, int n);
+void auth_simd_init(void);
+
+// Engine tables (physics_auth.c) - filled once by auth_init()
+extern float auth_sin_half[PHI_SIZE];        // sin(i * 0.5)
+extern float auth_cos_half[PHI_SIZE];        // cos(i * 0.5)
+#define AUTH_STEP_TABLE_SIZE 1024            // covers every preset schedule
+extern float auth_step_mod[AUTH_STEP_TABLE_SIZE]; // 1 + 0.01 * sin(step * 0.1)
+// REV_4 copies, from auth_sinf/auth_cosf instead of libm
+extern float auth_sin_half_portable[PHI_SIZE];
+extern float auth_cos_half_portable[PHI_SIZE];
+extern float auth_step_mod_portable[AUTH_STEP_TABLE_SIZE];
+// auth_tables_init() builds the tables once, however many threads call it
+// at the same time; the others wait for the tables to be ready
+#define AUTH_TABLES_EMPTY 0
+#define AUTH_TABLES_BUILDING 1
+#define AUTH_TABLES_READY 2
+#if AUTH_BARE_METAL
+extern int auth_tables_state;
+#else
+extern atomic_int auth_tables_state;
+#endif
+void auth_tables_init(void);
+void auth_q16_tables_init(void);              // physics_auth_fixed.c, called by auth_tables_init
+
+static inline void auth_tables_ensure(void) {
+#if AUTH_BARE_METAL
+    if (auth_tables_state != AUTH_TABLES_READY) auth_tables_init();
+#else
+    // Acquire: a thread that sees READY also sees the tables
+    if (atomic_load_explicit(&auth_tables_state, memory_order_acquire) != AUTH_TABLES_READY) {
+        auth_tables_init();
+    }
+#endif
+}
+
+// Step-dependent challenge modulation: 1 + 0.01 * sinf(step * 0.1f).
+// The table holds exactly the values the expression produces.
+static inline float auth_step_factor(int step, int revision) {
+    if (revision >= AUTH_ENGINE_REV_4) {
+        if (step < AUTH_STEP_TABLE_SIZE) return auth_step_mod_portable[step];
+        return 1.0f + 0.01f * auth_sinf(step * 0.1f);
+    }
+    if (step < AUTH_STEP_TABLE_SIZE) return auth_step_mod[step];
+    return 1.0f + 0.01f * sinf(step * 0.1f);
+}
+
+// sin and cos of Lx for the REV_2+ position factor
+static inline void auth_sincos_lx(float lx, int revision, float* s, float* c) {
+    if (revision >= AUTH_ENGINE_REV_4) {
+        auth_sincosf(lx, s, c);
+    } else {
+        *s = sinf(lx);
+        *c = cosf(lx);
+    }
+}
+
+// REV_2 position factor: sin(i*0.5 + Lx) = sin(i*0.5)cos(Lx) + cos(i*0.5)sin(Lx),
+// with the table pair of the revision
+static inline const float* auth_sin_half_table(int revision) {
+    return revision >= AUTH_ENGINE_REV_4 ? auth_sin_half_portable : auth_sin_half;
+}
+
+static inline const float* auth_cos_half_table(int revision) {
+    return revision >= AUTH_ENGINE_REV_4 ? auth_cos_half_portable : auth_cos_half;
+}
+
+int auth_revision_supported(int revision);
+
+// Shared engine stages (physics_auth.c)
+void auth_agent_init(AgentState* agent, uint32_t seed);
+AuthResponse auth_agent_response(const AgentState* agent, float k);   // REV_1..REV_3
+
+// Profile forms: the first phi_size cells of Phi, a schedule of
+// total_steps (auth_agent_init and auth_schedule_* are phi_size =
+// PHI_SIZE, total_steps = EVOLUTION_STEPS)
+void auth_agent_init_n(AgentState* agent, uint32_t seed, int phi_size);
+AuthResponse auth_agent_response_n(const AgentState* agent, float k, int phi_size,
+                                   int revision);
+int auth_schedule_uniform_steps_n(int revision, int length, int total_steps);
+int auth_schedule_steps_n(int revision, int length, int entries, int total_steps);
+
+// Preset dimensions (auth_profile_presets), as constants for the
+// specialized kernels. Each schedule divides evenly at its challenge length.
+#define AUTH_LOW_POWER_PHI 32
+#define AUTH_LOW_POWER_STEPS 64
+#define AUTH_LOW_POWER_DT 0.08f
+#define AUTH_LOW_POWER_LENGTH 16
+#define AUTH_HARDENED_STEPS 600
+#define AUTH_HARDENED_DT 0.025f
+
+// Preset with the same engine parameters (phi_size, evolution_steps, dt)
+// as profile, or -1: a copy of a preset still runs its specialized kernel
+int auth_profile_preset_id(const AuthProfile* profile);
+
+// Single float step, for cross-checking variant engines against the reference
+void auth_evolve_step(AgentState* agent, float k, float gamma, float phi_input,
+                      uint32_t* seed_state, int revision);
+
+// Fixed-point engine internals (physics_auth_fixed.c)
+typedef struct {
+    auth_q16 I;
+    auth_q16 R;
+    auth_q16 Psi;
+    auth_q16 Phi[PHI_SIZE];
+    auth_q16 Lx, Ly, Lz;
+    auth_q16 entropy;
+    auth_q16 phi_sum;
+} AgentStateQ16;
+
+auth_q16 auth_q16_sin(auth_q16 x);
+auth_q16 auth_q16_cos(auth_q16 x);
+auth_q16 auth_q16_tanh(auth_q16 x);
+void auth_q16_agent_init(AgentStateQ16* agent, uint32_t seed);
+void auth_q16_evolve_step(AgentStateQ16* agent, auth_q16 k, auth_q16 gamma,
+                          auth_q16 phi_input, uint32_t* seed_state);
+AuthResponseQ16 auth_q16_agent_response(const AgentStateQ16* agent, auth_q16 k);
+
+// ===== INSTRUMENTATION (AUTH_INSTRUMENT) =====
+
+#if AUTH_INSTRUMENT
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t auth_cycles(void) {
+    return __rdtsc();
+}
+#elif defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+// DWT cycle counter, enabled on first use
+static inline uint64_t auth_cycles(void) {
+    volatile uint32_t* demcr = (volatile uint32_t*)0xE000EDFCu;
+    volatile uint32_t* dwt_ctrl = (volatile uint32_t*)0xE0001000u;
+    volatile uint32_t* dwt_cyccnt = (volatile uint32_t*)0xE0001004u;
+    if (!(*dwt_ctrl & 1u)) {
+        *demcr |= 1u << 24;   // TRCENA
+        *dwt_cyccnt = 0;
+        *dwt_ctrl |= 1u;      // CYCCNTENA
+    }
+    return *dwt_cyccnt;
+}
+#elif defined(__aarch64__)
+static inline uint64_t auth_cycles(void) {
+    uint64_t v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+}
+#else
+#include <time.h>
+static inline uint64_t auth_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#if AUTH_BARE_METAL
+#define AUTH_THREAD_LOCAL
+#else
+#define AUTH_THREAD_LOCAL _Thread_local
+#endif
+
+extern AUTH_THREAD_LOCAL AuthPhaseStats auth_phase_counters;
+
+// AUTH_PHASE_BEGIN() once per function, then AUTH_PHASE_END(phase) after
+// each phase: charges the cycles since the previous mark to that phase
+#define AUTH_PHASE_BEGIN() uint64_t auth_phase_mark = auth_cycles()
+#define AUTH_PHASE_END(phase)                                           \
+    do {                                                                \
+        uint64_t auth_phase_now = auth_cycles();                        \
+        auth_phase_counters.cycles[phase] += auth_phase_now - auth_phase_mark; \
+        auth_phase_mark = auth_phase_now;                               \
+    } while (0)
+#define AUTH_PHASE_STEP() (auth_phase_counters.steps++)
+#else
+#define AUTH_PHASE_BEGIN() ((void)0)
+#define AUTH_PHASE_END(phase) ((void)0)
+#define AUTH_PHASE_STEP() ((void)0)
+#endif
+
+#endif // PHYSICS_AUTH_INTERNAL_H
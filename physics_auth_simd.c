@@ -0,0 +1,688 @@
+// physics_auth_simd.c
+// Vectorized Phi field kernels with runtime CPU dispatch
+//
+// Kernels: scalar (reference), SSE2 and AVX2 on x86, NEON on ARM.
+// The same backend also runs auth_verify_batch() and auth_verify_batch_i16().
+// auth_init() picks the widest kernel the CPU supports.
+//
+// DETERMINISM: the Phi update is bit-identical across all kernels. Every
+// lane performs the same IEEE single-precision operations as the scalar
+// loop (mul/add/div are correctly rounded, no FMA), tanh saturation uses
+// selects, and the fmodf(x, 3) wrap is replaced by the exact x - 3*sign(x)
+// (Sterbenz) for 3 < |x| < 6, with a scalar fmodf fallback otherwise.
+// AUTH_CONSTANT_TIME builds have no fallback: lanes at 6 or beyond clamp
+// to just below 6 by a mask first, as auth_ct_fmod() does.
+//
+// Each kernel also returns the sum of the updated field, so the engine
+// keeps phi_avg as a running value instead of re-reading Phi every step.
+// The reduction is the only place where vectorizing changes the result.
+// With AUTH_DETERMINISTIC=1 (default) it stays a sequential sum and
+// matches every existing client. Building with -DAUTH_DETERMINISTIC=0
+// selects a fixed 8-lane reduction order instead: still identical between
+// scalar/SSE2/AVX2/NEON builds, but NOT interoperable with deterministic
+// builds - both client and server must use the same setting.
+
+#include "physics_auth.h"
+#include "physics_auth_internal.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AUTH_HAVE_X86 1
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AUTH_HAVE_NEON 1
+#endif
+
+// ===== SCALAR REFERENCE =====
+
+static inline float phi_cell_update(float phi, float pf, float psi_half, float drive,
+                                    float dt) {
+    float source = fast_tanh(psi_half - phi);
+    phi += (source * 0.2f + drive * pf) * dt;
+
+    // Wrap field
+#if AUTH_CONSTANT_TIME
+    // One division step covers |phi| < 6, like the SIMD kernels' Sterbenz wrap
+    phi = auth_ct_select(fabsf(phi) > 3.0f, auth_ct_fmod(phi, 3.0f, 0), phi);
+#else
+    if (fabsf(phi) > 3.0f) phi = fmodf(phi, 3.0f);
+#endif
+    return phi;
+}
+
+static void phi_update_range(float* phi, const float* pf, float psi_half, float drive,
+                             float dt, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        phi[i] = phi_cell_update(phi[i], pf[i], psi_half, drive, dt);
+    }
+}
+
+#if !AUTH_DETERMINISTIC
+// Final combine of the 8 partial sums:
+// ((s0+s4) + (s2+s6)) + ((s1+s5) + (s3+s7))
+static inline float lane_tree(const float* s) {
+    float t0 = s[0] + s[4], t1 = s[1] + s[5], t2 = s[2] + s[6], t3 = s[3] + s[7];
+    return (t0 + t2) + (t1 + t3);
+}
+
+// Finish a relaxed reduction: cells [begin, n) go to lane i % 8
+static inline float lane_finish(float* s, const float* phi, int begin, int n) {
+    for (int i = begin; i < n; i++) s[i & 7] += phi[i];
+    return lane_tree(s);
+}
+#endif
+
+// Each kernel body takes the field size and timestep: inlined into
+// phi_update_*() they fold to PHI_SIZE and DT, inlined into
+// phi_update_*_n() they serve runtime profiles with the same operations.
+__attribute__((always_inline))
+static inline float phi_scalar_body(float* phi, const float* pf, float psi_half, float drive,
+                                    int n, float dt_value) {
+#if AUTH_DETERMINISTIC
+    float sum = 0.0f;
+    for (int i = 0; i < n; i++) {
+        phi[i] = phi_cell_update(phi[i], pf[i], psi_half, drive, dt_value);
+        sum += phi[i];
+    }
+    return sum;
+#else
+    float s[8] = {0};
+    for (int i = 0; i < n; i++) {
+        phi[i] = phi_cell_update(phi[i], pf[i], psi_half, drive, dt_value);
+        s[i & 7] += phi[i];
+    }
+    return lane_tree(s);
+#endif
+}
+
+static float phi_update_scalar(float* phi, const float* pf, float psi_half, float drive) {
+    return phi_scalar_body(phi, pf, psi_half, drive, PHI_SIZE, DT);
+}
+
+static float phi_update_scalar_n(float* phi, const float* pf, float psi_half, float drive, int n,
+                                 float dt_value) {
+    return phi_scalar_body(phi, pf, psi_half, drive, n, dt_value);
+}
+
+// Lanes whose pre-wrap value was >= 6 (or inf) take the exact libm path
+// (not in AUTH_CONSTANT_TIME builds)
+static inline void phi_fixup_far(float* phi, const float* raw, int far_mask, int width) {
+    for (int j = 0; j < width; j++) {
+        if (far_mask & (1 << j)) phi[j] = fmodf(raw[j], 3.0f);
+    }
+}
+
+// ===== SSE2 / AVX2 =====
+#ifdef AUTH_HAVE_X86
+
+__attribute__((target("sse2"), always_inline))
+static inline float phi_sse2_body(float* phi, const float* pf, float psi_half, float drive,
+                                  int n, float dt_value) {
+    const __m128 c27 = _mm_set1_ps(27.0f), c9 = _mm_set1_ps(9.0f);
+    const __m128 c3 = _mm_set1_ps(3.0f), cm3 = _mm_set1_ps(-3.0f), c6 = _mm_set1_ps(6.0f);
+    const __m128 one = _mm_set1_ps(1.0f), mone = _mm_set1_ps(-1.0f);
+    const __m128 c02 = _mm_set1_ps(0.2f), dt = _mm_set1_ps(dt_value), sign = _mm_set1_ps(-0.0f);
+    const __m128 vpsi = _mm_set1_ps(psi_half), vdrive = _mm_set1_ps(drive);
+#if AUTH_DETERMINISTIC
+    float sum = 0.0f;
+#else
+    __m128 acc_lo = _mm_setzero_ps(), acc_hi = _mm_setzero_ps();  // lanes 0-3, 4-7
+#endif
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 p = _mm_loadu_ps(phi + i);
+        __m128 x = _mm_sub_ps(vpsi, p);
+        __m128 x2 = _mm_mul_ps(x, x);
+        __m128 t = _mm_div_ps(_mm_mul_ps(x, _mm_add_ps(c27, x2)),
+                              _mm_add_ps(c27, _mm_mul_ps(c9, x2)));
+        __m128 lo = _mm_cmplt_ps(x, cm3), hi = _mm_cmpgt_ps(x, c3);
+        t = _mm_or_ps(_mm_andnot_ps(lo, t), _mm_and_ps(lo, mone));
+        t = _mm_or_ps(_mm_andnot_ps(hi, t), _mm_and_ps(hi, one));
+
+        __m128 d = _mm_add_ps(_mm_mul_ps(t, c02), _mm_mul_ps(vdrive, _mm_loadu_ps(pf + i)));
+        p = _mm_add_ps(p, _mm_mul_ps(d, dt));
+
+        __m128 a = _mm_andnot_ps(sign, p);
+        __m128 wrap = _mm_cmpgt_ps(a, c3);
+#if AUTH_CONSTANT_TIME
+        __m128 far = _mm_cmpge_ps(a, c6);
+        __m128 near = _mm_or_ps(_mm_andnot_ps(far, a),
+                                _mm_and_ps(far, _mm_set1_ps(auth_ct_below(6.0f))));
+        __m128 w = _mm_or_ps(_mm_sub_ps(near, c3), _mm_and_ps(sign, p));
+#else
+        __m128 w = _mm_sub_ps(p, _mm_or_ps(c3, _mm_and_ps(sign, p)));
+#endif
+        __m128 out = _mm_or_ps(_mm_andnot_ps(wrap, p), _mm_and_ps(wrap, w));
+        _mm_storeu_ps(phi + i, out);
+
+#if !AUTH_CONSTANT_TIME
+        int far = _mm_movemask_ps(_mm_cmpge_ps(a, c6));
+        if (far) {
+            float raw[4];
+            _mm_storeu_ps(raw, p);
+            phi_fixup_far(phi + i, raw, far, 4);
+        }
+#endif
+#if AUTH_DETERMINISTIC
+        for (int j = 0; j < 4; j++) sum += phi[i + j];
+#else
+        if (i & 4) acc_hi = _mm_add_ps(acc_hi, _mm_loadu_ps(phi + i));
+        else       acc_lo = _mm_add_ps(acc_lo, _mm_loadu_ps(phi + i));
+#endif
+    }
+    phi_update_range(phi, pf, psi_half, drive, dt_value, i, n);
+#if AUTH_DETERMINISTIC
+    for (; i < n; i++) sum += phi[i];
+    return sum;
+#else
+    float lanes[8];
+    _mm_storeu_ps(lanes, acc_lo);
+    _mm_storeu_ps(lanes + 4, acc_hi);
+    return lane_finish(lanes, phi, i, n);
+#endif
+}
+
+__attribute__((target("sse2")))
+static float phi_update_sse2(float* phi, const float* pf, float psi_half, float drive) {
+    return phi_sse2_body(phi, pf, psi_half, drive, PHI_SIZE, DT);
+}
+
+__attribute__((target("sse2")))
+static float phi_update_sse2_n(float* phi, const float* pf, float psi_half, float drive, int n,
+                               float dt_value) {
+    return phi_sse2_body(phi, pf, psi_half, drive, n, dt_value);
+}
+
+__attribute__((target("avx2"), always_inline))
+static inline float phi_avx2_body(float* phi, const float* pf, float psi_half, float drive,
+                                  int n, float dt_value) {
+    const __m256 c27 = _mm256_set1_ps(27.0f), c9 = _mm256_set1_ps(9.0f);
+    const __m256 c3 = _mm256_set1_ps(3.0f), cm3 = _mm256_set1_ps(-3.0f), c6 = _mm256_set1_ps(6.0f);
+    const __m256 one = _mm256_set1_ps(1.0f), mone = _mm256_set1_ps(-1.0f);
+    const __m256 c02 = _mm256_set1_ps(0.2f), dt = _mm256_set1_ps(dt_value);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 vpsi = _mm256_set1_ps(psi_half), vdrive = _mm256_set1_ps(drive);
+#if AUTH_DETERMINISTIC
+    float sum = 0.0f;
+#else
+    __m256 acc = _mm256_setzero_ps();
+#endif
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 p = _mm256_loadu_ps(phi + i);
+        __m256 x = _mm256_sub_ps(vpsi, p);
+        __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 t = _mm256_div_ps(_mm256_mul_ps(x, _mm256_add_ps(c27, x2)),
+                                 _mm256_add_ps(c27, _mm256_mul_ps(c9, x2)));
+        t = _mm256_blendv_ps(t, mone, _mm256_cmp_ps(x, cm3, _CMP_LT_OQ));
+        t = _mm256_blendv_ps(t, one, _mm256_cmp_ps(x, c3, _CMP_GT_OQ));
+
+        __m256 d = _mm256_add_ps(_mm256_mul_ps(t, c02),
+                                 _mm256_mul_ps(vdrive, _mm256_loadu_ps(pf + i)));
+        p = _mm256_add_ps(p, _mm256_mul_ps(d, dt));
+
+        __m256 a = _mm256_andnot_ps(sign, p);
+#if AUTH_CONSTANT_TIME
+        __m256 near = _mm256_blendv_ps(a, _mm256_set1_ps(auth_ct_below(6.0f)),
+                                       _mm256_cmp_ps(a, c6, _CMP_GE_OQ));
+        __m256 w = _mm256_or_ps(_mm256_sub_ps(near, c3), _mm256_and_ps(sign, p));
+#else
+        __m256 w = _mm256_sub_ps(p, _mm256_or_ps(c3, _mm256_and_ps(sign, p)));
+#endif
+        _mm256_storeu_ps(phi + i, _mm256_blendv_ps(p, w, _mm256_cmp_ps(a, c3, _CMP_GT_OQ)));
+
+#if !AUTH_CONSTANT_TIME
+        int far = _mm256_movemask_ps(_mm256_cmp_ps(a, c6, _CMP_GE_OQ));
+        if (far) {
+            float raw[8];
+            _mm256_storeu_ps(raw, p);
+            phi_fixup_far(phi + i, raw, far, 8);
+        }
+#endif
+#if AUTH_DETERMINISTIC
+        for (int j = 0; j < 8; j++) sum += phi[i + j];
+#else
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(phi + i));
+#endif
+    }
+    phi_update_range(phi, pf, psi_half, drive, dt_value, i, n);
+#if AUTH_DETERMINISTIC
+    for (; i < n; i++) sum += phi[i];
+    return sum;
+#else
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    return lane_finish(lanes, phi, i, n);
+#endif
+}
+
+__attribute__((target("avx2")))
+static float phi_update_avx2(float* phi, const float* pf, float psi_half, float drive) {
+    return phi_avx2_body(phi, pf, psi_half, drive, PHI_SIZE, DT);
+}
+
+__attribute__((target("avx2")))
+static float phi_update_avx2_n(float* phi, const float* pf, float psi_half, float drive, int n,
+                               float dt_value) {
+    return phi_avx2_body(phi, pf, psi_half, drive, n, dt_value);
+}
+
+#endif // AUTH_HAVE_X86
+
+// ===== NEON =====
+#ifdef AUTH_HAVE_NEON
+
+__attribute__((always_inline))
+static inline float phi_neon_body(float* phi, const float* pf, float psi_half, float drive,
+                                  int n, float dt_value) {
+    const float32x4_t c27 = vdupq_n_f32(27.0f), c9 = vdupq_n_f32(9.0f);
+    const float32x4_t c3 = vdupq_n_f32(3.0f), cm3 = vdupq_n_f32(-3.0f), c6 = vdupq_n_f32(6.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f), mone = vdupq_n_f32(-1.0f);
+    const float32x4_t c02 = vdupq_n_f32(0.2f), dt = vdupq_n_f32(dt_value);
+    const float32x4_t vpsi = vdupq_n_f32(psi_half), vdrive = vdupq_n_f32(drive);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+#if AUTH_DETERMINISTIC
+    float sum = 0.0f;
+#else
+    float32x4_t acc_lo = vdupq_n_f32(0.0f), acc_hi = vdupq_n_f32(0.0f);  // lanes 0-3, 4-7
+#endif
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t p = vld1q_f32(phi + i);
+        float32x4_t x = vsubq_f32(vpsi, p);
+        float32x4_t x2 = vmulq_f32(x, x);
+        float32x4_t num = vmulq_f32(x, vaddq_f32(c27, x2));
+        float32x4_t den = vaddq_f32(c27, vmulq_f32(c9, x2));
+#if defined(__aarch64__)
+        float32x4_t t = vdivq_f32(num, den);
+#else
+        // ARMv7 NEON has no IEEE divide - keep the division scalar
+        float n4[4], d4[4];
+        vst1q_f32(n4, num);
+        vst1q_f32(d4, den);
+        for (int j = 0; j < 4; j++) n4[j] = n4[j] / d4[j];
+        float32x4_t t = vld1q_f32(n4);
+#endif
+        t = vbslq_f32(vcltq_f32(x, cm3), mone, t);
+        t = vbslq_f32(vcgtq_f32(x, c3), one, t);
+
+        // vmlaq may fuse - use separate mul and add for bit-exactness
+        float32x4_t d = vaddq_f32(vmulq_f32(t, c02), vmulq_f32(vdrive, vld1q_f32(pf + i)));
+        p = vaddq_f32(p, vmulq_f32(d, dt));
+
+        float32x4_t a = vabsq_f32(p);
+#if AUTH_CONSTANT_TIME
+        float32x4_t near = vbslq_f32(vcgeq_f32(a, c6), vdupq_n_f32(auth_ct_below(6.0f)), a);
+        uint32x4_t near3 = vreinterpretq_u32_f32(vsubq_f32(near, c3));
+        float32x4_t w = vreinterpretq_f32_u32(vorrq_u32(near3,
+                                              vandq_u32(sign, vreinterpretq_u32_f32(p))));
+#else
+        float32x4_t s3 = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(c3),
+                                               vandq_u32(sign, vreinterpretq_u32_f32(p))));
+        float32x4_t w = vsubq_f32(p, s3);
+#endif
+        vst1q_f32(phi + i, vbslq_f32(vcgtq_f32(a, c3), w, p));
+
+#if !AUTH_CONSTANT_TIME
+        uint32x4_t far4 = vcgeq_f32(a, c6);
+        uint32_t far_lanes[4];
+        vst1q_u32(far_lanes, far4);
+        int far = (far_lanes[0] & 1) | (far_lanes[1] & 2) | (far_lanes[2] & 4) | (far_lanes[3] & 8);
+        if (far) {
+            float raw[4];
+            vst1q_f32(raw, p);
+            phi_fixup_far(phi + i, raw, far, 4);
+        }
+#endif
+#if AUTH_DETERMINISTIC
+        for (int j = 0; j < 4; j++) sum += phi[i + j];
+#else
+        if (i & 4) acc_hi = vaddq_f32(acc_hi, vld1q_f32(phi + i));
+        else       acc_lo = vaddq_f32(acc_lo, vld1q_f32(phi + i));
+#endif
+    }
+    phi_update_range(phi, pf, psi_half, drive, dt_value, i, n);
+#if AUTH_DETERMINISTIC
+    for (; i < n; i++) sum += phi[i];
+    return sum;
+#else
+    float lanes[8];
+    vst1q_f32(lanes, acc_lo);
+    vst1q_f32(lanes + 4, acc_hi);
+    return lane_finish(lanes, phi, i, n);
+#endif
+}
+
+static float phi_update_neon(float* phi, const float* pf, float psi_half, float drive) {
+    return phi_neon_body(phi, pf, psi_half, drive, PHI_SIZE, DT);
+}
+
+static float phi_update_neon_n(float* phi, const float* pf, float psi_half, float drive, int n,
+                               float dt_value) {
+    return phi_neon_body(phi, pf, psi_half, drive, n, dt_value);
+}
+
+#endif // AUTH_HAVE_NEON
+
+// ===== PHI_AVG REDUCTION =====
+
+float auth_phi_sum_n(const float* phi, int n) {
+#if AUTH_DETERMINISTIC
+    float sum = 0.0f;
+    for (int i = 0; i < n; i++) {
+        sum += phi[i];
+    }
+    return sum;
+#else
+    // Fixed 8-lane order: s[j] accumulates phi[i] for i % 8 == j (ascending),
+    // then lane_tree(). Every kernel above reproduces exactly this order.
+    float s[8] = {0};
+    return lane_finish(s, phi, 0, n);
+#endif
+}
+
+float auth_phi_sum(const float* phi) {
+    return auth_phi_sum_n(phi, PHI_SIZE);
+}
+
+// ===== BATCH VERIFICATION =====
+// One AuthResponse is 8 floats: a single AVX register, two SSE2/NEON
+// registers. |received - expected| < tolerance is evaluated with the
+// same IEEE operations as auth_verify(), and NaN never matches.
+
+typedef int (*AuthVerifyBatchFn)(const AuthResponse* received, const AuthResponse* expected,
+                                 int expected_stride, int count, float tolerance,
+                                 uint64_t* match_mask);
+
+static inline int record_match(uint64_t* match_mask, int n, int match) {
+    if (match_mask && match) match_mask[n >> 6] |= 1ull << (n & 63);
+    return match;
+}
+
+static int verify_batch_scalar(const AuthResponse* received, const AuthResponse* expected,
+                               int expected_stride, int count, float tolerance,
+                               uint64_t* match_mask) {
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        // auth_verify() stops at the first channel out of tolerance
+        int match = auth_verify(&received[n], &expected[(size_t)n * expected_stride], tolerance);
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+#ifdef AUTH_HAVE_X86
+
+__attribute__((target("sse2")))
+static int verify_batch_sse2(const AuthResponse* received, const AuthResponse* expected,
+                             int expected_stride, int count, float tolerance,
+                             uint64_t* match_mask) {
+    const __m128 tol = _mm_set1_ps(tolerance);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        const float* r = (const float*)&received[n];
+        const float* e = (const float*)&expected[(size_t)n * expected_stride];
+        __m128 d_lo = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(r), _mm_loadu_ps(e)));
+        __m128 d_hi = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(r + 4), _mm_loadu_ps(e + 4)));
+        int in_tol = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(d_lo, tol), _mm_cmplt_ps(d_hi, tol)));
+        matches += record_match(match_mask, n, in_tol == 0xF);
+    }
+    return matches;
+}
+
+__attribute__((target("avx2")))
+static int verify_batch_avx2(const AuthResponse* received, const AuthResponse* expected,
+                             int expected_stride, int count, float tolerance,
+                             uint64_t* match_mask) {
+    const __m256 tol = _mm256_set1_ps(tolerance);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        __m256 r = _mm256_loadu_ps((const float*)&received[n]);
+        __m256 e = _mm256_loadu_ps((const float*)&expected[(size_t)n * expected_stride]);
+        __m256 d = _mm256_andnot_ps(sign, _mm256_sub_ps(r, e));
+        int in_tol = _mm256_movemask_ps(_mm256_cmp_ps(d, tol, _CMP_LT_OQ));
+        matches += record_match(match_mask, n, in_tol == 0xFF);
+    }
+    return matches;
+}
+
+#endif // AUTH_HAVE_X86
+
+#ifdef AUTH_HAVE_NEON
+
+static int verify_batch_neon(const AuthResponse* received, const AuthResponse* expected,
+                             int expected_stride, int count, float tolerance,
+                             uint64_t* match_mask) {
+    const float32x4_t tol = vdupq_n_f32(tolerance);
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        const float* r = (const float*)&received[n];
+        const float* e = (const float*)&expected[(size_t)n * expected_stride];
+        uint32x4_t lo = vcltq_f32(vabsq_f32(vsubq_f32(vld1q_f32(r), vld1q_f32(e))), tol);
+        uint32x4_t hi = vcltq_f32(vabsq_f32(vsubq_f32(vld1q_f32(r + 4), vld1q_f32(e + 4))), tol);
+        uint32x4_t both = vandq_u32(lo, hi);
+        uint32x2_t half = vand_u32(vget_low_u32(both), vget_high_u32(both));
+        int match = (vget_lane_u32(half, 0) & vget_lane_u32(half, 1)) != 0;
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+#endif // AUTH_HAVE_NEON
+
+static AuthVerifyBatchFn verify_batch = verify_batch_scalar;
+
+int auth_verify_batch(const AuthResponse* received, const AuthResponse* expected,
+                      int expected_stride, int count, float tolerance, uint64_t* match_mask) {
+    if (count <= 0) return 0;
+    if (match_mask) memset(match_mask, 0, sizeof(uint64_t) * (size_t)((count + 63) / 64));
+    return verify_batch(received, expected, expected_stride, count, tolerance, match_mask);
+}
+
+// ===== QUANTIZED BATCH VERIFICATION =====
+// One AuthResponseI16 is 8 int16: a single SSE2/NEON register, half an
+// AVX2 one. |received - expected| is max - min, exact as an unsigned
+// 16-bit lane; it is within tolerance when the saturating subtract of the
+// tolerance leaves zero (SSE2 has no unsigned compare). A lane holding
+// AUTH_I16_INVALID fails the response, like NaN in auth_verify().
+
+typedef int (*AuthVerifyBatchI16Fn)(const AuthResponseI16* received,
+                                    const AuthResponseI16* expected, int expected_stride,
+                                    int count, uint16_t tolerance, uint64_t* match_mask);
+
+static int verify_batch_i16_scalar(const AuthResponseI16* received,
+                                   const AuthResponseI16* expected, int expected_stride,
+                                   int count, uint16_t tolerance, uint64_t* match_mask) {
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        int match =
+            auth_verify_i16(&received[n], &expected[(size_t)n * expected_stride], tolerance);
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+#ifdef AUTH_HAVE_X86
+
+__attribute__((target("sse2")))
+static int verify_batch_i16_sse2(const AuthResponseI16* received,
+                                 const AuthResponseI16* expected, int expected_stride,
+                                 int count, uint16_t tolerance, uint64_t* match_mask) {
+    const __m128i tol = _mm_set1_epi16((short)tolerance);
+    const __m128i invalid = _mm_set1_epi16(AUTH_I16_INVALID);
+    const __m128i zero = _mm_setzero_si128();
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        __m128i r = _mm_loadu_si128((const __m128i*)&received[n]);
+        __m128i e = _mm_loadu_si128((const __m128i*)&expected[(size_t)n * expected_stride]);
+        __m128i d = _mm_sub_epi16(_mm_max_epi16(r, e), _mm_min_epi16(r, e));
+        __m128i bad = _mm_or_si128(_mm_subs_epu16(d, tol),
+                                   _mm_or_si128(_mm_cmpeq_epi16(r, invalid),
+                                                _mm_cmpeq_epi16(e, invalid)));
+        int match = _mm_movemask_epi8(_mm_cmpeq_epi16(bad, zero)) == 0xFFFF;
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+// Two responses per register; an odd last one goes through the scalar path
+__attribute__((target("avx2")))
+static int verify_batch_i16_avx2(const AuthResponseI16* received,
+                                 const AuthResponseI16* expected, int expected_stride,
+                                 int count, uint16_t tolerance, uint64_t* match_mask) {
+    const __m256i tol = _mm256_set1_epi16((short)tolerance);
+    const __m256i invalid = _mm256_set1_epi16(AUTH_I16_INVALID);
+    const __m256i zero = _mm256_setzero_si256();
+    int matches = 0;
+    int n = 0;
+    for (; n + 1 < count; n += 2) {
+        __m256i r = _mm256_loadu_si256((const __m256i*)&received[n]);
+        __m128i e0 = _mm_loadu_si128((const __m128i*)&expected[(size_t)n * expected_stride]);
+        __m128i e1 =
+            _mm_loadu_si128((const __m128i*)&expected[(size_t)(n + 1) * expected_stride]);
+        __m256i e = _mm256_inserti128_si256(_mm256_castsi128_si256(e0), e1, 1);
+        __m256i d = _mm256_sub_epi16(_mm256_max_epi16(r, e), _mm256_min_epi16(r, e));
+        __m256i bad = _mm256_or_si256(_mm256_subs_epu16(d, tol),
+                                      _mm256_or_si256(_mm256_cmpeq_epi16(r, invalid),
+                                                      _mm256_cmpeq_epi16(e, invalid)));
+        uint32_t in_tol = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(bad, zero));
+        matches += record_match(match_mask, n, (in_tol & 0xFFFF) == 0xFFFF);
+        matches += record_match(match_mask, n + 1, (in_tol >> 16) == 0xFFFF);
+    }
+    if (n < count) {
+        int match =
+            auth_verify_i16(&received[n], &expected[(size_t)n * expected_stride], tolerance);
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+#endif // AUTH_HAVE_X86
+
+#ifdef AUTH_HAVE_NEON
+
+static int verify_batch_i16_neon(const AuthResponseI16* received,
+                                 const AuthResponseI16* expected, int expected_stride,
+                                 int count, uint16_t tolerance, uint64_t* match_mask) {
+    const uint16x8_t tol = vdupq_n_u16(tolerance);
+    const int16x8_t invalid = vdupq_n_s16(AUTH_I16_INVALID);
+    int matches = 0;
+    for (int n = 0; n < count; n++) {
+        int16x8_t r = vld1q_s16((const int16_t*)&received[n]);
+        int16x8_t e = vld1q_s16((const int16_t*)&expected[(size_t)n * expected_stride]);
+        uint16x8_t in_tol = vcleq_u16(vreinterpretq_u16_s16(vabdq_s16(r, e)), tol);
+        in_tol = vbicq_u16(in_tol, vorrq_u16(vceqq_s16(r, invalid), vceqq_s16(e, invalid)));
+        uint64x2_t halves = vreinterpretq_u64_u16(in_tol);
+        int match = (vgetq_lane_u64(halves, 0) & vgetq_lane_u64(halves, 1)) == UINT64_MAX;
+        matches += record_match(match_mask, n, match);
+    }
+    return matches;
+}
+
+#endif // AUTH_HAVE_NEON
+
+static AuthVerifyBatchI16Fn verify_batch_i16 = verify_batch_i16_scalar;
+
+int auth_verify_batch_i16(const AuthResponseI16* received, const AuthResponseI16* expected,
+                          int expected_stride, int count, int tolerance, uint64_t* match_mask) {
+    if (count <= 0) return 0;
+    if (match_mask) memset(match_mask, 0, sizeof(uint64_t) * (size_t)((count + 63) / 64));
+    if (tolerance < 0) return 0;
+    if (tolerance > UINT16_MAX) tolerance = UINT16_MAX;
+    return verify_batch_i16(received, expected, expected_stride, count, (uint16_t)tolerance,
+                            match_mask);
+}
+
+// ===== DISPATCH =====
+
+AuthPhiUpdateFn auth_phi_update = phi_update_scalar;
+AuthPhiUpdateNFn auth_phi_update_n = phi_update_scalar_n;
+static AuthSimdBackend active_backend = AUTH_SIMD_SCALAR;
+
+static int backend_supported(AuthSimdBackend backend) {
+    switch (backend) {
+    case AUTH_SIMD_SCALAR:
+        return 1;
+#ifdef AUTH_HAVE_X86
+    case AUTH_SIMD_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case AUTH_SIMD_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#ifdef AUTH_HAVE_NEON
+    case AUTH_SIMD_NEON:
+        return 1;
+#endif
+    default:
+        return 0;
+    }
+}
+
+int auth_simd_select(AuthSimdBackend backend) {
+    if (!backend_supported(backend)) return 0;
+
+    switch (backend) {
+#ifdef AUTH_HAVE_X86
+    case AUTH_SIMD_SSE2:
+        auth_phi_update = phi_update_sse2;
+        auth_phi_update_n = phi_update_sse2_n;
+        verify_batch = verify_batch_sse2;
+        verify_batch_i16 = verify_batch_i16_sse2;
+        break;
+    case AUTH_SIMD_AVX2:
+        auth_phi_update = phi_update_avx2;
+        auth_phi_update_n = phi_update_avx2_n;
+        verify_batch = verify_batch_avx2;
+        verify_batch_i16 = verify_batch_i16_avx2;
+        break;
+#endif
+#ifdef AUTH_HAVE_NEON
+    case AUTH_SIMD_NEON:
+        auth_phi_update = phi_update_neon;
+        auth_phi_update_n = phi_update_neon_n;
+        verify_batch = verify_batch_neon;
+        verify_batch_i16 = verify_batch_i16_neon;
+        break;
+#endif
+    default:
+        auth_phi_update = phi_update_scalar;
+        auth_phi_update_n = phi_update_scalar_n;
+        verify_batch = verify_batch_scalar;
+        verify_batch_i16 = verify_batch_i16_scalar;
+        break;
+    }
+    active_backend = backend;
+    return 1;
+}
+
+void auth_simd_init(void) {
+    static const AuthSimdBackend preference[] = {
+        AUTH_SIMD_AVX2, AUTH_SIMD_NEON, AUTH_SIMD_SSE2, AUTH_SIMD_SCALAR
+    };
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+        if (auth_simd_select(preference[i])) return;
+    }
+}
+
+AuthSimdBackend auth_simd_active(void) {
+    return active_backend;
+}
+
+const char* auth_simd_name(AuthSimdBackend backend) {
+    switch (backend) {
+    case AUTH_SIMD_SCALAR: return "scalar";
+    case AUTH_SIMD_SSE2:   return "sse2";
+    case AUTH_SIMD_AVX2:   return "avx2";
+    case AUTH_SIMD_NEON:   return "neon";
+    default:               return "unknown";
+    }
+}
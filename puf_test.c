@@ -9,6 +9,7 @@
 #include <math.h>
 #include <time.h>
 #include "physics_auth.h"
+#include "auth_population.h"
 
 #define ANSI_GREEN "\x1b[32m"
 #define ANSI_RED "\x1b[31m"
@@ -16,73 +17,24 @@
 #define ANSI_CYAN "\x1b[36m"
 #define ANSI_RESET "\x1b[0m"
 
-// Simulated Hardware PUF Sources
-typedef struct {
-    uint32_t sram_pattern;      // SRAM startup randomness
-    float clock_jitter;         // Clock frequency variation (ppm)
-    float voltage_offset;       // Vdd variation (mV)
-    float temp_coefficient;     // Temperature drift coefficient
-    uint32_t ring_osc_count;    // Ring oscillator measurement
-} HardwarePUF;
+// Manufacturing randomness of the simulated lot
+#define PUF_LOT_SEED 0x5EEDF00DCAFEull
+
+// Default size of the Test 7 production lot (-n overrides)
+#define PRODUCTION_LOT_CHIPS 20000
 
 // Generate a simulated chip with manufacturing variations
 HardwarePUF simulate_chip_manufacturing(uint32_t chip_id) {
-    HardwarePUF puf;
-    
-    // Simulate manufacturing process randomness
-    // Each chip gets unique values due to process variations
-    srand(chip_id * 0xDEADBEEF + 0x12345678);
-    
-    // SRAM cells have random startup states (50/50 per bit)
-    puf.sram_pattern = rand() ^ (rand() << 16);
-    
-    // Clock jitter: ±50 ppm variation
-    puf.clock_jitter = (float)(rand() % 10001 - 5000) / 100000.0f;
-    
-    // Voltage offset: ±30mV variation around 3.3V
-    puf.voltage_offset = (float)(rand() % 6001 - 3000) / 100000.0f;
-    
-    // Temperature coefficient: varies per chip
-    puf.temp_coefficient = 1.0f + (float)(rand() % 1001 - 500) / 100000.0f;
-    
-    // Ring oscillator: ~1MHz with ±2% variation
-    puf.ring_osc_count = 1000000 + (rand() % 40001 - 20000);
-    
-    return puf;
-}
-
-// Derive physics secret from hardware PUF
-// This is the key function - hardware variations become unique secrets
-AuthSecret derive_secret_from_puf(const HardwarePUF* puf) {
-    AuthSecret secret;
-    
-    // k parameter: derived from clock jitter and ring oscillator
-    // WIDER RANGE for more uniqueness: 1.0 to 5.0
-    secret.k = 1.0f + puf->clock_jitter * 500.0f + 
-               (float)(puf->ring_osc_count % 100000) / 25000.0f;
-    
-    // gamma parameter: derived from voltage and temperature
-    // WIDER RANGE: 0.1 to 2.0
-    secret.gamma = 0.1f + puf->voltage_offset * 50.0f + 
-                   fabsf(puf->temp_coefficient - 1.0f) * 20.0f +
-                   (float)(puf->sram_pattern % 1000) / 600.0f;
-    
-    // seed: derived from SRAM startup pattern
-    // Use full 32-bit randomness
-    secret.seed = puf->sram_pattern ^ puf->ring_osc_count;
-    
-    return secret;
+    return auth_puf_simulate(PUF_LOT_SEED, chip_id);
 }
 
 // Compute chip fingerprint (final Psi after standard challenge)
 float compute_chip_fingerprint(const HardwarePUF* puf) {
-    AuthSecret secret = derive_secret_from_puf(puf);
+    AuthSecret secret = auth_puf_derive_secret(puf);
     
     // Standard challenge (same for all chips)
     float challenge[CHALLENGE_LENGTH];
-    for (int i = 0; i < CHALLENGE_LENGTH; i++) {
-        challenge[i] = 1.5f + (float)i * 0.02f;
-    }
+    auth_puf_standard_challenge(challenge);
     
     AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
     return resp.psi;
@@ -98,48 +50,25 @@ void test_chip_uniqueness(void) {
     printf("\n" ANSI_YELLOW "=== Test 1: Chip Uniqueness (1000 chips) ===" ANSI_RESET "\n");
     
     #define NUM_CHIPS 1000
-    float fingerprints[NUM_CHIPS];
     
-    // Generate fingerprints for 1000 simulated chips
     printf("  Generating %d chip fingerprints...\n", NUM_CHIPS);
-    for (int i = 0; i < NUM_CHIPS; i++) {
-        HardwarePUF puf = simulate_chip_manufacturing(i);
-        fingerprints[i] = compute_chip_fingerprint(&puf);
-    }
-    
-    // Check for collisions
-    int collisions = 0;
-    float min_distance = 1000.0f;
-    int closest_i = 0, closest_j = 0;
-    
-    for (int i = 0; i < NUM_CHIPS; i++) {
-        for (int j = i + 1; j < NUM_CHIPS; j++) {
-            float dist = fabsf(fingerprints[i] - fingerprints[j]);
-            if (dist < 0.000001f) {
-                collisions++;
-            }
-            if (dist < min_distance) {
-                min_distance = dist;
-                closest_i = i;
-                closest_j = j;
-            }
-        }
-    }
-    
-    // Statistics
-    float sum = 0, sum_sq = 0;
-    for (int i = 0; i < NUM_CHIPS; i++) {
-        sum += fingerprints[i];
-        sum_sq += fingerprints[i] * fingerprints[i];
+    AuthPopulation pop;
+    AuthPopulationConfig cfg = {.lot_seed = PUF_LOT_SEED, .chips = NUM_CHIPS,
+                                .revision = AUTH_ENGINE_REV_1};
+    AuthPopulationReport rep;
+    if (!auth_population_create(&pop, &cfg) || !auth_population_analyze(&pop, 0.000001f, &rep)) {
+        printf("  " ANSI_RED "✗ FAIL" ANSI_RESET " - Population simulation failed\n");
+        tests_failed++;
+        return;
     }
-    float mean = sum / NUM_CHIPS;
-    float variance = (sum_sq / NUM_CHIPS) - (mean * mean);
-    float std_dev = sqrtf(variance);
+    auth_population_destroy(&pop);
+    int collisions = (int)rep.psi_collisions;
+    float min_distance = rep.min_distance;
     
     printf("  Fingerprint statistics:\n");
-    printf("    Mean: %.6f\n", mean);
-    printf("    Std Dev: %.6f\n", std_dev);
-    printf("    Min distance: %.6f (chips %d vs %d)\n", min_distance, closest_i, closest_j);
+    printf("    Mean: %.6f\n", rep.mean);
+    printf("    Std Dev: %.6f\n", rep.std_dev);
+    printf("    Min distance: %.6f (chips %u vs %u)\n", min_distance, rep.closest_a, rep.closest_b);
     printf("    Collisions: %d\n", collisions);
     
     // PASS if no exact collisions (tolerance 0.0000001) - near-misses are OK
@@ -242,7 +171,7 @@ void test_parameter_recovery(void) {
     
     // Original chip
     HardwarePUF puf = simulate_chip_manufacturing(555);
-    AuthSecret true_secret = derive_secret_from_puf(&puf);
+    AuthSecret true_secret = auth_puf_derive_secret(&puf);
     
     float challenge[CHALLENGE_LENGTH];
     for (int i = 0; i < CHALLENGE_LENGTH; i++) {
@@ -305,38 +234,28 @@ void test_distance_distribution(void) {
     printf("\n" ANSI_YELLOW "=== Test 5: Inter-chip Distance Distribution ===" ANSI_RESET "\n");
     
     #define SAMPLE_CHIPS 100
-    float fingerprints[SAMPLE_CHIPS];
-    
-    for (int i = 0; i < SAMPLE_CHIPS; i++) {
-        HardwarePUF puf = simulate_chip_manufacturing(i * 17 + 3); // Spread out IDs
-        fingerprints[i] = compute_chip_fingerprint(&puf);
-    }
-    
-    // Compute distance histogram
-    int histogram[10] = {0}; // 0-0.1, 0.1-0.2, ..., 0.9-1.0
-    float total_distance = 0.0f;
-    int comparisons = 0;
-    
-    for (int i = 0; i < SAMPLE_CHIPS; i++) {
-        for (int j = i + 1; j < SAMPLE_CHIPS; j++) {
-            float dist = fabsf(fingerprints[i] - fingerprints[j]);
-            total_distance += dist;
-            comparisons++;
-            
-            int bucket = (int)(dist * 10);
-            if (bucket > 9) bucket = 9;
-            histogram[bucket]++;
-        }
+    AuthPopulation pop;
+    AuthPopulationConfig cfg = {.lot_seed = PUF_LOT_SEED, .chips = SAMPLE_CHIPS, .first_id = 3,
+                                .id_stride = 17, .revision = AUTH_ENGINE_REV_1};  // Spread out IDs
+    AuthPopulationReport rep;
+    if (!auth_population_create(&pop, &cfg) || !auth_population_analyze(&pop, 0.000001f, &rep)) {
+        printf("  " ANSI_RED "✗ FAIL" ANSI_RESET " - Population simulation failed\n");
+        tests_failed++;
+        return;
     }
+    auth_population_destroy(&pop);
     
-    float avg_distance = total_distance / comparisons;
+    // Pair-distance histogram: 0-0.1, 0.1-0.2, ..., 0.9+
+    uint64_t* histogram = rep.histogram;
+    uint64_t comparisons = rep.pairs;
+    float avg_distance = (float)rep.mean_pair_distance;
     
     printf("  Average inter-chip distance: %.4f\n", avg_distance);
     printf("  Distance distribution:\n");
     for (int i = 0; i < 10; i++) {
-        printf("    %.1f-%.1f: %d (%.1f%%)\n", 
+        printf("    %.1f-%.1f: %llu (%.1f%%)\n", 
                i * 0.1f, (i + 1) * 0.1f, 
-               histogram[i], 
+               (unsigned long long)histogram[i], 
                (float)histogram[i] / comparisons * 100.0f);
     }
     
@@ -357,36 +276,20 @@ void test_entropy(void) {
     // Measure how many bits of entropy we get from the PUF
     #define ENTROPY_SAMPLES 1000
     
-    float fingerprints[ENTROPY_SAMPLES];
-    for (int i = 0; i < ENTROPY_SAMPLES; i++) {
-        HardwarePUF puf = simulate_chip_manufacturing(i);
-        fingerprints[i] = compute_chip_fingerprint(&puf);
+    AuthPopulation pop;
+    AuthPopulationConfig cfg = {.lot_seed = PUF_LOT_SEED, .chips = ENTROPY_SAMPLES,
+                                .revision = AUTH_ENGINE_REV_1};
+    AuthPopulationReport rep;
+    if (!auth_population_create(&pop, &cfg) || !auth_population_analyze(&pop, 0.000001f, &rep)) {
+        printf("  " ANSI_RED "✗ FAIL" ANSI_RESET " - Population simulation failed\n");
+        tests_failed++;
+        return;
     }
+    auth_population_destroy(&pop);
     
     // Estimate entropy by counting unique values at different precisions
-    int unique_1digit = 0, unique_2digit = 0, unique_3digit = 0, unique_4digit = 0;
-    
-    float seen_1[ENTROPY_SAMPLES], seen_2[ENTROPY_SAMPLES], seen_3[ENTROPY_SAMPLES], seen_4[ENTROPY_SAMPLES];
-    int n1 = 0, n2 = 0, n3 = 0, n4 = 0;
-    
-    for (int i = 0; i < ENTROPY_SAMPLES; i++) {
-        float v1 = roundf(fingerprints[i] * 10.0f) / 10.0f;
-        float v2 = roundf(fingerprints[i] * 100.0f) / 100.0f;
-        float v3 = roundf(fingerprints[i] * 1000.0f) / 1000.0f;
-        float v4 = roundf(fingerprints[i] * 10000.0f) / 10000.0f;
-        
-        // Check if unique
-        int found1 = 0, found2 = 0, found3 = 0, found4 = 0;
-        for (int j = 0; j < n1 && !found1; j++) if (fabsf(seen_1[j] - v1) < 0.01f) found1 = 1;
-        for (int j = 0; j < n2 && !found2; j++) if (fabsf(seen_2[j] - v2) < 0.001f) found2 = 1;
-        for (int j = 0; j < n3 && !found3; j++) if (fabsf(seen_3[j] - v3) < 0.0001f) found3 = 1;
-        for (int j = 0; j < n4 && !found4; j++) if (fabsf(seen_4[j] - v4) < 0.00001f) found4 = 1;
-        
-        if (!found1) { seen_1[n1++] = v1; unique_1digit++; }
-        if (!found2) { seen_2[n2++] = v2; unique_2digit++; }
-        if (!found3) { seen_3[n3++] = v3; unique_3digit++; }
-        if (!found4) { seen_4[n4++] = v4; unique_4digit++; }
-    }
+    int unique_1digit = (int)rep.distinct[0], unique_2digit = (int)rep.distinct[1];
+    int unique_3digit = (int)rep.distinct[2], unique_4digit = (int)rep.distinct[3];
     
     float entropy_1 = log2f((float)unique_1digit);
     float entropy_2 = log2f((float)unique_2digit);
@@ -412,8 +315,63 @@ void test_entropy(void) {
     }
 }
 
+// Test 7: Production Lot Qualification
+void test_production_lot(uint32_t chips) {
+    printf("\n" ANSI_YELLOW "=== Test 7: Production Lot Qualification (%u chips) ===" ANSI_RESET "\n", chips);
+    
+    AuthPopulation pop;
+    AuthPopulationConfig cfg = {.lot_seed = PUF_LOT_SEED ^ 0x107, .chips = chips,
+                                .revision = AUTH_ENGINE_REV_1};
+    AuthPopulationReport rep;
+    if (!auth_population_create(&pop, &cfg) || !auth_population_analyze(&pop, 0.000001f, &rep)) {
+        printf("  " ANSI_RED "✗ FAIL" ANSI_RESET " - Population simulation failed\n");
+        tests_failed++;
+        return;
+    }
+    
+    // Spot-check that the arena matches chips regenerated on their own
+    int regenerated = 1;
+    for (uint32_t i = 0; i < chips; i += chips / 16 + 1) {
+        HardwarePUF puf = auth_puf_simulate(cfg.lot_seed, i);
+        AuthSecret secret = auth_puf_derive_secret(&puf);
+        float challenge[CHALLENGE_LENGTH];
+        auth_puf_standard_challenge(challenge);
+        AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
+        if (memcmp(&resp, &pop.fingerprints[i], sizeof(resp)) != 0) regenerated = 0;
+    }
+    
+    printf("  Simulated in %.2fs (%.0f chips/s), analyzed in %.3fs, arena %.1f MB\n",
+           pop.seconds, chips / pop.seconds, rep.seconds, pop.arena_bytes / 1e6);
+    printf("  Psi near-collisions (<1e-6): %llu, full collisions (psi, I, R, phi_avg): %llu\n",
+           (unsigned long long)rep.psi_collisions, (unsigned long long)rep.collisions);
+    printf("  Nearest neighbour: min %.2e (chips %u vs %u), mean %.2e\n",
+           rep.min_distance, rep.closest_a, rep.closest_b, rep.mean_nn_distance);
+    printf("  Distinct fingerprints at 0.0001: %u of %u\n",
+           rep.distinct[AUTH_POPULATION_PRECISIONS - 1], chips);
+    auth_population_destroy(&pop);
+    
+    // A psi near-miss is fine; chips must differ on the other channels
+    if (rep.collisions == 0 && regenerated) {
+        printf("  " ANSI_GREEN "✓ PASS" ANSI_RESET " - Lot qualified: no two chips answer alike\n");
+        tests_passed++;
+    } else {
+        printf("  " ANSI_RED "✗ FAIL" ANSI_RESET " - %s\n",
+               regenerated ? "Fingerprint collisions in the lot" : "Arena differs from regenerated chips");
+        tests_failed++;
+    }
+}
+
 // Main
-int main(void) {
+// Usage: puf_test [-n chips]   (chips in the Test 7 production lot)
+int main(int argc, char** argv) {
+    uint32_t lot_chips = PRODUCTION_LOT_CHIPS;
+    if (argc == 3 && strcmp(argv[1], "-n") == 0 && atol(argv[2]) > 1) {
+        lot_chips = (uint32_t)atol(argv[2]);
+    } else if (argc != 1) {
+        fprintf(stderr, "Usage: %s [-n chips]\n", argv[0]);
+        return 1;
+    }
+
     printf(ANSI_CYAN "========================================\n");
     printf("Hardware PUF Anti-Counterfeiting Tests\n");
     printf("========================================" ANSI_RESET "\n");
@@ -427,6 +385,7 @@ int main(void) {
     test_parameter_recovery();
     test_distance_distribution();
     test_entropy();
+    test_production_lot(lot_chips);
     
     printf("\n" ANSI_CYAN "========================================\n");
     printf("SUMMARY: %s%d passed%s, %s%d failed%s\n",
@@ -0,0 +1,27 @@
+# setup.py
+# Builds the physics_auth_c extension (src/physics_auth_module.c) over the
+# C engine:  python3 setup.py build_ext --inplace
+#
+# No -march=native: the SIMD backends are compiled per function and picked
+# at import, so one build runs on any CPU of the architecture.
+# -ffp-contract=off is required for responses bit-identical to the C
+# client and server (see Makefile).
+from setuptools import Extension, setup
+
+ENGINE_SRCS = ["physics_auth.c", "physics_auth_batch.c", "physics_auth_simd.c",
+               "physics_auth_fixed.c"]
+
+setup(
+    name="physics_auth_c",
+    version="1.0",
+    description="Python bindings to the DiffEqAuth C engine",
+    ext_modules=[
+        Extension(
+            "physics_auth_c",
+            sources=["src/physics_auth_module.c"] + ENGINE_SRCS,
+            include_dirs=["."],
+            extra_compile_args=["-O3", "-ffp-contract=off"],
+            libraries=["m"],
+        )
+    ],
+)
@@ -0,0 +1,329 @@
+// physics_auth_module.c
+// CPython extension over the C engine (built by setup.py as physics_auth_c)
+//
+// Challenges, secrets and outputs are taken through the buffer protocol,
+// so numpy float32/uint32 arrays (or array.array, memoryview, ...) are
+// read and written in place, never copied. Every compute releases the GIL,
+// so Python threads calling in run on all cores.
+//
+//   compute_response(challenge, k, gamma, seed, revision=1) -> 8-tuple
+//   compute_response_batch(challenges, k, gamma, seed, revision=1, out=None)
+//       challenges: (n, length) or (length,) float32, broadcast to all n
+//       k, gamma: (n,) float32; seed: (n,) uint32
+//       out: writable (n, 8) float32, or None for a new memoryview
+//   verify(received, expected, tolerance=1e-6) -> bool
+//   challenge_from_id(challenge_id, length=50) -> float32 memoryview
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <string.h>
+#include "physics_auth.h"
+
+// ============================================================================
+// BUFFERS
+// ============================================================================
+
+// Native-endian element of the given struct-module kind ('f' or integer)
+static int format_is(const Py_buffer* view, char kind) {
+    const char* f = view->format ? view->format : "B";
+    if (*f == '@' || *f == '=' || *f == (PY_LITTLE_ENDIAN ? '<' : '>')) f++;
+    if (f[0] == '\0' || f[1] != '\0') return 0;
+    if (kind == 'f') return f[0] == 'f' && view->itemsize == 4;
+    return strchr("iIlL", f[0]) != NULL && view->itemsize == 4;
+}
+
+// C-contiguous buffer of 4-byte elements (kind as for format_is) with 1
+// or 2 dimensions
+static int get_buffer(PyObject* obj, Py_buffer* view, char kind, int writable, const char* name) {
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, view, flags) < 0) return 0;
+    if (!format_is(view, kind) || view->ndim < 1 || view->ndim > 2) {
+        PyErr_Format(PyExc_TypeError, "%s must be a contiguous %s array", name,
+                     kind == 'f' ? "float32" : "uint32");
+        PyBuffer_Release(view);
+        return 0;
+    }
+    return 1;
+}
+
+static Py_ssize_t elements(const Py_buffer* view) {
+    return view->len / view->itemsize;
+}
+
+// A new zero-filled float32 memoryview of shape (rows, cols) (cols = 0: 1-D)
+static PyObject* new_float_view(Py_ssize_t rows, Py_ssize_t cols) {
+    Py_ssize_t count = cols ? rows * cols : rows;
+    if (count == 0) {
+        // memoryview.cast() refuses a zero in the shape: describe the empty
+        // array directly. Static storage, as the view's master buffer keeps
+        // pointers into info (it owns nothing; called with the GIL held).
+        static float empty;
+        static char format[] = "f";
+        static Py_ssize_t shape[2], strides[2];
+        shape[0] = rows;
+        shape[1] = cols;
+        strides[0] = cols * 4;
+        strides[1] = 4;
+        Py_buffer info;
+        memset(&info, 0, sizeof(info));
+        info.buf = &empty;
+        info.itemsize = 4;
+        info.format = format;
+        info.ndim = cols ? 2 : 1;
+        info.shape = shape;
+        info.strides = cols ? strides : strides + 1;
+        return PyMemoryView_FromBuffer(&info);
+    }
+    PyObject* bytes = PyByteArray_FromStringAndSize(NULL, count * 4);
+    if (!bytes) return NULL;
+    memset(PyByteArray_AS_STRING(bytes), 0, (size_t)count * 4);
+    PyObject* raw = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!raw) return NULL;
+    PyObject* view = cols ? PyObject_CallMethod(raw, "cast", "s(nn)", "f", rows, cols)
+                          : PyObject_CallMethod(raw, "cast", "s", "f");
+    Py_DECREF(raw);
+    return view;
+}
+
+static PyObject* response_tuple(const AuthResponse* r) {
+    return Py_BuildValue("(ffffffff)", r->psi, r->i_val, r->r_val, r->phi_avg, r->lorenz_x,
+                         r->lorenz_y, r->lorenz_z, r->entropy_hash);
+}
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+// Preset by name, the default profile for NULL; NULL with ValueError if unknown
+static const AuthProfile* profile_arg(const char* name) {
+    if (!name) return &auth_profile_presets[AUTH_PROFILE_DEFAULT];
+    const AuthProfile* profile = auth_profile_find(name);
+    if (!profile) PyErr_Format(PyExc_ValueError, "unknown profile '%s'", name);
+    return profile;
+}
+
+static PyObject* py_compute_response(PyObject* self, PyObject* args, PyObject* kwargs) {
+    (void)self;
+    static char* keywords[] = {"challenge", "k", "gamma", "seed", "revision", "profile", NULL};
+    PyObject* challenge_obj;
+    AuthSecret secret;
+    unsigned long seed;
+    int revision = AUTH_ENGINE_REV_1;
+    const char* profile_name = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Offk|iz", keywords, &challenge_obj, &secret.k,
+                                     &secret.gamma, &seed, &revision, &profile_name)) return NULL;
+    secret.seed = (uint32_t)seed;
+    const AuthProfile* profile = profile_arg(profile_name);
+    if (!profile) return NULL;
+
+    Py_buffer challenge;
+    if (!get_buffer(challenge_obj, &challenge, 'f', 0, "challenge")) return NULL;
+    if (elements(&challenge) < 1 || elements(&challenge) > INT_MAX) {
+        PyBuffer_Release(&challenge);
+        return PyErr_Format(PyExc_ValueError, "bad challenge length");
+    }
+    AuthResponse resp;
+    int ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = auth_compute_response_ex(challenge.buf, (int)elements(&challenge), &secret, revision,
+                                  profile, &resp);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&challenge);
+    if (!ok) return PyErr_Format(PyExc_ValueError, "unsupported engine revision %d", revision);
+    return response_tuple(&resp);
+}
+
+static PyObject* py_compute_response_batch(PyObject* self, PyObject* args, PyObject* kwargs) {
+    (void)self;
+    static char* keywords[] = {"challenges", "k", "gamma", "seed", "revision", "out", "profile",
+                               NULL};
+    PyObject *challenges_obj, *k_obj, *gamma_obj, *seed_obj, *out_obj = Py_None;
+    int revision = AUTH_ENGINE_REV_1;
+    const char* profile_name = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOO|iOz", keywords, &challenges_obj, &k_obj,
+                                     &gamma_obj, &seed_obj, &revision, &out_obj,
+                                     &profile_name)) return NULL;
+    const AuthProfile* profile = profile_arg(profile_name);
+    if (!profile) return NULL;
+
+    Py_buffer challenges, k, gamma, seed, out;
+    PyObject* result = NULL;
+    AuthSecret* secrets = NULL;
+    int have = 0;   // buffers acquired so far
+    if (!get_buffer(challenges_obj, &challenges, 'f', 0, "challenges")) goto done;
+    have = 1;
+    if (!get_buffer(k_obj, &k, 'f', 0, "k")) goto done;
+    have = 2;
+    if (!get_buffer(gamma_obj, &gamma, 'f', 0, "gamma")) goto done;
+    have = 3;
+    if (!get_buffer(seed_obj, &seed, 'u', 0, "seed")) goto done;
+    have = 4;
+
+    Py_ssize_t n = elements(&k);
+    if (elements(&gamma) != n || elements(&seed) != n) {
+        PyErr_SetString(PyExc_ValueError, "k, gamma and seed must have the same length");
+        goto done;
+    }
+    Py_ssize_t length = challenges.shape[challenges.ndim - 1];
+    int stride = 0;
+    if (challenges.ndim == 2) {
+        if (challenges.shape[0] != n) {
+            PyErr_SetString(PyExc_ValueError, "challenges must have one row per secret");
+            goto done;
+        }
+        stride = (int)length;
+    }
+    if (n > INT_MAX || length < 1 || length > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "bad batch size or challenge length");
+        goto done;
+    }
+
+    if (out_obj == Py_None) {
+        result = new_float_view(n, 8);
+        if (!result) goto done;
+        out_obj = result;
+    } else {
+        Py_INCREF(out_obj);
+        result = out_obj;
+    }
+    if (!get_buffer(out_obj, &out, 'f', 1, "out")) {
+        Py_CLEAR(result);
+        goto done;
+    }
+    have = 5;
+    if (elements(&out) != n * 8) {
+        PyErr_SetString(PyExc_ValueError, "out must hold n x 8 float32");
+        Py_CLEAR(result);
+        goto done;
+    }
+
+    // AuthSecret packs k, gamma and seed; only this 12-byte-per-secret
+    // staging copy is made
+    secrets = PyMem_Malloc(sizeof(AuthSecret) * (size_t)(n ? n : 1));
+    if (!secrets) {
+        PyErr_NoMemory();
+        Py_CLEAR(result);
+        goto done;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        secrets[i].k = ((const float*)k.buf)[i];
+        secrets[i].gamma = ((const float*)gamma.buf)[i];
+        secrets[i].seed = ((const uint32_t*)seed.buf)[i];
+    }
+    int ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = auth_compute_response_batch_ex(challenges.buf, (int)length, stride, secrets, (int)n,
+                                        revision, profile, (AuthResponse*)out.buf);
+    Py_END_ALLOW_THREADS
+    if (!ok) {
+        PyErr_Format(PyExc_ValueError, "unsupported engine revision %d", revision);
+        Py_CLEAR(result);
+    }
+
+done:
+    PyMem_Free(secrets);
+    if (have >= 5) PyBuffer_Release(&out);
+    if (have >= 4) PyBuffer_Release(&seed);
+    if (have >= 3) PyBuffer_Release(&gamma);
+    if (have >= 2) PyBuffer_Release(&k);
+    if (have >= 1) PyBuffer_Release(&challenges);
+    return result;
+}
+
+// An 8-channel response from a tuple/sequence or an 8-float32 buffer
+static int response_from(PyObject* obj, AuthResponse* r, const char* name) {
+    Py_buffer view;
+    if (PyObject_CheckBuffer(obj)) {
+        if (!get_buffer(obj, &view, 'f', 0, name)) return 0;
+        int ok = elements(&view) == 8;
+        if (ok) memcpy(r, view.buf, sizeof(*r));
+        PyBuffer_Release(&view);
+        if (!ok) PyErr_Format(PyExc_ValueError, "%s must have 8 channels", name);
+        return ok;
+    }
+    PyObject* seq = PySequence_Fast(obj, "response must be a sequence or float32 buffer");
+    if (!seq) return 0;
+    int ok = PySequence_Fast_GET_SIZE(seq) == 8;
+    float* v = (float*)r;
+    for (int c = 0; ok && c < 8; c++) {
+        double x = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, c));
+        if (x == -1.0 && PyErr_Occurred()) ok = 0;
+        v[c] = (float)x;
+    }
+    Py_DECREF(seq);
+    if (!ok && !PyErr_Occurred()) PyErr_Format(PyExc_ValueError, "%s must have 8 channels", name);
+    return ok;
+}
+
+static PyObject* py_verify(PyObject* self, PyObject* args, PyObject* kwargs) {
+    (void)self;
+    static char* keywords[] = {"received", "expected", "tolerance", NULL};
+    PyObject *received_obj, *expected_obj;
+    float tolerance = 0.000001f;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|f", keywords, &received_obj, &expected_obj,
+                                     &tolerance)) return NULL;
+    AuthResponse received, expected;
+    if (!response_from(received_obj, &received, "received") ||
+        !response_from(expected_obj, &expected, "expected")) return NULL;
+    return PyBool_FromLong(auth_verify(&received, &expected, tolerance));
+}
+
+static PyObject* py_challenge_from_id(PyObject* self, PyObject* args, PyObject* kwargs) {
+    (void)self;
+    static char* keywords[] = {"challenge_id", "length", NULL};
+    unsigned long id;
+    int length = CHALLENGE_LENGTH;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|i", keywords, &id, &length)) return NULL;
+    if (length < 1) return PyErr_Format(PyExc_ValueError, "length must be positive");
+    PyObject* view = new_float_view(length, 0);
+    if (!view) return NULL;
+    Py_buffer buf;
+    if (PyObject_GetBuffer(view, &buf, PyBUF_WRITABLE) < 0) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    auth_challenge_from_id((uint32_t)id, buf.buf, length);
+    PyBuffer_Release(&buf);
+    return view;
+}
+
+// ============================================================================
+// MODULE
+// ============================================================================
+
+static PyMethodDef methods[] = {
+    {"compute_response", (PyCFunction)(void (*)(void))py_compute_response,
+     METH_VARARGS | METH_KEYWORDS,
+     "compute_response(challenge, k, gamma, seed, revision=1, profile=None) -> 8-tuple"},
+    {"compute_response_batch", (PyCFunction)(void (*)(void))py_compute_response_batch,
+     METH_VARARGS | METH_KEYWORDS,
+     "compute_response_batch(challenges, k, gamma, seed, revision=1, out=None, profile=None)"
+     " -> (n, 8) float32"},
+    {"verify", (PyCFunction)(void (*)(void))py_verify, METH_VARARGS | METH_KEYWORDS,
+     "verify(received, expected, tolerance=1e-6) -> bool"},
+    {"challenge_from_id", (PyCFunction)(void (*)(void))py_challenge_from_id,
+     METH_VARARGS | METH_KEYWORDS,
+     "challenge_from_id(challenge_id, length=50) -> float32 memoryview"},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef module = {
+    PyModuleDef_HEAD_INIT, "physics_auth_c",
+    "C physics authentication engine (8-channel responses, bit-identical to physics_auth.c)",
+    -1, methods, NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_physics_auth_c(void) {
+    auth_init();
+    PyObject* m = PyModule_Create(&module);
+    if (!m) return NULL;
+    PyModule_AddIntConstant(m, "CHALLENGE_LENGTH", CHALLENGE_LENGTH);
+    PyModule_AddIntConstant(m, "REV_1", AUTH_ENGINE_REV_1);
+    PyModule_AddIntConstant(m, "REV_2", AUTH_ENGINE_REV_2);
+    PyModule_AddIntConstant(m, "REV_3", AUTH_ENGINE_REV_3);
+    PyModule_AddIntConstant(m, "REV_4", AUTH_ENGINE_REV_4);
+    PyModule_AddIntConstant(m, "REV_LATEST", AUTH_ENGINE_REV_LATEST);
+    PyModule_AddStringConstant(m, "SIMD", auth_simd_name(auth_simd_active()));
+    return m;
+}
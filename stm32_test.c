@@ -6,7 +6,9 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdint.h>
+#include <string.h>
 #include "physics_auth.h"
+#include "bench/bench_harness.h"
 
 #define ANSI_GREEN "\x1b[32m"
 #define ANSI_RED "\x1b[31m"
@@ -17,6 +19,15 @@
 #define STM32_CLOCK_MHZ 480.0f
 #define STM32_CYCLES_PER_FLOP 10.0f  // Conservative estimate
 
+// Energy model: run current is static + per-MHz (200 mA at 480 MHz, as in
+// test_power_consumption), and every wake from Stop costs STM32_WAKEUP_US
+// of run current before the slice starts
+#define STM32_VDD 3.3f
+#define STM32_RUN_STATIC_MA 10.0f
+#define STM32_RUN_MA_PER_MHZ 0.396f
+#define STM32_WAKEUP_US 10.0f
+#define X86_CLOCK_MHZ 3500.0f        // the x86:STM32 cycle equivalence used above
+
 // Test results
 typedef struct {
     float avg_latency_ms;
@@ -27,13 +38,6 @@ typedef struct {
     uint32_t failures;
 } TestResults;
 
-// Simulate cycle counter (like DWT on STM32)
-static inline uint64_t get_cycles(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
-}
-
 // Test 1: Basic functionality
 void test_stm32_functionality(void) {
     printf("\n" ANSI_YELLOW "=== STM32 H7 Functionality Test ===" ANSI_RESET "\n");
@@ -45,12 +49,7 @@ void test_stm32_functionality(void) {
     // Generate challenge (simulating RTC-based)
     float challenge[CHALLENGE_LENGTH];
     uint32_t timestamp = (uint32_t)time(NULL);
-    uint32_t seed = timestamp;
-    
-    for (int i = 0; i < CHALLENGE_LENGTH; i++) {
-        seed = seed * 1103515245 + 12345;
-        challenge[i] = ((float)(seed & 0xFFFF) / 65535.0f) * 3.0f;
-    }
+    auth_challenge_from_id(timestamp, challenge, CHALLENGE_LENGTH);
     
     // Test user 1 auth
     AuthResponse resp1 = auth_compute_response(challenge, CHALLENGE_LENGTH, &user1);
@@ -85,31 +84,28 @@ void test_stm32_performance(void) {
     }
     
     const int iterations = 1000;
-    uint64_t total_ns = 0;
-    uint64_t min_ns = UINT64_MAX;
-    uint64_t max_ns = 0;
+    static uint64_t samples[1000];
     
+    for (int i = 0; i < 10; i++) {
+        AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
+        (void)resp; // Warm up
+    }
     for (int i = 0; i < iterations; i++) {
-        uint64_t start = get_cycles();
+        uint64_t start = bench_now_ns();
         AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &secret);
-        uint64_t end = get_cycles();
-        
-        uint64_t elapsed = end - start;
-        total_ns += elapsed;
-        if (elapsed < min_ns) min_ns = elapsed;
-        if (elapsed > max_ns) max_ns = elapsed;
+        samples[i] = bench_now_ns() - start;
         
         (void)resp; // Suppress warning
     }
     
-    float avg_ns = (float)total_ns / iterations;
-    float avg_ms = avg_ns / 1000000.0f;
+    BenchStats stats = bench_stats("auth_compute_response", samples, iterations, 1);
+    float avg_ms = (float)(stats.mean_ns / 1e6);
     
     // Estimate STM32 timing (x86 is ~10× faster than STM32 at same FLOPs)
     float stm32_estimate_ms = avg_ms * (3500.0f / STM32_CLOCK_MHZ);
     
-    printf("  x86 measured:      %.3fms avg (%.3f-%.3fms)\n", 
-           avg_ms, (float)min_ns/1000000.0f, (float)max_ns/1000000.0f);
+    printf("  x86 measured:      %.3fms avg (%.3f-%.3fms, p99 %.3fms)\n", 
+           avg_ms, stats.min_ns / 1e6, stats.max_ns / 1e6, stats.p99_ns / 1e6);
     printf("  STM32 H7 estimate: " ANSI_GREEN "%.3fms" ANSI_RESET "\n", stm32_estimate_ms);
     printf("  Target:            <1.0ms\n");
     
@@ -164,7 +160,7 @@ void test_multi_user(void) {
     uint64_t total_ns = 0;
     
     for (int i = 0; i < NUM_USERS; i++) {
-        uint64_t start = get_cycles();
+        uint64_t start = bench_now_ns();
         AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &users[i]);
         AuthResponse expected = resp; // Pre-computed
         
@@ -172,7 +168,7 @@ void test_multi_user(void) {
             successes++;
         }
         
-        uint64_t end = get_cycles();
+        uint64_t end = bench_now_ns();
         total_ns += (end - start);
     }
     
@@ -236,6 +232,87 @@ void test_power_consumption(void) {
     printf("  " ANSI_GREEN "Battery life: %.1f years" ANSI_RESET "\n", battery_life_years);
 }
 
+// Test 6: Energy per authentication, one burst against duty-cycled slices
+static double measure_us(const AuthProfile* profile, int slice_steps) {
+    AuthSecret secret = {2.5f, 0.8f, 12345};
+    float challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id(7, challenge, CHALLENGE_LENGTH);
+    
+    enum { ITERS = 200 };
+    static uint64_t samples[ITERS];
+    for (int i = 0; i < ITERS; i++) {
+        AuthResponse resp;
+        AuthSlice slice;
+        challenge[0] = (float)i * 1e-3f;
+        uint64_t start = bench_now_ns();
+        if (slice_steps > 0) {
+            auth_slice_begin(&slice, &secret, profile->challenge_length, AUTH_ENGINE_REV_LATEST,
+                             profile);
+            while (auth_slice_run(&slice, challenge, profile->challenge_length, slice_steps) > 0) {
+            }
+            auth_slice_finish(&slice, &resp);
+        } else {
+            auth_compute_response_ex(challenge, profile->challenge_length, &secret,
+                                     AUTH_ENGINE_REV_LATEST, profile, &resp);
+        }
+        samples[i] = bench_now_ns() - start;
+    }
+    return bench_stats(profile->name, samples, ITERS, 1).p50_ns / 1e3;
+}
+
+void test_energy_per_auth(void) {
+    printf("\n" ANSI_YELLOW "=== Energy per Authentication (duty-cycled) ===" ANSI_RESET "\n");
+    
+    // Sliced responses are the burst responses
+    AuthSecret secret = {2.5f, 0.8f, 12345};
+    float challenge[CHALLENGE_LENGTH];
+    auth_challenge_from_id(7, challenge, CHALLENGE_LENGTH);
+    const AuthProfile* profiles[] = {&auth_profile_presets[AUTH_PROFILE_DEFAULT],
+                                     &auth_profile_presets[AUTH_PROFILE_LOW_POWER]};
+    int same = 1;
+    for (int p = 0; p < 2; p++) {
+        AuthResponse burst, sliced;
+        AuthSlice slice;
+        int length = profiles[p]->challenge_length;
+        auth_compute_response_ex(challenge, length, &secret, AUTH_ENGINE_REV_LATEST,
+                                 profiles[p], &burst);
+        auth_slice_begin(&slice, &secret, length, AUTH_ENGINE_REV_LATEST, profiles[p]);
+        while (auth_slice_run(&slice, challenge, length, 16) > 0) {
+        }
+        same &= auth_slice_finish(&slice, &sliced) &&
+                memcmp(&burst, &sliced, sizeof(AuthResponse)) == 0;
+    }
+    printf("  %s Sliced responses match the burst responses\n",
+           same ? ANSI_GREEN "✓" ANSI_RESET : ANSI_RED "✗" ANSI_RESET);
+    
+    static const float clocks_mhz[] = {64.0f, 120.0f, 240.0f, 480.0f};
+    enum { SLICE_STEPS = 16 };
+    printf("\n  %-9s %7s %10s %12s %12s\n", "profile", "MHz", "time (us)", "burst (uJ)",
+           "sliced (uJ)");
+    for (int p = 0; p < 2; p++) {
+        const AuthProfile* profile = profiles[p];
+        double burst_cycles = measure_us(profile, 0) * X86_CLOCK_MHZ;
+        double sliced_cycles = measure_us(profile, SLICE_STEPS) * X86_CLOCK_MHZ;
+        AuthSlice slice;
+        auth_slice_begin(&slice, &secret, profile->challenge_length, AUTH_ENGINE_REV_LATEST,
+                         profile);
+        int schedule = auth_slice_remaining(&slice);
+        int wakeups = (schedule + SLICE_STEPS - 1) / SLICE_STEPS;
+        for (int c = 0; c < 4; c++) {
+            double mhz = clocks_mhz[c];
+            double run_mw = STM32_VDD * (STM32_RUN_STATIC_MA + STM32_RUN_MA_PER_MHZ * mhz);
+            double burst_us = burst_cycles / mhz;
+            double sliced_us = sliced_cycles / mhz + wakeups * STM32_WAKEUP_US;
+            // mW * us = nJ
+            printf("  %-9s %7.0f %10.1f %12.2f %12.2f\n", profile->name, mhz, burst_us,
+                   run_mw * burst_us / 1e3, run_mw * sliced_us / 1e3);
+        }
+    }
+    printf("  (%d-step slices, %.0f us wake-up each. Static current favours the fastest\n"
+           "   clock for bursts; slices pay per wake-up, so size them to the RX gaps)\n",
+           SLICE_STEPS, (double)STM32_WAKEUP_US);
+}
+
 int main(void) {
     printf("========================================\n");
     printf("STM32 H7 Smart Lock Tests\n");
@@ -248,6 +325,7 @@ int main(void) {
     test_stm32_memory();
     test_multi_user();
     test_power_consumption();
+    test_energy_per_auth();
     
     printf("\n========================================\n");
     printf("All STM32 tests complete\n");
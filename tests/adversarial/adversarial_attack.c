@@ -10,6 +10,7 @@
 #include <time.h>
 #include <stdint.h>
 #include "physics_auth.h"
+#include "auth_sweep.h"
 
 #define RED "\x1b[31m"
 #define GREEN "\x1b[32m"
@@ -324,35 +325,26 @@ void attack_parameter_sweep(void) {
     printf("  Target response: Ψ=%.6f\n", target_resp.psi);
     printf("  Sweeping k=[0,5], γ=[0,2], seed=[0,1000]...\n\n");
     
-    int matches = 0;
-    float tolerance = 0.0001f;
-    
-    uint64_t start = get_ns();
-    
-    // Coarse sweep
-    for (float k = 0.0f; k <= 5.0f; k += 0.1f) {
-        for (float g = 0.0f; g <= 2.0f; g += 0.1f) {
-            for (uint32_t seed = 0; seed < 1000; seed += 10) {
-                AuthSecret guess = {k, g, seed};
-                AuthResponse resp = auth_compute_response(challenge, CHALLENGE_LENGTH, &guess);
-                
-                if (fabsf(resp.psi - target_resp.psi) < tolerance &&
-                    fabsf(resp.i_val - target_resp.i_val) < tolerance &&
-                    fabsf(resp.r_val - target_resp.r_val) < tolerance) {
-                    matches++;
-                    if (matches <= 3) {
-                        printf("  MATCH FOUND: k=%.2f, γ=%.2f, seed=%u\n", k, g, seed);
-                    }
-                }
-            }
-        }
+    // Coarse grid: k step 0.1, γ step 0.1, seed step 10, screened on
+    // Ψ, I and R by the parallel sweep engine
+    AuthSweepConfig sweep = {
+        .k_min = 0.0f, .k_max = 5.0f, .gamma_min = 0.0f, .gamma_max = 2.0f,
+        .seed_min = 0, .seed_max = 990, .mode = AUTH_SWEEP_GRID,
+        .k_steps = 51, .gamma_steps = 21, .seed_steps = 100,
+        .threads = 0, .revision = AUTH_ENGINE_REV_1, .tolerance = 0.0001f, .channels = 3
+    };
+    AuthSweepMatch found[3];
+    AuthSweepResult res;
+    auth_sweep(&sweep, challenge, CHALLENGE_LENGTH, &target_resp, found, 3, &res);
+    int matches = (int)res.matches;
+    for (int m = 0; m < res.recorded; m++) {
+        printf("  MATCH FOUND: k=%.2f, γ=%.2f, seed=%u\n", found[m].secret.k,
+               found[m].secret.gamma, found[m].secret.seed);
     }
+    double elapsed_sec = res.seconds;
     
-    uint64_t elapsed = get_ns() - start;
-    double elapsed_sec = (double)elapsed / 1e9;
-    
-    printf("\n  Combinations tested: ~%d\n", 50 * 20 * 100);
-    printf("  Time elapsed: %.2f seconds\n", elapsed_sec);
+    printf("\n  Combinations tested: %llu\n", (unsigned long long)res.guesses);
+    printf("  Time elapsed: %.2f seconds (%.0f guesses/sec)\n", elapsed_sec, res.guesses_per_sec);
     printf("  Matches found: %d\n", matches);
     
     if (matches > 0) {
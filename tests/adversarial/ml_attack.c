@@ -9,6 +9,8 @@
 #include <time.h>
 #include <stdint.h>
 #include "physics_auth.h"
+#include "ml_harness.h"
+#include "auth_util.h"
 
 #define RED "\x1b[31m"
 #define GREEN "\x1b[32m"
@@ -17,20 +19,17 @@
 #define BOLD "\x1b[1m"
 #define RESET "\x1b[0m"
 
+// Defaults; see usage()
 #define N_TRAIN 500
 #define N_TEST 100
+#define N_HIDDEN 20
+#define N_EPOCHS 500
+#define N_BATCH 16
 #define N_FEATURES 10  // Summarized challenge features
-
-// Simple neural network weights (trained via gradient descent)
-typedef struct {
-    float w1[N_FEATURES][20];  // Input -> Hidden
-    float b1[20];
-    float w2[20][4];           // Hidden -> Output (Ψ, I, R, Φ)  
-    float b2[4];
-} NeuralNet;
+#define N_OUTPUTS 4    // Ψ, I, R, Φ
 
 // Extract features from challenge
-void extract_features(float* challenge, float* features) {
+void extract_features(const float* challenge, float* features) {
     // Feature 1-5: First 5 challenge values
     for (int i = 0; i < 5; i++) {
         features[i] = challenge[i];
@@ -70,108 +69,42 @@ void extract_features(float* challenge, float* features) {
     features[9] = last_sum / 5;
 }
 
-float relu(float x) {
-    return x > 0 ? x : 0;
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n train] [-t test] [-h hidden] [-e epochs] [-b batch] [-l lr] [-j threads]\n"
+            "  defaults: %d CRPs, %d tests, %d hidden units, %d epochs of %d-sample batches\n",
+            argv0, N_TRAIN, N_TEST, N_HIDDEN, N_EPOCHS, N_BATCH);
 }
 
-void nn_forward(NeuralNet* nn, float* features, float* output) {
-    float hidden[20];
-    
-    // Hidden layer
-    for (int j = 0; j < 20; j++) {
-        hidden[j] = nn->b1[j];
-        for (int i = 0; i < N_FEATURES; i++) {
-            hidden[j] += features[i] * nn->w1[i][j];
+int main(int argc, char** argv) {
+    int n_train = N_TRAIN, n_test = N_TEST, hidden = N_HIDDEN, epochs = N_EPOCHS;
+    int threads = 0;
+    MlTrainConfig train = {.batch = N_BATCH, .lr = 0.016f, .shuffle_seed = 12345};
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
         }
-        hidden[j] = relu(hidden[j]);
-    }
-    
-    // Output layer
-    for (int j = 0; j < 4; j++) {
-        output[j] = nn->b2[j];
-        for (int i = 0; i < 20; i++) {
-            output[j] += hidden[i] * nn->w2[i][j];
+        const char* v = argv[++i];
+        if (strcmp(argv[i - 1], "-n") == 0) n_train = atoi(v);
+        else if (strcmp(argv[i - 1], "-t") == 0) n_test = atoi(v);
+        else if (strcmp(argv[i - 1], "-h") == 0) hidden = atoi(v);
+        else if (strcmp(argv[i - 1], "-e") == 0) epochs = atoi(v);
+        else if (strcmp(argv[i - 1], "-b") == 0) train.batch = atoi(v);
+        else if (strcmp(argv[i - 1], "-l") == 0) train.lr = (float)atof(v);
+        else if (strcmp(argv[i - 1], "-j") == 0) threads = atoi(v);
+        else {
+            usage(argv[0]);
+            return 1;
         }
     }
-}
-
-void nn_train(NeuralNet* nn, float challenges[N_TRAIN][CHALLENGE_LENGTH], 
-              float responses[N_TRAIN][4], int epochs) {
-    
-    float lr = 0.001f;
-    
-    for (int epoch = 0; epoch < epochs; epoch++) {
-        float total_loss = 0;
-        
-        for (int sample = 0; sample < N_TRAIN; sample++) {
-            float features[N_FEATURES];
-            extract_features(challenges[sample], features);
-            
-            // Forward pass
-            float hidden[20], output[4];
-            float hidden_pre[20];  // Pre-activation
-            
-            for (int j = 0; j < 20; j++) {
-                hidden_pre[j] = nn->b1[j];
-                for (int i = 0; i < N_FEATURES; i++) {
-                    hidden_pre[j] += features[i] * nn->w1[i][j];
-                }
-                hidden[j] = relu(hidden_pre[j]);
-            }
-            
-            for (int j = 0; j < 4; j++) {
-                output[j] = nn->b2[j];
-                for (int i = 0; i < 20; i++) {
-                    output[j] += hidden[i] * nn->w2[i][j];
-                }
-            }
-            
-            // Compute loss
-            float loss = 0;
-            float grad_output[4];
-            for (int j = 0; j < 4; j++) {
-                float diff = output[j] - responses[sample][j];
-                loss += diff * diff;
-                grad_output[j] = 2 * diff;
-            }
-            total_loss += loss;
-            
-            // Backprop to hidden
-            float grad_hidden[20] = {0};
-            for (int j = 0; j < 4; j++) {
-                for (int i = 0; i < 20; i++) {
-                    grad_hidden[i] += grad_output[j] * nn->w2[i][j];
-                }
-            }
-            
-            // ReLU gradient
-            for (int i = 0; i < 20; i++) {
-                if (hidden_pre[i] <= 0) grad_hidden[i] = 0;
-            }
-            
-            // Update weights
-            for (int j = 0; j < 4; j++) {
-                for (int i = 0; i < 20; i++) {
-                    nn->w2[i][j] -= lr * grad_output[j] * hidden[i];
-                }
-                nn->b2[j] -= lr * grad_output[j];
-            }
-            
-            for (int j = 0; j < 20; j++) {
-                for (int i = 0; i < N_FEATURES; i++) {
-                    nn->w1[i][j] -= lr * grad_hidden[j] * features[i];
-                }
-                nn->b1[j] -= lr * grad_hidden[j];
-            }
-        }
-        
-        if ((epoch + 1) % 100 == 0) {
-            printf("  Epoch %4d: Loss = %.6f\n", epoch + 1, total_loss / N_TRAIN);
-        }
+    if (n_train < 1 || n_test < 1 || hidden < 1 || epochs < 1 || train.batch < 1) {
+        usage(argv[0]);
+        return 1;
     }
-}
-
-int main(void) {
+    train.epochs = epochs;
+    train.report_every = epochs >= 5 ? epochs / 5 : 1;
+    
     printf(BOLD RED "\n");
     printf("╔═══════════════════════════════════════════════════════════════╗\n");
     printf("║           MACHINE LEARNING ATTACK ON DIFFEQAUTH              ║\n");
@@ -185,82 +118,62 @@ int main(void) {
     AuthSecret target = {2.5f, 0.8f, 12345};
     
     printf("\n" CYAN "Phase 1: Collecting Training Data" RESET "\n");
-    printf("  (Attacker observes %d challenge-response pairs)\n\n", N_TRAIN);
-    
-    // Collect training data
-    float train_challenges[N_TRAIN][CHALLENGE_LENGTH];
-    float train_responses[N_TRAIN][4];
-    
-    srand(42);
-    for (int i = 0; i < N_TRAIN; i++) {
-        for (int j = 0; j < CHALLENGE_LENGTH; j++) {
-            train_challenges[i][j] = ((float)rand() / RAND_MAX) * 3.0f;
-        }
-        AuthResponse r = auth_compute_response(train_challenges[i], CHALLENGE_LENGTH, &target);
-        train_responses[i][0] = r.psi;
-        train_responses[i][1] = r.i_val;
-        train_responses[i][2] = r.r_val;
-        train_responses[i][3] = r.phi_avg;
+    printf("  (Attacker observes %d challenge-response pairs)\n\n", n_train);
+    
+    // Collect training and held-out test data (batch engine, all cores)
+    MlDataset train_set, test_set;
+    double t0 = auth_now_seconds();
+    if (!ml_dataset_generate(&train_set, n_train, &target, AUTH_ENGINE_REV_1, extract_features,
+                             N_FEATURES, N_OUTPUTS, 42, threads) ||
+        !ml_dataset_generate(&test_set, n_test, &target, AUTH_ENGINE_REV_1, extract_features,
+                             N_FEATURES, N_OUTPUTS, 9999, threads)) {
+        fprintf(stderr, "Out of memory for %d + %d CRPs\n", n_train, n_test);
+        return 1;
     }
+    double gen_s = auth_now_seconds() - t0;
+    printf("  %d CRPs in %.2fs\n\n", n_train + n_test, gen_s);
     
     printf(CYAN "Phase 2: Training Neural Network" RESET "\n\n");
     
     // Initialize NN with small random weights
-    NeuralNet nn;
-    srand(12345);
-    for (int i = 0; i < N_FEATURES; i++) {
-        for (int j = 0; j < 20; j++) {
-            nn.w1[i][j] = ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
-        }
-    }
-    for (int i = 0; i < 20; i++) {
-        nn.b1[i] = 0;
-        for (int j = 0; j < 4; j++) {
-            nn.w2[i][j] = ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
-        }
-    }
-    for (int j = 0; j < 4; j++) {
-        nn.b2[j] = 0;
+    MlModel nn;
+    if (!ml_model_init(&nn, N_FEATURES, hidden, N_OUTPUTS, 0.1f, 12345)) {
+        fprintf(stderr, "Out of memory for %d hidden units\n", hidden);
+        return 1;
     }
-    
-    nn_train(&nn, train_challenges, train_responses, 500);
+    t0 = auth_now_seconds();
+    ml_train(&nn, &train_set, &train);
+    double train_s = auth_now_seconds() - t0;
+    printf("  %d hidden units, %d epochs in %.2fs (%.0f samples/s)\n", hidden, epochs, train_s,
+           (double)n_train * epochs / train_s);
     
     printf("\n" CYAN "Phase 3: Testing Attack on New Challenges" RESET "\n\n");
     
     // Test on completely new challenges
-    srand(9999);  // Different seed for test data
-    
     int auth_bypassed = 0;
     float tolerance = 0.01f;  // 1% tolerance
     
-    printf("  Testing %d new challenges...\n\n", N_TEST);
+    printf("  Testing %d new challenges...\n\n", n_test);
+    
+    float* predictions = malloc((size_t)n_test * N_OUTPUTS * sizeof(float));
+    if (!predictions) return 1;
+    ml_predict(&nn, test_set.x, n_test, predictions);
     
     float total_psi_error = 0;
     float total_i_error = 0;
     float total_r_error = 0;
     float total_phi_error = 0;
     
-    for (int i = 0; i < N_TEST; i++) {
-        float test_challenge[CHALLENGE_LENGTH];
-        for (int j = 0; j < CHALLENGE_LENGTH; j++) {
-            test_challenge[j] = ((float)rand() / RAND_MAX) * 3.0f;
-        }
-        
-        // True response (what server expects)
-        AuthResponse true_resp = auth_compute_response(test_challenge, CHALLENGE_LENGTH, &target);
-        
-        // Attacker's prediction
-        float features[N_FEATURES];
-        extract_features(test_challenge, features);
-        
-        float predicted[4];
-        nn_forward(&nn, features, predicted);
+    for (int i = 0; i < n_test; i++) {
+        // True response (what server expects) vs the attacker's prediction
+        const float* truth = &test_set.y[(size_t)i * N_OUTPUTS];
+        const float* predicted = &predictions[(size_t)i * N_OUTPUTS];
         
         // Check if prediction is close enough to bypass
-        float psi_err = fabsf(predicted[0] - true_resp.psi) / fabsf(true_resp.psi);
-        float i_err = fabsf(predicted[1] - true_resp.i_val) / fabsf(true_resp.i_val);
-        float r_err = fabsf(predicted[2] - true_resp.r_val) / fabsf(true_resp.r_val);
-        float phi_err = fabsf(predicted[3] - true_resp.phi_avg) / fabsf(true_resp.phi_avg);
+        float psi_err = fabsf(predicted[0] - truth[0]) / fabsf(truth[0]);
+        float i_err = fabsf(predicted[1] - truth[1]) / fabsf(truth[1]);
+        float r_err = fabsf(predicted[2] - truth[2]) / fabsf(truth[2]);
+        float phi_err = fabsf(predicted[3] - truth[3]) / fabsf(truth[3]);
         
         total_psi_error += psi_err;
         total_i_error += i_err;
@@ -272,33 +185,37 @@ int main(void) {
             auth_bypassed++;
             if (auth_bypassed <= 5) {
                 printf(RED "  BYPASSED #%d:" RESET " True Ψ=%.4f, Predicted=%.4f (%.2f%% error)\n",
-                       auth_bypassed, true_resp.psi, predicted[0], psi_err * 100);
+                       auth_bypassed, truth[0], predicted[0], psi_err * 100);
             }
         }
     }
+    free(predictions);
+    ml_model_free(&nn);
+    ml_dataset_free(&train_set);
+    ml_dataset_free(&test_set);
     
     printf("\n" BOLD CYAN "═══════════════════════════════════════════════════════════" RESET "\n");
     printf(BOLD "MACHINE LEARNING ATTACK RESULTS" RESET "\n");
     printf(CYAN "═══════════════════════════════════════════════════════════" RESET "\n\n");
     
-    printf("  Training samples:    %d\n", N_TRAIN);
-    printf("  Test samples:        %d\n", N_TEST);
+    printf("  Training samples:    %d\n", n_train);
+    printf("  Test samples:        %d\n", n_test);
     printf("  Tolerance:           %.0f%%\n\n", tolerance * 100);
     
     printf("  Average Prediction Errors:\n");
-    printf("    Ψ (psi):    %.2f%%\n", total_psi_error / N_TEST * 100);
-    printf("    I:          %.2f%%\n", total_i_error / N_TEST * 100);
-    printf("    R:          %.2f%%\n", total_r_error / N_TEST * 100);
-    printf("    Φ (phi):    %.2f%%\n", total_phi_error / N_TEST * 100);
+    printf("    Ψ (psi):    %.2f%%\n", total_psi_error / n_test * 100);
+    printf("    I:          %.2f%%\n", total_i_error / n_test * 100);
+    printf("    R:          %.2f%%\n", total_r_error / n_test * 100);
+    printf("    Φ (phi):    %.2f%%\n", total_phi_error / n_test * 100);
     
     printf("\n  Authentication Bypassed: " BOLD "%d / %d (%.1f%%)" RESET "\n", 
-           auth_bypassed, N_TEST, (float)auth_bypassed / N_TEST * 100);
+           auth_bypassed, n_test, (float)auth_bypassed / n_test * 100);
     
     if (auth_bypassed > 0) {
         printf(RED "\n  ⚠ CRITICAL VULNERABILITY: ML attack bypassed %d authentications!" RESET "\n", auth_bypassed);
-        printf(RED "  An attacker with ~500 observed challenge-response pairs can" RESET "\n");
+        printf(RED "  An attacker with ~%d observed challenge-response pairs can" RESET "\n", n_train);
         printf(RED "  predict responses and bypass authentication!" RESET "\n");
-    } else if (total_psi_error / N_TEST < 0.05) {
+    } else if (total_psi_error / n_test < 0.05) {
         printf(YELLOW "\n  ⚠ WARNING: Prediction error <5%%, close to exploitable" RESET "\n");
     } else {
         printf(GREEN "\n  ✓ SECURE: ML attack failed to predict responses accurately" RESET "\n");
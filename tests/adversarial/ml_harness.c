@@ -0,0 +1,365 @@
+// ml_harness.c
+// Training harness for the ML attacks (ml_attack.c, ml_attack_v2.c)
+
+#include "ml_harness.h"
+#include "auth_util.h"
+#include "physics_auth_internal.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DATASET_CHUNK 256        // samples per claimed chunk, multiple of AUTH_BATCH_LANES
+
+// GEMM blocking: a KC x NC panel of B stays in L2, an MC x KC panel of A
+// in L1/L2, and the MR x NR accumulator tile in registers
+#define GEMM_MR 6
+#define GEMM_NR 16
+#define GEMM_MC 96
+#define GEMM_KC 256
+#define GEMM_NC 512
+
+// ============================================================================
+// DATASETS
+// ============================================================================
+
+static float unit_float(uint64_t* state) {
+    return (float)(auth_splitmix64(state) >> 40) / 16777216.0f;
+}
+
+void ml_dataset_challenge(uint64_t rng_seed, int i, float* challenge) {
+    uint64_t state = rng_seed ^ ((uint64_t)i * 0xd1b54a32d192ed03ull);
+    for (int j = 0; j < CHALLENGE_LENGTH; j++) challenge[j] = unit_float(&state) * 3.0f;
+}
+
+typedef struct {
+    MlDataset* ds;
+    const AuthSecret* target;
+    int revision;
+    MlFeatureFn features;
+    uint64_t rng_seed;
+    int n_chunks;
+    atomic_int next_chunk;
+} DatasetShared;
+
+static void* dataset_worker(void* arg) {
+    DatasetShared* sh = arg;
+    MlDataset* ds = sh->ds;
+    float challenges[DATASET_CHUNK * CHALLENGE_LENGTH];
+    AuthSecret secrets[DATASET_CHUNK];
+    AuthResponse responses[DATASET_CHUNK];
+    for (int j = 0; j < DATASET_CHUNK; j++) secrets[j] = *sh->target;
+
+    for (;;) {
+        int chunk = atomic_fetch_add_explicit(&sh->next_chunk, 1, memory_order_relaxed);
+        if (chunk >= sh->n_chunks) break;
+        int base = chunk * DATASET_CHUNK;
+        int n = ds->n - base < DATASET_CHUNK ? ds->n - base : DATASET_CHUNK;
+        for (int j = 0; j < n; j++) {
+            ml_dataset_challenge(sh->rng_seed, base + j, &challenges[j * CHALLENGE_LENGTH]);
+        }
+        auth_compute_response_batch_rev(challenges, CHALLENGE_LENGTH, CHALLENGE_LENGTH, secrets, n,
+                                        sh->revision, responses);
+        for (int j = 0; j < n; j++) {
+            size_t i = (size_t)(base + j);
+            sh->features(&challenges[j * CHALLENGE_LENGTH], &ds->x[i * (size_t)ds->n_features]);
+            memcpy(&ds->y[i * (size_t)ds->n_outputs], &responses[j],
+                   (size_t)ds->n_outputs * sizeof(float));
+        }
+    }
+    return NULL;
+}
+
+int ml_dataset_generate(MlDataset* ds, int n, const AuthSecret* target, int revision,
+                        MlFeatureFn features, int n_features, int n_outputs, uint64_t rng_seed,
+                        int threads) {
+    memset(ds, 0, sizeof(*ds));
+    if (n < 1 || n_features < 1 || n_features > ML_MAX_FEATURES || n_outputs < 1 ||
+        n_outputs > ML_MAX_OUTPUTS) return 0;
+    ds->n = n;
+    ds->n_features = n_features;
+    ds->n_outputs = n_outputs;
+    ds->x = malloc((size_t)n * (size_t)n_features * sizeof(float));
+    ds->y = malloc((size_t)n * (size_t)n_outputs * sizeof(float));
+    if (!ds->x || !ds->y) {
+        ml_dataset_free(ds);
+        return 0;
+    }
+
+    DatasetShared sh = {.ds = ds, .target = target, .revision = revision, .features = features,
+                        .rng_seed = rng_seed, .n_chunks = (n + DATASET_CHUNK - 1) / DATASET_CHUNK};
+    atomic_init(&sh.next_chunk, 0);
+    threads = auth_workers_resolve(threads, (uint64_t)sh.n_chunks);
+    auth_tables_ensure();   // before any worker reads the tables
+    auth_workers_run(dataset_worker, &sh, threads);
+    return 1;
+}
+
+void ml_dataset_free(MlDataset* ds) {
+    free(ds->x);
+    free(ds->y);
+    ds->x = ds->y = NULL;
+}
+
+// ============================================================================
+// GEMM
+// ============================================================================
+
+static _Alignas(64) float pack_a[GEMM_MC * GEMM_KC];
+static _Alignas(64) float pack_b[GEMM_KC * GEMM_NC];
+
+// MR-row panels of op(A)[ic.., pc..], k-major, zero-padded to MR rows
+static void pack_a_block(int trans, const float* a, int lda, int ic, int mc, int pc, int kc) {
+    float* dst = pack_a;
+    for (int ir = 0; ir < mc; ir += GEMM_MR) {
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < GEMM_MR; i++) {
+                int row = ic + ir + i, col = pc + p;
+                *dst++ = ir + i >= mc ? 0.0f
+                         : trans     ? a[(size_t)col * (size_t)lda + (size_t)row]
+                                     : a[(size_t)row * (size_t)lda + (size_t)col];
+            }
+        }
+    }
+}
+
+// NR-column panels of op(B)[pc.., jc..], k-major, zero-padded to NR columns
+static void pack_b_block(int trans, const float* b, int ldb, int pc, int kc, int jc, int nc) {
+    float* dst = pack_b;
+    for (int jr = 0; jr < nc; jr += GEMM_NR) {
+        for (int p = 0; p < kc; p++) {
+            for (int j = 0; j < GEMM_NR; j++) {
+                int row = pc + p, col = jc + jr + j;
+                *dst++ = jr + j >= nc ? 0.0f
+                         : trans     ? b[(size_t)col * (size_t)ldb + (size_t)row]
+                                     : b[(size_t)row * (size_t)ldb + (size_t)col];
+            }
+        }
+    }
+}
+
+// Half a row of the tile. GCC/Clang vector extensions lower it to AVX,
+// SSE or NEON registers, as in the batch engine.
+typedef float gemm_vec __attribute__((vector_size(sizeof(float) * GEMM_NR / 2)));
+
+// c[mr x nr] = scale * c + (A panel)(B panel), with the 6 x 16 tile in
+// twelve vector accumulators across the k loop
+static void micro_kernel(int kc, const float* restrict ap, const float* restrict bp, float scale,
+                         float* restrict c, int ldc, int mr, int nr) {
+    gemm_vec acc[GEMM_MR][2];
+    for (int i = 0; i < GEMM_MR; i++) acc[i][0] = acc[i][1] = (gemm_vec){0};
+    for (int p = 0; p < kc; p++) {
+        gemm_vec b0 = *(const gemm_vec*)&bp[p * GEMM_NR];   // packed panels are 64-byte aligned
+        gemm_vec b1 = *(const gemm_vec*)&bp[p * GEMM_NR + GEMM_NR / 2];
+        for (int i = 0; i < GEMM_MR; i++) {
+            gemm_vec av = (gemm_vec){0} + ap[p * GEMM_MR + i];
+            acc[i][0] += av * b0;
+            acc[i][1] += av * b1;
+        }
+    }
+    float tile[GEMM_MR][GEMM_NR];
+    memcpy(tile, acc, sizeof(tile));
+    for (int i = 0; i < mr; i++) {
+        float* row = &c[(size_t)i * (size_t)ldc];
+        for (int j = 0; j < nr; j++) {
+            // scale 0 overwrites, so C may start uninitialized
+            row[j] = scale == 0.0f ? tile[i][j] : scale * row[j] + tile[i][j];
+        }
+    }
+}
+
+void ml_gemm(int trans_a, int trans_b, int m, int n, int k, const float* a, int lda,
+             const float* b, int ldb, float beta, float* c, int ldc) {
+    if (k <= 0) {
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < n; j++) c[(size_t)i * (size_t)ldc + (size_t)j] *= beta;
+        }
+        return;
+    }
+    for (int jc = 0; jc < n; jc += GEMM_NC) {
+        int nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        for (int pc = 0; pc < k; pc += GEMM_KC) {
+            int kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            float scale = pc == 0 ? beta : 1.0f;   // later K blocks accumulate
+            pack_b_block(trans_b, b, ldb, pc, kc, jc, nc);
+            for (int ic = 0; ic < m; ic += GEMM_MC) {
+                int mc = m - ic < GEMM_MC ? m - ic : GEMM_MC;
+                pack_a_block(trans_a, a, lda, ic, mc, pc, kc);
+                for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                    const float* bp = &pack_b[(size_t)(jr / GEMM_NR) * (size_t)kc * GEMM_NR];
+                    int nr = nc - jr < GEMM_NR ? nc - jr : GEMM_NR;
+                    for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                        const float* ap = &pack_a[(size_t)(ir / GEMM_MR) * (size_t)kc * GEMM_MR];
+                        int mr = mc - ir < GEMM_MR ? mc - ir : GEMM_MR;
+                        micro_kernel(kc, ap, bp, scale,
+                                     &c[(size_t)(ic + ir) * (size_t)ldc + (size_t)(jc + jr)], ldc,
+                                     mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// MODEL
+// ============================================================================
+
+int ml_model_init(MlModel* m, int n_features, int hidden, int n_outputs, float init_scale,
+                  uint64_t seed) {
+    memset(m, 0, sizeof(*m));
+    if (n_features < 1 || hidden < 1 || n_outputs < 1) return 0;
+    m->n_features = n_features;
+    m->hidden = hidden;
+    m->n_outputs = n_outputs;
+    m->w1 = malloc((size_t)n_features * (size_t)hidden * sizeof(float));
+    m->b1 = calloc((size_t)hidden, sizeof(float));
+    m->w2 = malloc((size_t)hidden * (size_t)n_outputs * sizeof(float));
+    m->b2 = calloc((size_t)n_outputs, sizeof(float));
+    if (!m->w1 || !m->b1 || !m->w2 || !m->b2) {
+        ml_model_free(m);
+        return 0;
+    }
+    uint64_t state = seed;
+    for (int i = 0; i < n_features * hidden; i++) m->w1[i] = (unit_float(&state) - 0.5f) * init_scale;
+    for (int i = 0; i < hidden * n_outputs; i++) m->w2[i] = (unit_float(&state) - 0.5f) * init_scale;
+    return 1;
+}
+
+void ml_model_free(MlModel* m) {
+    free(m->w1);
+    free(m->b1);
+    free(m->w2);
+    free(m->b2);
+    memset(m, 0, sizeof(*m));
+}
+
+static void add_bias(float* x, int rows, int cols, const float* bias) {
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) x[(size_t)r * (size_t)cols + (size_t)c] += bias[c];
+    }
+}
+
+// hidden_pre = x W1 + b1, hidden = relu(hidden_pre), y = hidden W2 + b2
+static void forward(const MlModel* m, const float* x, int n, float* hidden_pre, float* hidden,
+                    float* y) {
+    int h = m->hidden;
+    ml_gemm(0, 0, n, h, m->n_features, x, m->n_features, m->w1, h, 0.0f, hidden_pre, h);
+    add_bias(hidden_pre, n, h, m->b1);
+    for (size_t i = 0; i < (size_t)n * (size_t)h; i++) {
+        hidden[i] = hidden_pre[i] > 0.0f ? hidden_pre[i] : 0.0f;
+    }
+    ml_gemm(0, 0, n, m->n_outputs, h, hidden, h, m->w2, m->n_outputs, 0.0f, y, m->n_outputs);
+    add_bias(y, n, m->n_outputs, m->b2);
+}
+
+void ml_predict(const MlModel* m, const float* x, int n, float* y) {
+    enum { CHUNK = 1024 };
+    float* hidden_pre = malloc((size_t)CHUNK * (size_t)m->hidden * sizeof(float));
+    float* hidden = malloc((size_t)CHUNK * (size_t)m->hidden * sizeof(float));
+    if (!hidden_pre || !hidden) {
+        free(hidden_pre);
+        free(hidden);
+        return;
+    }
+    for (int base = 0; base < n; base += CHUNK) {
+        int rows = n - base < CHUNK ? n - base : CHUNK;
+        forward(m, &x[(size_t)base * (size_t)m->n_features], rows, hidden_pre, hidden,
+                &y[(size_t)base * (size_t)m->n_outputs]);
+    }
+    free(hidden_pre);
+    free(hidden);
+}
+
+// ============================================================================
+// TRAINING
+// ============================================================================
+
+float ml_train(MlModel* m, const MlDataset* ds, const MlTrainConfig* cfg) {
+    int f = m->n_features, h = m->hidden, o = m->n_outputs;
+    int batch = cfg->batch > 0 ? cfg->batch : 1;
+    if (batch > ds->n) batch = ds->n;
+
+    // Workspace: one mini-batch of activations and gradients
+    size_t floats = (size_t)batch * (size_t)(f + 3 * h + 3 * o) + (size_t)h * (size_t)(o + f + 1);
+    float* work = malloc(floats * sizeof(float));
+    int* order = malloc((size_t)ds->n * sizeof(int));
+    if (!work || !order) {
+        free(work);
+        free(order);
+        return -1.0f;
+    }
+    float* xb = work;
+    float* tb = xb + (size_t)batch * f;
+    float* hidden_pre = tb + (size_t)batch * o;
+    float* hidden = hidden_pre + (size_t)batch * h;
+    float* y = hidden + (size_t)batch * h;
+    float* dy = y + (size_t)batch * o;
+    float* dh = dy + (size_t)batch * o;
+    float* dw2 = dh + (size_t)batch * h;
+    float* dw1 = dw2 + (size_t)h * o;
+    float* db1 = dw1 + (size_t)f * h;
+    float db2[ML_MAX_OUTPUTS];
+
+    for (int i = 0; i < ds->n; i++) order[i] = i;
+    uint64_t rng = cfg->shuffle_seed;
+    float epoch_loss = 0.0f;
+
+    for (int epoch = 0; epoch < cfg->epochs; epoch++) {
+        // Fisher-Yates shuffle per epoch
+        for (int i = ds->n - 1; i > 0; i--) {
+            int j = (int)(auth_splitmix64(&rng) % (uint64_t)(i + 1));
+            int t = order[i];
+            order[i] = order[j];
+            order[j] = t;
+        }
+        double total_loss = 0.0;
+        for (int base = 0; base < ds->n; base += batch) {
+            int b = ds->n - base < batch ? ds->n - base : batch;
+            for (int r = 0; r < b; r++) {
+                size_t s = (size_t)order[base + r];
+                memcpy(&xb[(size_t)r * f], &ds->x[s * (size_t)f], (size_t)f * sizeof(float));
+                memcpy(&tb[(size_t)r * o], &ds->y[s * (size_t)o], (size_t)o * sizeof(float));
+            }
+            forward(m, xb, b, hidden_pre, hidden, y);
+
+            // Squared error summed over outputs, averaged over the batch
+            float inv_b = 1.0f / (float)b;
+            for (size_t i = 0; i < (size_t)b * (size_t)o; i++) {
+                float diff = y[i] - tb[i];
+                total_loss += (double)(diff * diff);
+                dy[i] = 2.0f * diff * inv_b;
+            }
+
+            // Output layer: dW2 = H^T dY, db2 = column sums of dY
+            ml_gemm(1, 0, h, o, b, hidden, h, dy, o, 0.0f, dw2, o);
+            for (int j = 0; j < o; j++) db2[j] = 0.0f;
+            for (int r = 0; r < b; r++) {
+                for (int j = 0; j < o; j++) db2[j] += dy[(size_t)r * o + j];
+            }
+
+            // Hidden layer: dH = dY W2^T through the ReLU, dW1 = X^T dH
+            ml_gemm(0, 1, b, h, o, dy, o, m->w2, o, 0.0f, dh, h);
+            for (size_t i = 0; i < (size_t)b * (size_t)h; i++) {
+                if (hidden_pre[i] <= 0.0f) dh[i] = 0.0f;
+            }
+            ml_gemm(1, 0, f, h, b, xb, f, dh, h, 0.0f, dw1, h);
+            for (int j = 0; j < h; j++) db1[j] = 0.0f;
+            for (int r = 0; r < b; r++) {
+                for (int j = 0; j < h; j++) db1[j] += dh[(size_t)r * h + j];
+            }
+
+            for (int i = 0; i < h * o; i++) m->w2[i] -= cfg->lr * dw2[i];
+            for (int j = 0; j < o; j++) m->b2[j] -= cfg->lr * db2[j];
+            for (int i = 0; i < f * h; i++) m->w1[i] -= cfg->lr * dw1[i];
+            for (int j = 0; j < h; j++) m->b1[j] -= cfg->lr * db1[j];
+        }
+        epoch_loss = (float)(total_loss / ds->n);
+        if (cfg->report_every > 0 && (epoch + 1) % cfg->report_every == 0) {
+            printf("  Epoch %4d: Loss = %.6f\n", epoch + 1, epoch_loss);
+        }
+    }
+    free(work);
+    free(order);
+    return epoch_loss;
+}
@@ -0,0 +1,75 @@
+// ml_harness.h
+// Training harness for the ML attacks (ml_attack.c, ml_attack_v2.c)
+//
+// - Datasets: challenge i of a dataset is a pure function of (rng_seed, i),
+//   and responses come from the batch engine on worker threads, so 10^6
+//   CRPs spread over every core and are the same whatever the thread count
+// - Model: one-hidden-layer ReLU MLP of configurable width, trained with
+//   mini-batch SGD on a mean squared error
+// - Every layer is a cache-blocked GEMM on packed panels, with a 6 x 16
+//   register-tile micro-kernel written with GCC/Clang vector extensions
+// Training is single-threaded and uses static GEMM scratch: one model
+// trains at a time.
+
+#ifndef ML_HARNESS_H
+#define ML_HARNESS_H
+
+#include "physics_auth.h"
+
+#define ML_MAX_FEATURES 32
+#define ML_MAX_OUTPUTS 8   // AuthResponse channels, psi first
+
+// Summarizes a CHALLENGE_LENGTH challenge into n_features values
+typedef void (*MlFeatureFn)(const float* challenge, float* features);
+
+typedef struct {
+    int n;
+    int n_features;
+    int n_outputs;
+    float* x;   // n x n_features
+    float* y;   // n x n_outputs: the leading response channels
+} MlDataset;
+
+typedef struct {
+    int n_features, hidden, n_outputs;
+    float* w1;  // n_features x hidden
+    float* b1;
+    float* w2;  // hidden x n_outputs
+    float* b2;
+} MlModel;
+
+typedef struct {
+    int epochs;
+    int batch;              // samples per SGD step
+    float lr;
+    uint64_t shuffle_seed;
+    int report_every;       // print the loss every this many epochs, 0 = never
+} MlTrainConfig;
+
+// n CRPs of target: challenge values uniform in [0, 3). threads <= 0:
+// one per online CPU. Returns 0 on allocation failure.
+int ml_dataset_generate(MlDataset* ds, int n, const AuthSecret* target, int revision,
+                        MlFeatureFn features, int n_features, int n_outputs, uint64_t rng_seed,
+                        int threads);
+void ml_dataset_free(MlDataset* ds);
+
+// The challenge of sample i (for re-querying the oracle)
+void ml_dataset_challenge(uint64_t rng_seed, int i, float* challenge);
+
+// Weights uniform in [-init_scale/2, init_scale/2), biases zero
+int ml_model_init(MlModel* m, int n_features, int hidden, int n_outputs, float init_scale,
+                  uint64_t seed);
+void ml_model_free(MlModel* m);
+
+// Returns the mean per-sample loss of the last epoch
+float ml_train(MlModel* m, const MlDataset* ds, const MlTrainConfig* cfg);
+
+// y[n x n_outputs] for x[n x n_features]
+void ml_predict(const MlModel* m, const float* x, int n, float* y);
+
+// C[m x n] = beta * C + op(A) * op(B), row-major with row strides lda,
+// ldb, ldc; op(X) is X transposed when trans_x is set
+void ml_gemm(int trans_a, int trans_b, int m, int n, int k, const float* a, int lda,
+             const float* b, int ldb, float beta, float* c, int ldc);
+
+#endif // ML_HARNESS_H
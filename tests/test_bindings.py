@@ -0,0 +1,151 @@
+# tests/test_bindings.py
+# Tests of the physics_auth_c extension (src/physics_auth_module.c)
+#
+# Run with `make python_test`, which builds the extension in place and the
+# auth_conformance tool first. Reference responses come from a corpus made
+# by auth_conformance, so the bindings are checked bit for bit against the
+# C engine, not against themselves. Needs only the standard library.
+
+import array
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, ROOT)
+
+import physics_auth_c as pac  # noqa: E402
+
+CONFORMANCE = os.path.join(ROOT, "auth_conformance")
+PROFILES = ["low-power", "default", "hardened"]   # AUTH_PROFILE_* order
+HEADER_SIZE = 64                                  # auth_corpus.h
+RECORD = struct.Struct("<ffIIHBx8f")
+
+
+def bits(values):
+    """Float32 bit patterns, so -0.0 / NaN compare exactly"""
+    return array.array("f", values).tobytes()
+
+
+def c_corpus(revision, count=48, seed=7):
+    """(k, gamma, seed, challenge id, length, profile name, response) vectors"""
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "corpus.bin")
+        subprocess.run([CONFORMANCE, "gen", path, str(count), str(revision), str(seed), "1"],
+                       check=True, stdout=subprocess.DEVNULL)
+        with open(path, "rb") as f:
+            data = f.read()
+    vectors = []
+    for i in range(count):
+        k, gamma, s, cid, length, profile, *resp = RECORD.unpack_from(
+            data, HEADER_SIZE + i * RECORD.size)
+        vectors.append((k, gamma, s, cid, length, PROFILES[profile], resp))
+    return vectors
+
+
+def secrets(n):
+    k = array.array("f", [0.5 + 0.1 * i for i in range(n)])
+    gamma = array.array("f", [0.2 + 0.05 * i for i in range(n)])
+    seed = array.array("I", [1000 + i for i in range(n)])
+    return k, gamma, seed
+
+
+class MatchesCEngine(unittest.TestCase):
+    @unittest.skipUnless(os.access(CONFORMANCE, os.X_OK), "run make auth_conformance first")
+    def test_corpus(self):
+        for revision in (pac.REV_1, pac.REV_LATEST):
+            vectors = c_corpus(revision)
+            for k, gamma, s, cid, length, profile, resp in vectors:
+                challenge = pac.challenge_from_id(cid, length)
+                got = pac.compute_response(challenge, k, gamma, s, revision, profile)
+                self.assertEqual(bits(got), bits(resp))
+            # Blocks of AUTH_BATCH_LANES vectors share profile and length
+            for base in range(0, len(vectors), 8):
+                block = vectors[base:base + 8]
+                length, profile = block[0][4], block[0][5]
+                rows = array.array("f")
+                for v in block:
+                    rows.extend(pac.challenge_from_id(v[3], length))
+                challenges = memoryview(rows).cast("B").cast("f", (len(block), length))
+                out = pac.compute_response_batch(
+                    challenges, array.array("f", [v[0] for v in block]),
+                    array.array("f", [v[1] for v in block]),
+                    array.array("I", [v[2] for v in block]), revision, profile=profile)
+                self.assertEqual(out.tobytes(), b"".join(bits(v[6]) for v in block))
+
+
+class Batch(unittest.TestCase):
+    def test_broadcast_equals_rows(self):
+        n = 11
+        k, gamma, seed = secrets(n)
+        challenge = pac.challenge_from_id(42)
+        broadcast = pac.compute_response_batch(challenge, k, gamma, seed)
+        rows = array.array("f", challenge.tolist() * n)
+        per_row = pac.compute_response_batch(
+            memoryview(rows).cast("B").cast("f", (n, pac.CHALLENGE_LENGTH)), k, gamma, seed)
+        self.assertEqual(broadcast.shape, (n, 8))
+        self.assertEqual(broadcast.tobytes(), per_row.tobytes())
+        for i, row in enumerate(broadcast.tolist()):
+            one = pac.compute_response(challenge, k[i], gamma[i], seed[i])
+            self.assertEqual(bits(one), bits(row))
+
+    def test_out(self):
+        k, gamma, seed = secrets(5)
+        challenge = pac.challenge_from_id(7)
+        out = array.array("f", [0.0] * 40)
+        result = pac.compute_response_batch(challenge, k, gamma, seed, out=out)
+        self.assertIs(result, out)
+        self.assertEqual(out.tobytes(),
+                         pac.compute_response_batch(challenge, k, gamma, seed).tobytes())
+
+    def test_profile(self):
+        k, gamma, seed = secrets(3)
+        challenge = pac.challenge_from_id(9, 16)
+        low = pac.compute_response_batch(challenge, k, gamma, seed, profile="low-power")
+        default = pac.compute_response_batch(challenge, k, gamma, seed)
+        self.assertNotEqual(low.tobytes(), default.tobytes())
+        for i in range(3):
+            one = pac.compute_response(challenge, k[i], gamma[i], seed[i], profile="low-power")
+            self.assertEqual(bits(one), bits(low.tolist()[i]))
+        with self.assertRaises(ValueError):
+            pac.compute_response_batch(challenge, k, gamma, seed, profile="turbo")
+        with self.assertRaises(ValueError):
+            pac.compute_response(challenge, 1.0, 0.5, 1, profile="turbo")
+
+    def test_empty_batch(self):
+        k, gamma, seed = secrets(0)
+        result = pac.compute_response_batch(pac.challenge_from_id(1), k, gamma, seed)
+        self.assertEqual(result.shape, (0, 8))
+        self.assertEqual(result.tolist(), [])
+        out = array.array("f")
+        self.assertIs(pac.compute_response_batch(pac.challenge_from_id(1), k, gamma, seed,
+                                                 out=out), out)
+
+    def test_errors(self):
+        k, gamma, seed = secrets(4)
+        challenge = pac.challenge_from_id(3)
+        with self.assertRaises(ValueError):   # secret arrays of different lengths
+            pac.compute_response_batch(challenge, k, gamma[:3], seed)
+        with self.assertRaises(ValueError):   # one challenge row per secret
+            rows = array.array("f", challenge.tolist() * 3)
+            pac.compute_response_batch(memoryview(rows).cast("B").cast("f", (3, 50)), k,
+                                       gamma, seed)
+        with self.assertRaises(ValueError):   # out of the wrong size
+            pac.compute_response_batch(challenge, k, gamma, seed, out=array.array("f", [0] * 8))
+        with self.assertRaises(ValueError):   # empty challenge
+            pac.compute_response_batch(array.array("f"), k, gamma, seed)
+        with self.assertRaises(ValueError):
+            pac.compute_response(array.array("f"), 1.0, 0.5, 1)
+        with self.assertRaises(ValueError):   # unsupported revision
+            pac.compute_response_batch(challenge, k, gamma, seed, pac.REV_LATEST + 1)
+        with self.assertRaises(TypeError):    # float64, not float32
+            pac.compute_response_batch(array.array("d", [0.0] * 50), k, gamma, seed)
+        with self.assertRaises(BufferError):  # read-only out
+            pac.compute_response_batch(challenge, k, gamma, seed, out=bytes(128))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,104 @@
+# tests/test_server.py
+# Connection-lifetime tests of auth_server
+#
+# Run with `make server_test`, which builds the server with AddressSanitizer
+# (auth_server_asan) so that a use of a freed connection aborts it. Each
+# test attacks the server, then checks that it is still running and still
+# answers. AUTH_SERVER overrides the binary. Needs only the standard library.
+
+import os
+import socket
+import struct
+import subprocess
+import sys
+import time
+import unittest
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SERVER = os.environ.get("AUTH_SERVER", os.path.join(ROOT, "auth_server_asan"))
+REQUEST = b"GET / \r\n\r\n"        # 404, answered from the batch
+PIPELINED = 800                     # 800 * 10 bytes fit CONN_IN; two of them overflow MAX_BATCH
+
+
+def free_port():
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def reset(sock):
+    """Close with an RST instead of a FIN (SO_LINGER 0)"""
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+    sock.close()
+
+
+@unittest.skipUnless(os.access(SERVER, os.X_OK), "run make server_test")
+class ConnectionLifetime(unittest.TestCase):
+    def setUp(self):
+        self.port = free_port()
+        self.proc = subprocess.Popen([SERVER, "-p", str(self.port), "-r", "0"],
+                                     stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+        for _ in range(100):
+            try:
+                socket.create_connection(("127.0.0.1", self.port), timeout=1).close()
+                return
+            except OSError:
+                time.sleep(0.05)
+        self.fail("auth_server did not start")
+
+    def tearDown(self):
+        self.proc.terminate()
+        _, err = self.proc.communicate(timeout=10)
+        self.assertFalse(b"AddressSanitizer" in err, err.decode(errors="replace"))
+
+    def connect(self):
+        return socket.create_connection(("127.0.0.1", self.port), timeout=5)
+
+    def assert_alive(self):
+        time.sleep(0.2)
+        self.assertIsNone(self.proc.poll(), "auth_server exited")
+        with self.connect() as s:
+            s.sendall(b"GET /metrics HTTP/1.1\r\n\r\n")
+            self.assertTrue(s.recv(64).startswith(b"HTTP/1.1 200"))
+
+    def test_pipelined_then_reset(self):
+        # Replying to the first request fails; the second still refers to
+        # the connection
+        for _ in range(50):
+            s = self.connect()
+            s.sendall(REQUEST * 2)
+            reset(s)
+        self.assert_alive()
+
+    def test_batch_overflow_during_parse(self):
+        # The batch fills up while one connection is being parsed; the
+        # flush that makes room writes to a connection that has been reset
+        for _ in range(20):
+            victim, parsed = self.connect(), self.connect()
+            victim.sendall(REQUEST * PIPELINED)
+            parsed.sendall(REQUEST * PIPELINED)
+            reset(victim)
+            reset(parsed)
+        self.assert_alive()
+
+    def test_batch_overflow_answers_everything(self):
+        # Parsing stops at a full batch and resumes after the flush: every
+        # pipelined request still gets its answer, in order
+        a, b = self.connect(), self.connect()
+        a.sendall(REQUEST * PIPELINED)
+        b.sendall(REQUEST * PIPELINED)
+        for s in (a, b):
+            s.shutdown(socket.SHUT_WR)
+            data = b""
+            while True:
+                chunk = s.recv(65536)
+                if not chunk:
+                    break
+                data += chunk
+            s.close()
+            self.assertEqual(data.count(b"HTTP/1.1 404 Not Found\r\n"), PIPELINED)
+        self.assert_alive()
+
+
+if __name__ == "__main__":
+    unittest.main()